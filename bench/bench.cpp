@@ -0,0 +1,881 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "corpus.hpp"
+#include "event_bench.hpp"
+#include "graph_bench.hpp"
+#include "kernel_bench.hpp"
+#include "lexer_fuzz.hpp"
+#include "loop_bench.hpp"
+#include "matcher_bench.hpp"
+#include "parallel_bench.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/dfa_scanner.hpp"
+#include "lexer/lexer.hpp"
+#include "memory/arena.hpp"
+#include "parser/parser.hpp"
+
+using namespace Aesthetic;
+
+// Every allocation of the process goes through these, so a run's share is
+// the difference of the counters around it
+static std::atomic<size_t> s_Allocations{ 0UL };
+static std::atomic<size_t> s_AllocatedBytes{ 0UL };
+
+void* operator new(size_t size)
+{
+    s_Allocations.fetch_add(1UL, std::memory_order_relaxed);
+    s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1UL))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    s_Allocations.fetch_add(1UL, std::memory_order_relaxed);
+    s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1UL) / align * align))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+namespace
+{
+    struct BenchStage
+    {
+        std::string_view name;
+        // Lexes `program` and returns the number of tokens
+        size_t (*run)(std::string_view program);
+    };
+
+    struct BenchResult
+    {
+        CorpusProfile profile;
+        size_t size;
+        std::string_view stage;
+        size_t bytes;
+        size_t tokens;
+        size_t iterations;
+        // Fastest iteration
+        double seconds;
+        size_t allocations;
+        size_t allocatedBytes;
+        size_t peakRss;
+    };
+
+    struct BenchOptions
+    {
+        std::vector<size_t> sizes{ 1UL << 10U, 16UL << 10U, 256UL << 10U, 4UL << 20U, 64UL << 20U };
+        std::vector<CorpusProfile> profiles{ CorpusProfile::MIXED, CorpusProfile::LITERALS, CorpusProfile::NESTED, CorpusProfile::SCRIPTS };
+        std::vector<std::string_view> stages{ "lex", "lex-dfa", "parse", "program" };
+        std::vector<std::string_view> suites{ "lexer", "graph", "loop", "events", "fuzz", "matcher", "kernels", "parallel" };
+        std::vector<size_t> graphNodes{ 1UL << 20U };
+        std::vector<GraphShape> graphShapes{ GraphShape::LAYERED, GraphShape::CHAIN, GraphShape::FAN };
+        size_t loopIterations = 1000000000UL;
+        std::vector<std::string_view> loopCases{ "quiet", "print" };
+        size_t eventHandlers = 10000UL;
+        size_t eventTicks = 200UL;
+        // Powers of two up to the hardware threads unless given
+        std::vector<size_t> eventThreads;
+        size_t fuzzInputs = 20000UL;
+        size_t matcherSize = 256UL << 10U;
+        size_t kernelSize = 64UL << 10U;
+        size_t parallelSize = 64UL << 20U;
+        // Powers of two up to the hardware threads unless given
+        std::vector<size_t> parallelThreads;
+        double minTime = 0.5;
+        uint64_t seed = 0U;
+        bool json = false;
+        std::optional<size_t> generate;
+    };
+
+    // What the compiler driver does: lex in place into the unit's Arena
+    size_t RunLex(std::string_view program)
+    {
+        Arena arena;
+        const SourceBuffer source = SourceBuffer::Borrow(program, "<corpus>");
+        return Lexer(source, &arena).Lex().Size();
+    }
+
+    // The same with the generated DFA instead of the scanners
+    size_t RunLexDfa(std::string_view program)
+    {
+        Arena arena;
+        const SourceBuffer source = SourceBuffer::Borrow(program, "<corpus>");
+        return DfaLexer(source, &arena).Lex().Size();
+    }
+
+    // Lexing and parsing into the same Arena, as the driver does
+    size_t RunParse(std::string_view program)
+    {
+        Arena arena;
+        const SourceBuffer source = SourceBuffer::Borrow(program, "<corpus>");
+        const TokenStream tokens = Lexer(source, &arena).Lex();
+        Parser(tokens, &arena).Parse();
+        return tokens.Size();
+    }
+
+    // A corpus that stops at an invalid token or a syntax error would
+    // measure too little
+    bool ParsesCleanly(std::string_view program)
+    {
+        const SourceBuffer source = SourceBuffer::Borrow(program, "<corpus>");
+        const TokenStream tokens = Lexer(source).Lex();
+        Parser parser(tokens);
+        parser.Parse();
+        return parser.Errors().empty();
+    }
+
+    // The token object API, one shared BasicToken per token
+    size_t RunProgram(std::string_view program)
+    {
+        return Lexer(std::string(program)).LexProgram().size();
+    }
+
+    const std::array<BenchStage, 4UL> s_Stages = { {
+        { "lex", RunLex },
+        { "lex-dfa", RunLexDfa },
+        { "parse", RunParse },
+        { "program", RunProgram },
+    } };
+
+    const BenchStage* FindStage(std::string_view name)
+    {
+        for (const BenchStage& stage : s_Stages)
+            if (stage.name == name)
+                return &stage;
+        return nullptr;
+    }
+
+    // Linux can reset the high water mark, elsewhere the peak of the whole
+    // process is reported
+    void ResetPeakRss()
+    {
+        std::ofstream clear("/proc/self/clear_refs");
+        clear << "5";
+    }
+
+    size_t PeakRssKiB()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+            if (line.starts_with("VmHWM:"))
+                return std::strtoul(line.c_str() + 6, nullptr, 10);
+
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<size_t>(usage.ru_maxrss);
+    }
+
+    BenchResult Measure(const BenchStage& stage, std::string_view program, CorpusProfile profile, size_t size, double minTime)
+    {
+        BenchResult result{ profile, size, stage.name, program.size(), 0UL, 0UL, 1e300, 0UL, 0UL, 0UL };
+        double total = 0.0;
+
+        ResetPeakRss();
+        while (total < minTime || !result.iterations)
+        {
+            const size_t allocations = s_Allocations.load(std::memory_order_relaxed);
+            const size_t allocatedBytes = s_AllocatedBytes.load(std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+
+            result.tokens = stage.run(program);
+
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            result.allocations = s_Allocations.load(std::memory_order_relaxed) - allocations;
+            result.allocatedBytes = s_AllocatedBytes.load(std::memory_order_relaxed) - allocatedBytes;
+            result.seconds = std::min(result.seconds, seconds);
+            result.iterations++;
+            total += seconds;
+        }
+        result.peakRss = PeakRssKiB();
+
+        return result;
+    }
+
+    void PrintHeader()
+    {
+        std::printf("%-9s %10s %-8s %10s %12s %10s %12s %12s %12s\n",
+            "profile", "size", "stage", "tokens", "iterations", "MB/s", "Mtokens/s", "allocs/tok", "peak RSS KiB");
+    }
+
+    void Print(const BenchResult& result, bool json)
+    {
+        const double megabytes = static_cast<double>(result.bytes) / 1e6 / result.seconds;
+        const double tokens = static_cast<double>(result.tokens) / result.seconds;
+        const double allocations = static_cast<double>(result.allocations) / static_cast<double>(result.tokens);
+        const double allocatedBytes = static_cast<double>(result.allocatedBytes) / static_cast<double>(result.tokens);
+        const std::string_view profile = CorpusProfileName(result.profile);
+
+        if (json)
+        {
+            std::printf(
+                "{\"profile\":\"%.*s\",\"size\":%zu,\"stage\":\"%.*s\",\"bytes\":%zu,\"tokens\":%zu,"
+                "\"iterations\":%zu,\"seconds\":%.9f,\"mb_per_s\":%.3f,\"tokens_per_s\":%.1f,"
+                "\"allocs_per_token\":%.6f,\"alloc_bytes_per_token\":%.3f,\"peak_rss_kib\":%zu}\n",
+                static_cast<int>(profile.size()), profile.data(), result.size,
+                static_cast<int>(result.stage.size()), result.stage.data(), result.bytes, result.tokens,
+                result.iterations, result.seconds, megabytes, tokens,
+                allocations, allocatedBytes, result.peakRss
+            );
+        }
+        else
+        {
+            std::printf("%-9.*s %10zu %-8.*s %10zu %12zu %10.1f %12.2f %12.4f %12zu\n",
+                static_cast<int>(profile.size()), profile.data(), result.size,
+                static_cast<int>(result.stage.size()), result.stage.data(), result.tokens,
+                result.iterations, megabytes, tokens / 1e6, allocations, result.peakRss);
+        }
+        std::fflush(stdout);
+    }
+
+    void PrintGraphHeader()
+    {
+        std::printf("%-9s %10s %10s %-8s %12s %12s %12s %12s\n",
+            "shape", "nodes", "edges", "case", "recomputed", "iterations", "ms", "Mnodes/s");
+    }
+
+    void PrintGraph(const GraphBenchResult& result, bool json)
+    {
+        // Building is measured against every node, ticks against the ones they recompute
+        const size_t nodes = result.measured == "build" ? result.nodes : result.recomputed;
+        const double perSecond = static_cast<double>(nodes) / result.seconds;
+        const std::string_view shape = GraphShapeName(result.shape);
+
+        if (json)
+        {
+            std::printf(
+                "{\"suite\":\"graph\",\"shape\":\"%.*s\",\"nodes\":%zu,\"edges\":%zu,\"case\":\"%.*s\","
+                "\"recomputed\":%zu,\"iterations\":%zu,\"seconds\":%.9f,\"nodes_per_s\":%.1f}\n",
+                static_cast<int>(shape.size()), shape.data(), result.nodes, result.edges,
+                static_cast<int>(result.measured.size()), result.measured.data(),
+                result.recomputed, result.iterations, result.seconds, perSecond
+            );
+        }
+        else
+        {
+            std::printf("%-9.*s %10zu %10zu %-8.*s %12zu %12zu %12.3f %12.2f\n",
+                static_cast<int>(shape.size()), shape.data(), result.nodes, result.edges,
+                static_cast<int>(result.measured.size()), result.measured.data(),
+                result.recomputed, result.iterations, result.seconds * 1e3, perSecond / 1e6);
+        }
+        std::fflush(stdout);
+    }
+
+    void PrintLoopHeader()
+    {
+        std::printf("%-8s %12s %12s %12s %12s %12s\n", "case", "iterations", "ticks", "seconds", "Mticks/s", "ns/tick");
+    }
+
+    void PrintLoop(const LoopBenchResult& result, bool json)
+    {
+        const double ticks = static_cast<double>(result.ticks);
+
+        if (json)
+        {
+            std::printf(
+                "{\"suite\":\"loop\",\"case\":\"%.*s\",\"iterations\":%zu,\"ticks\":%zu,"
+                "\"seconds\":%.9f,\"ticks_per_s\":%.1f}\n",
+                static_cast<int>(result.measured.size()), result.measured.data(),
+                result.iterations, result.ticks, result.seconds, ticks / result.seconds
+            );
+        }
+        else
+        {
+            std::printf("%-8.*s %12zu %12zu %12.3f %12.2f %12.2f\n",
+                static_cast<int>(result.measured.size()), result.measured.data(),
+                result.iterations, result.ticks, result.seconds, ticks / result.seconds / 1e6, result.seconds / ticks * 1e9);
+        }
+        std::fflush(stdout);
+    }
+
+    void PrintEventHeader()
+    {
+        std::printf("%-8s %10s %10s %12s %14s %10s\n", "threads", "handlers", "ticks", "seconds", "Mhandlers/s", "speedup");
+    }
+
+    void PrintEvent(const EventBenchResult& result, double baseline, bool json)
+    {
+        const double runs = static_cast<double>(result.handlers) * static_cast<double>(result.ticks);
+
+        if (json)
+        {
+            std::printf(
+                "{\"suite\":\"events\",\"threads\":%zu,\"handlers\":%zu,\"ticks\":%zu,"
+                "\"seconds\":%.9f,\"handlers_per_s\":%.1f,\"speedup\":%.3f}\n",
+                result.threads, result.handlers, result.ticks, result.seconds, runs / result.seconds, baseline / result.seconds
+            );
+        }
+        else
+        {
+            std::printf("%-8zu %10zu %10zu %12.3f %14.2f %10.2f\n",
+                result.threads, result.handlers, result.ticks, result.seconds, runs / result.seconds / 1e6, baseline / result.seconds);
+        }
+        std::fflush(stdout);
+    }
+
+    void PrintFuzzHeader()
+    {
+        std::printf("%-8s %10s %12s %12s %12s %10s\n", "fuzz", "inputs", "bytes", "lexemes", "seconds", "states");
+    }
+
+    void PrintFuzz(const LexerFuzzResult& result, bool json)
+    {
+        if (json)
+        {
+            std::printf(
+                "{\"suite\":\"fuzz\",\"inputs\":%zu,\"bytes\":%zu,\"lexemes\":%zu,\"seconds\":%.9f,\"dfa_states\":%zu}\n",
+                result.inputs, result.bytes, result.lexemes, result.seconds, DfaStates()
+            );
+        }
+        else
+        {
+            std::printf("%-8s %10zu %12zu %12zu %12.3f %10zu\n",
+                "lexer", result.inputs, result.bytes, result.lexemes, result.seconds, DfaStates());
+        }
+        std::fflush(stdout);
+    }
+
+    void PrintMatcherHeader()
+    {
+        std::printf("%-12s %-8s %10s %10s %12s %12s %10s\n", "table", "matcher", "lookups", "matches", "iterations", "ms", "ns/lookup");
+    }
+
+    void PrintMatcher(const MatcherBenchResult& result, bool json)
+    {
+        const double lookups = static_cast<double>(result.lookups);
+
+        if (json)
+        {
+            std::printf(
+                "{\"suite\":\"matcher\",\"table\":\"%.*s\",\"matcher\":\"%.*s\",\"lookups\":%zu,\"matches\":%zu,"
+                "\"iterations\":%zu,\"seconds\":%.9f,\"ns_per_lookup\":%.3f}\n",
+                static_cast<int>(result.table.size()), result.table.data(),
+                static_cast<int>(result.matcher.size()), result.matcher.data(),
+                result.lookups, result.matches, result.iterations, result.seconds, result.seconds / lookups * 1e9
+            );
+        }
+        else
+        {
+            std::printf("%-12.*s %-8.*s %10zu %10zu %12zu %12.3f %10.2f\n",
+                static_cast<int>(result.table.size()), result.table.data(),
+                static_cast<int>(result.matcher.size()), result.matcher.data(),
+                result.lookups, result.matches, result.iterations, result.seconds * 1e3, result.seconds / lookups * 1e9);
+        }
+        std::fflush(stdout);
+    }
+
+    void PrintParallelHeader()
+    {
+        std::printf("%-8s %12s %10s %12s %10s %10s %10s\n", "threads", "bytes", "tokens", "iterations", "ms", "MB/s", "speedup");
+    }
+
+    void PrintParallel(const ParallelBenchResult& result, double baseline, bool json)
+    {
+        const double megabytes = static_cast<double>(result.bytes) / 1e6 / result.seconds;
+
+        if (json)
+        {
+            std::printf(
+                "{\"suite\":\"parallel\",\"threads\":%zu,\"bytes\":%zu,\"tokens\":%zu,"
+                "\"iterations\":%zu,\"seconds\":%.9f,\"mb_per_s\":%.3f,\"speedup\":%.3f}\n",
+                result.threads, result.bytes, result.tokens, result.iterations, result.seconds, megabytes, baseline / result.seconds
+            );
+        }
+        else
+        {
+            // The serial lexer is listed as 0 threads
+            std::printf("%-8zu %12zu %10zu %12zu %10.3f %10.1f %10.2f\n",
+                result.threads, result.bytes, result.tokens, result.iterations, result.seconds * 1e3, megabytes, baseline / result.seconds);
+        }
+        std::fflush(stdout);
+    }
+
+    void PrintKernelHeader()
+    {
+        std::printf("%-8s %-12s %10s %12s %12s %10s\n", "set", "kernel", "bytes", "iterations", "us", "GB/s");
+    }
+
+    void PrintKernel(const KernelBenchResult& result, bool json)
+    {
+        const std::string_view set = KernelSetName(result.set);
+        const double gigabytes = static_cast<double>(result.bytes) / 1e9 / result.seconds;
+
+        if (json)
+        {
+            std::printf(
+                "{\"suite\":\"kernels\",\"set\":\"%.*s\",\"kernel\":\"%.*s\",\"bytes\":%zu,"
+                "\"iterations\":%zu,\"seconds\":%.9f,\"gb_per_s\":%.3f}\n",
+                static_cast<int>(set.size()), set.data(),
+                static_cast<int>(result.kernel.size()), result.kernel.data(),
+                result.bytes, result.iterations, result.seconds, gigabytes
+            );
+        }
+        else
+        {
+            std::printf("%-8.*s %-12.*s %10zu %12zu %12.3f %10.2f\n",
+                static_cast<int>(set.size()), set.data(),
+                static_cast<int>(result.kernel.size()), result.kernel.data(),
+                result.bytes, result.iterations, result.seconds * 1e6, gigabytes);
+        }
+        std::fflush(stdout);
+    }
+
+    // "4096", "64K", "16M" or "1G"
+    std::optional<size_t> ParseSize(std::string_view text)
+    {
+        size_t scale = 1UL;
+        if (!text.empty())
+        {
+            switch (text.back())
+            {
+            case 'K': case 'k': scale = 1UL << 10U; break;
+            case 'M': case 'm': scale = 1UL << 20U; break;
+            case 'G': case 'g': scale = 1UL << 30U; break;
+            }
+        }
+        if (scale != 1UL)
+            text.remove_suffix(1);
+
+        size_t value = 0UL;
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (text.empty() || error != std::errc() || end != text.data() + text.size())
+            return std::nullopt;
+        return value * scale;
+    }
+
+    std::vector<std::string_view> SplitList(std::string_view text)
+    {
+        std::vector<std::string_view> items;
+        while (!text.empty())
+        {
+            const size_t comma = text.find(',');
+            items.push_back(text.substr(0, comma));
+            text.remove_prefix(comma == std::string_view::npos ? text.size() : comma + 1);
+        }
+        return items;
+    }
+
+    void Usage(const char* name)
+    {
+        std::cerr
+            << "usage: " << name << " [options]\n"
+            << "  --sizes LIST      corpus sizes, e.g. 1K,64M,1G (default 1K,16K,256K,4M,64M)\n"
+            << "  --profiles LIST   mixed, literals, nested, scripts (default all)\n"
+            << "  --stages LIST     lex, lex-dfa, parse, program (default all)\n"
+            << "  --suites LIST     lexer, graph, loop, events, fuzz, matcher, kernels,\n"
+            << "                    parallel (default all)\n"
+            << "  --graph-nodes LIST  dependency graph sizes (default 1M)\n"
+            << "  --graph-shapes LIST layered, chain, fan (default all)\n"
+            << "  --loop-iterations N values the README loop counts to (default 1000000000)\n"
+            << "  --loop-cases LIST   quiet, print (default all)\n"
+            << "  --event-handlers N  handlers of the event benchmark (default 10000)\n"
+            << "  --event-ticks N     events fired at them (default 200)\n"
+            << "  --event-threads LIST thread counts (default powers of two up to the cores)\n"
+            << "  --fuzz-inputs N     random programs both lexer engines check (default 20000)\n"
+            << "  --matcher-size SIZE corpus the hard token matchers run over (default 256K)\n"
+            << "  --kernel-size SIZE  bytes every scan kernel runs over (default 64K)\n"
+            << "  --parallel-size SIZE corpus lexed on every thread count (default 64M)\n"
+            << "  --parallel-threads LIST thread counts (default powers of two up to the cores)\n"
+            << "  --min-time SEC    time to repeat each case for (default 0.5)\n"
+            << "  --seed N          corpus seed (default 0)\n"
+            << "  --json            one JSON object per case instead of a table\n"
+            << "  --generate SIZE   write a corpus of the first profile to stdout and exit\n";
+    }
+
+    std::optional<BenchOptions> ParseOptions(int argc, char** argv)
+    {
+        BenchOptions options;
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view option = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (option == "--json")
+            {
+                options.json = true;
+            }
+            else if (option == "--sizes" && hasValue)
+            {
+                options.sizes.clear();
+                for (std::string_view item : SplitList(argv[++i]))
+                {
+                    const std::optional<size_t> size = ParseSize(item);
+                    if (!size)
+                        return std::nullopt;
+                    options.sizes.push_back(size.value());
+                }
+            }
+            else if (option == "--profiles" && hasValue)
+            {
+                options.profiles.clear();
+                for (std::string_view item : SplitList(argv[++i]))
+                {
+                    const std::optional<CorpusProfile> profile = ParseCorpusProfile(item);
+                    if (!profile)
+                        return std::nullopt;
+                    options.profiles.push_back(profile.value());
+                }
+            }
+            else if (option == "--stages" && hasValue)
+            {
+                options.stages = SplitList(argv[++i]);
+                for (std::string_view stage : options.stages)
+                    if (!FindStage(stage))
+                        return std::nullopt;
+            }
+            else if (option == "--suites" && hasValue)
+            {
+                options.suites = SplitList(argv[++i]);
+                for (std::string_view suite : options.suites)
+                    if (suite != "lexer" && suite != "graph" && suite != "loop" && suite != "events" && suite != "fuzz"
+                        && suite != "matcher" && suite != "kernels" && suite != "parallel")
+                        return std::nullopt;
+            }
+            else if (option == "--graph-nodes" && hasValue)
+            {
+                options.graphNodes.clear();
+                for (std::string_view item : SplitList(argv[++i]))
+                {
+                    const std::optional<size_t> nodes = ParseSize(item);
+                    if (!nodes || !nodes.value())
+                        return std::nullopt;
+                    options.graphNodes.push_back(nodes.value());
+                }
+            }
+            else if (option == "--graph-shapes" && hasValue)
+            {
+                options.graphShapes.clear();
+                for (std::string_view item : SplitList(argv[++i]))
+                {
+                    const std::optional<GraphShape> shape = ParseGraphShape(item);
+                    if (!shape)
+                        return std::nullopt;
+                    options.graphShapes.push_back(shape.value());
+                }
+            }
+            else if (option == "--loop-iterations" && hasValue)
+            {
+                const std::optional<size_t> iterations = ParseSize(argv[++i]);
+                if (!iterations || !iterations.value())
+                    return std::nullopt;
+                options.loopIterations = iterations.value();
+            }
+            else if (option == "--loop-cases" && hasValue)
+            {
+                options.loopCases = SplitList(argv[++i]);
+                for (std::string_view item : options.loopCases)
+                    if (item != "quiet" && item != "print")
+                        return std::nullopt;
+            }
+            else if ((option == "--event-handlers" || option == "--event-ticks") && hasValue)
+            {
+                const std::optional<size_t> count = ParseSize(argv[++i]);
+                if (!count || !count.value())
+                    return std::nullopt;
+                (option == "--event-handlers" ? options.eventHandlers : options.eventTicks) = count.value();
+            }
+            else if (option == "--event-threads" && hasValue)
+            {
+                options.eventThreads.clear();
+                for (std::string_view item : SplitList(argv[++i]))
+                {
+                    const std::optional<size_t> threads = ParseSize(item);
+                    if (!threads || !threads.value())
+                        return std::nullopt;
+                    options.eventThreads.push_back(threads.value());
+                }
+                if (options.eventThreads.empty())
+                    return std::nullopt;
+            }
+            else if (option == "--fuzz-inputs" && hasValue)
+            {
+                const std::optional<size_t> inputs = ParseSize(argv[++i]);
+                if (!inputs || !inputs.value())
+                    return std::nullopt;
+                options.fuzzInputs = inputs.value();
+            }
+            else if (option == "--matcher-size" && hasValue)
+            {
+                const std::optional<size_t> size = ParseSize(argv[++i]);
+                if (!size || !size.value())
+                    return std::nullopt;
+                options.matcherSize = size.value();
+            }
+            else if (option == "--kernel-size" && hasValue)
+            {
+                const std::optional<size_t> size = ParseSize(argv[++i]);
+                if (!size || !size.value())
+                    return std::nullopt;
+                options.kernelSize = size.value();
+            }
+            else if (option == "--parallel-size" && hasValue)
+            {
+                const std::optional<size_t> size = ParseSize(argv[++i]);
+                if (!size || !size.value())
+                    return std::nullopt;
+                options.parallelSize = size.value();
+            }
+            else if (option == "--parallel-threads" && hasValue)
+            {
+                options.parallelThreads.clear();
+                for (std::string_view item : SplitList(argv[++i]))
+                {
+                    const std::optional<size_t> threads = ParseSize(item);
+                    if (!threads || !threads.value())
+                        return std::nullopt;
+                    options.parallelThreads.push_back(threads.value());
+                }
+                if (options.parallelThreads.empty())
+                    return std::nullopt;
+            }
+            else if (option == "--min-time" && hasValue)
+            {
+                options.minTime = std::strtod(argv[++i], nullptr);
+            }
+            else if (option == "--seed" && hasValue)
+            {
+                options.seed = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (option == "--generate" && hasValue)
+            {
+                options.generate = ParseSize(argv[++i]);
+                if (!options.generate)
+                    return std::nullopt;
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        if (options.sizes.empty() || options.profiles.empty() || options.stages.empty() || options.suites.empty())
+            return std::nullopt;
+        if (options.graphNodes.empty() || options.graphShapes.empty() || options.loopCases.empty())
+            return std::nullopt;
+
+        const size_t cores = std::max(1U, std::thread::hardware_concurrency());
+        for (std::vector<size_t>* threadCounts : { &options.eventThreads, &options.parallelThreads })
+        {
+            if (!threadCounts->empty())
+                continue;
+            for (size_t threads = 1UL; threads < cores; threads *= 2UL)
+                threadCounts->push_back(threads);
+            threadCounts->push_back(cores);
+        }
+        return options;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::optional<BenchOptions> options = ParseOptions(argc, argv);
+    if (!options)
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    if (options->generate)
+    {
+        const std::string corpus = GenerateCorpus(options->generate.value(), options->profiles.front(), options->seed);
+        std::fwrite(corpus.data(), 1UL, corpus.size(), stdout);
+        return 0;
+    }
+
+    const auto hasSuite = [&options](std::string_view suite)
+    {
+        return std::find(options->suites.begin(), options->suites.end(), suite) != options->suites.end();
+    };
+
+    if (!options->json && hasSuite("lexer"))
+        PrintHeader();
+
+    for (CorpusProfile profile : hasSuite("lexer") ? options->profiles : std::vector<CorpusProfile>())
+    {
+        for (size_t size : options->sizes)
+        {
+            const std::string corpus = GenerateCorpus(size, profile, options->seed);
+            if (!ParsesCleanly(corpus))
+            {
+                std::cerr << CorpusProfileName(profile) << ' ' << size << ": corpus does not parse cleanly\n";
+                return 1;
+            }
+
+            for (std::string_view name : options->stages)
+                Print(Measure(*FindStage(name), corpus, profile, size, options->minTime), options->json);
+        }
+    }
+
+    if (!options->json && hasSuite("graph"))
+    {
+        if (hasSuite("lexer"))
+            std::printf("\n");
+        PrintGraphHeader();
+    }
+
+    for (GraphShape shape : hasSuite("graph") ? options->graphShapes : std::vector<GraphShape>())
+    {
+        for (size_t nodes : options->graphNodes)
+        {
+            const auto results = RunGraphBench(shape, nodes, options->minTime, options->seed);
+            if (!results)
+            {
+                std::cerr << GraphShapeName(shape) << ' ' << nodes << ": a tick did not recompute every node once\n";
+                return 1;
+            }
+
+            for (const GraphBenchResult& result : results.value())
+                PrintGraph(result, options->json);
+        }
+    }
+
+    if (!options->json && hasSuite("loop"))
+    {
+        if (hasSuite("lexer") || hasSuite("graph"))
+            std::printf("\n");
+        PrintLoopHeader();
+    }
+
+    for (std::string_view name : hasSuite("loop") ? options->loopCases : std::vector<std::string_view>())
+    {
+        const auto result = RunLoopBench(options->loopIterations, name == "print");
+        if (!result)
+        {
+            std::cerr << "loop " << name << ": the program did not stop after " << options->loopIterations << " iterations\n";
+            return 1;
+        }
+        PrintLoop(result.value(), options->json);
+    }
+
+    if (!options->json && hasSuite("events"))
+    {
+        if (hasSuite("lexer") || hasSuite("graph") || hasSuite("loop"))
+            std::printf("\n");
+        PrintEventHeader();
+    }
+
+    // Speedups are against the first thread count, which also has to agree
+    // with every other one on the result
+    std::optional<EventBenchResult> baseline;
+    for (size_t threads : hasSuite("events") ? options->eventThreads : std::vector<size_t>())
+    {
+        const auto result = RunEventBench(options->eventHandlers, options->eventTicks, threads);
+        if (!result || (baseline && baseline->checksum != result->checksum))
+        {
+            std::cerr << "events on " << threads << " threads: the handlers " << (result ? "computed a different result\n" : "failed\n");
+            return 1;
+        }
+        if (!baseline)
+            baseline = result;
+        PrintEvent(result.value(), baseline->seconds, options->json);
+    }
+
+    if (hasSuite("fuzz"))
+    {
+        if (!options->json)
+        {
+            if (hasSuite("lexer") || hasSuite("graph") || hasSuite("loop") || hasSuite("events"))
+                std::printf("\n");
+            PrintFuzzHeader();
+        }
+
+        // Both lexer engines on the same mutated snippets, they have to agree on every token
+        const LexerFuzzResult result = RunLexerFuzz(options->fuzzInputs, options->seed);
+        if (result.mismatch)
+        {
+            std::cerr << "fuzz " << result.mismatch.value() << '\n';
+            return 1;
+        }
+        PrintFuzz(result, options->json);
+    }
+
+    if (hasSuite("matcher"))
+    {
+        if (!options->json)
+        {
+            if (hasSuite("lexer") || hasSuite("graph") || hasSuite("loop") || hasSuite("events") || hasSuite("fuzz"))
+                std::printf("\n");
+            PrintMatcherHeader();
+        }
+
+        // The compile-time trie against the sorted search it replaced
+        const auto results = RunMatcherBench(options->matcherSize, options->minTime, options->seed);
+        if (!results)
+        {
+            std::cerr << "matcher: the trie and the sorted search found different tokens\n";
+            return 1;
+        }
+        for (const MatcherBenchResult& result : results.value())
+            PrintMatcher(result, options->json);
+    }
+
+    if (hasSuite("kernels"))
+    {
+        if (!options->json)
+        {
+            if (hasSuite("lexer") || hasSuite("graph") || hasSuite("loop") || hasSuite("events") || hasSuite("fuzz")
+                || hasSuite("matcher"))
+                std::printf("\n");
+            PrintKernelHeader();
+        }
+
+        for (const KernelBenchResult& result : RunKernelBench(options->kernelSize, options->minTime))
+            PrintKernel(result, options->json);
+    }
+
+    if (hasSuite("parallel"))
+    {
+        if (!options->json)
+        {
+            if (hasSuite("lexer") || hasSuite("graph") || hasSuite("loop") || hasSuite("events") || hasSuite("fuzz")
+                || hasSuite("matcher") || hasSuite("kernels"))
+                std::printf("\n");
+            PrintParallelHeader();
+        }
+
+        // Speedups are against the serial Lexer, every thread count has to
+        // produce its tokens
+        std::vector<size_t> threadCounts{ 0UL };
+        threadCounts.insert(threadCounts.end(), options->parallelThreads.begin(), options->parallelThreads.end());
+        double baseline = 0.0;
+        for (size_t threads : threadCounts)
+        {
+            const auto result = RunParallelBench(options->parallelSize, threads, options->minTime, options->seed);
+            if (!result)
+            {
+                std::cerr << "parallel on " << threads << " threads: the tokens differ from the serial lexer's\n";
+                return 1;
+            }
+            if (!threads)
+                baseline = result->seconds;
+            PrintParallel(result.value(), baseline, options->json);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,320 @@
+#include <array>
+#include <charconv>
+
+#include "corpus.hpp"
+
+namespace Aesthetic
+{
+    // splitmix64, unlike the std distributions it gives the same sequence
+    // with every standard library
+    class CorpusRandom
+    {
+    private:
+        uint64_t m_State;
+    public:
+        CorpusRandom(uint64_t seed) : m_State(seed) {}
+
+        uint64_t Next()
+        {
+            uint64_t z = (m_State += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31U);
+        }
+
+        // Uniform enough in [0, bound) for bounds this small
+        size_t Below(size_t bound) { return Next() % bound; }
+        bool Chance(size_t percent) { return Below(100UL) < percent; }
+
+        template<typename T, size_t N>
+        const T& Pick(const std::array<T, N>& items) { return items[Below(N)]; }
+    };
+
+    class CorpusWriter
+    {
+    private:
+        static constexpr std::array<std::string_view, 16UL> s_Names = {
+            "x", "y", "count", "total", "ready", "value", "index", "state",
+            "left", "right", "buffer", "limit", "step", "result", "item", "flag"
+        };
+        // Latin with diacritics, Greek, Cyrillic, CJK and Hangul, 2 to 3
+        // bytes per letter, some mixed with ASCII
+        static constexpr std::array<std::string_view, 16UL> s_ScriptNames = {
+            "größe", "café", "ñandú", "résultat", "τιμή", "λόγος", "значение", "счётчик",
+            "数量", "合計", "状態", "변수", "결과", "x_ñ", "δx", "état_2"
+        };
+        static constexpr std::array<std::string_view, 8UL> s_ScriptWords = {
+            "grüße", "déjà vu", "καλημέρα", "привет мир", "你好，世界", "안녕하세요", "naïve café", "x"
+        };
+        static constexpr std::array<std::string_view, 5UL> s_Arithmetic = {
+            "+", "-", "*", "/", "//"
+        };
+        static constexpr std::array<std::string_view, 6UL> s_Comparisons = {
+            "<", "<=", ">", ">=", "==", "!="
+        };
+        static constexpr std::array<std::string_view, 3UL> s_Bindings = {
+            "::=", ":=", "="
+        };
+        static constexpr std::array<std::string_view, 3UL> s_Handlers = {
+            "when", "whenever", "on"
+        };
+        static constexpr std::array<std::string_view, 8UL> s_Words = {
+            "hello", "world", "reactive", "value changed", "done",
+            "an aesthetic string", "x", "multi word text"
+        };
+
+        std::string& m_Out;
+        CorpusRandom m_Random;
+        CorpusProfile m_Profile;
+        // Depth the current top-level handler of a NESTED corpus reaches
+        size_t m_Nesting;
+    public:
+        CorpusWriter(std::string& out, CorpusProfile profile, uint64_t seed)
+            : m_Out(out), m_Random(seed), m_Profile(profile), m_Nesting(0UL) {}
+
+        void Statement(size_t depth)
+        {
+            switch (m_Profile)
+            {
+            case CorpusProfile::LITERALS:
+                if (depth || m_Random.Chance(85UL))
+                    return LiteralBinding(depth);
+                return Handler(depth);
+            case CorpusProfile::NESTED:
+                m_Nesting = 16UL + m_Random.Below(48UL);
+                return Handler(depth);
+            case CorpusProfile::MIXED:
+            case CorpusProfile::SCRIPTS:
+                break;
+            }
+
+            const size_t roll = m_Random.Below(100UL);
+            if (roll < 30UL && depth < 6UL)
+                return Handler(depth);
+            if (roll < 40UL)
+                return Deletion(depth);
+            if (roll < 47UL)
+                return Call(depth);
+            if (roll < 50UL)
+                return Comment(depth);
+            Binding(depth);
+        }
+    private:
+        void Indent(size_t depth)
+        {
+            m_Out.append(depth * 4UL, ' ');
+        }
+
+        void Name()
+        {
+            m_Out += m_Profile == CorpusProfile::SCRIPTS ? m_Random.Pick(s_ScriptNames) : m_Random.Pick(s_Names);
+            if (m_Random.Chance(30UL))
+                Number(m_Random.Below(1000UL));
+        }
+
+        void Number(uint64_t value)
+        {
+            char digits[24];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            m_Out.append(digits, result.ptr);
+        }
+
+        void Number(uint64_t value, int base)
+        {
+            char digits[72];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), value, base);
+            m_Out.append(digits, result.ptr);
+        }
+
+        void Literal()
+        {
+            const uint64_t value = m_Random.Next() >> m_Random.Below(64UL);
+            switch (m_Random.Below(8UL))
+            {
+            case 0:
+                m_Out += "0x";
+                return Number(value, 16);
+            case 1:
+                m_Out += "0o";
+                return Number(value, 8);
+            case 2:
+                m_Out += "0b";
+                return Number(value & 0xFFFFU, 2);
+            case 3:
+            case 4:
+                Number(value % 100000U);
+                m_Out += '.';
+                return Number(m_Random.Below(1000UL));
+            case 5:
+                return String();
+            default:
+                return Number(value % 1000U);
+            }
+        }
+
+        void String()
+        {
+            const char quote = m_Random.Chance(50UL) ? '\'' : '"';
+            m_Out += quote;
+            m_Out += m_Profile == CorpusProfile::SCRIPTS ? m_Random.Pick(s_ScriptWords) : m_Random.Pick(s_Words);
+            m_Out += quote;
+        }
+
+        void Operand(size_t budget)
+        {
+            const size_t roll = m_Random.Below(10UL);
+            if (roll < 4UL)
+                return Name();
+            if (roll < 7UL || !budget)
+                return m_Random.Chance(80UL) ? Literal() : String();
+
+            m_Out += '(';
+            Expression(budget - 1UL);
+            m_Out += ')';
+        }
+
+        void Expression(size_t budget)
+        {
+            Operand(budget);
+            for (size_t terms = m_Random.Below(4UL); terms; terms--)
+            {
+                m_Out += ' ';
+                m_Out += m_Random.Pick(s_Arithmetic);
+                m_Out += ' ';
+                Operand(budget);
+            }
+        }
+
+        void Binding(size_t depth)
+        {
+            Indent(depth);
+            Name();
+            m_Out += ' ';
+            m_Out += m_Random.Pick(s_Bindings);
+            m_Out += ' ';
+            Expression(3UL);
+            m_Out += '\n';
+        }
+
+        void LiteralBinding(size_t depth)
+        {
+            Indent(depth);
+            Name();
+            m_Out += " ::= [";
+            for (size_t items = 4UL + m_Random.Below(12UL); items; items--)
+            {
+                Literal();
+                if (items > 1UL)
+                    m_Out += ", ";
+            }
+            m_Out += "]\n";
+        }
+
+        void Call(size_t depth)
+        {
+            Indent(depth);
+            m_Out += "print ";
+            Operand(1UL);
+            m_Out += '\n';
+        }
+
+        void Comment(size_t depth)
+        {
+            Indent(depth);
+            m_Out += "/// ";
+            m_Out += m_Random.Pick(s_Words);
+            m_Out += '\n';
+        }
+
+        void Deletion(size_t depth)
+        {
+            Indent(depth);
+            m_Out += m_Random.Chance(50UL) ? "~!" : "!!";
+            Name();
+            m_Out += '\n';
+        }
+
+        void Handler(size_t depth)
+        {
+            Indent(depth);
+            const std::string_view keyword = m_Random.Pick(s_Handlers);
+            m_Out += keyword;
+            m_Out += ' ';
+
+            if (keyword == "when" && !depth && m_Random.Chance(20UL))
+            {
+                m_Out += "#start";
+            }
+            else
+            {
+                Name();
+                if (keyword != "on")
+                {
+                    m_Out += ' ';
+                    m_Out += m_Random.Chance(30UL) ? "~>" : m_Random.Pick(s_Comparisons);
+                    m_Out += ' ';
+                    Expression(1UL);
+                }
+            }
+
+            m_Out += " {\n";
+            if (m_Profile == CorpusProfile::NESTED)
+            {
+                // A single chain of handlers, branching would grow exponentially
+                Binding(depth + 1UL);
+                if (depth + 1UL < m_Nesting)
+                    Handler(depth + 1UL);
+                Binding(depth + 1UL);
+            }
+            else
+            {
+                for (size_t statements = 1UL + m_Random.Below(4UL); statements; statements--)
+                    Statement(depth + 1UL);
+            }
+            if (m_Random.Chance(20UL))
+            {
+                Indent(depth + 1UL);
+                m_Out += "if ";
+                Name();
+                m_Out += " { ~!";
+                Name();
+                m_Out += " }\n";
+            }
+            Indent(depth);
+            m_Out += "}\n";
+        }
+    };
+
+    std::optional<CorpusProfile> ParseCorpusProfile(std::string_view name)
+    {
+        for (CorpusProfile profile : { CorpusProfile::MIXED, CorpusProfile::LITERALS, CorpusProfile::NESTED, CorpusProfile::SCRIPTS })
+            if (CorpusProfileName(profile) == name)
+                return profile;
+        return std::nullopt;
+    }
+
+    std::string_view CorpusProfileName(CorpusProfile profile)
+    {
+        switch (profile)
+        {
+        case CorpusProfile::MIXED: return "mixed";
+        case CorpusProfile::LITERALS: return "literals";
+        case CorpusProfile::NESTED: return "nested";
+        case CorpusProfile::SCRIPTS: return "scripts";
+        }
+        return "unknown";
+    }
+
+    std::string GenerateCorpus(size_t size, CorpusProfile profile, uint64_t seed)
+    {
+        std::string out;
+        // A top-level statement stays well under a few KiB even when nested
+        out.reserve(size + 64UL * 1024UL);
+
+        CorpusWriter writer(out, profile, seed ^ (static_cast<uint64_t>(profile) << 56U));
+        while (out.size() < size)
+            writer.Statement(0UL);
+
+        return out;
+    }
+} // namespace Aesthetic
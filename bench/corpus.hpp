@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Aesthetic
+{
+    enum class CorpusProfile : uint8_t
+    {
+        // Handlers, bindings and expressions in proportions of real programs
+        MIXED    = 0U,
+        // Bindings of long literal lists, mostly numbers of every base
+        LITERALS = 1U,
+        // Handlers nested dozens of levels deep
+        NESTED   = 2U,
+        // MIXED with names and strings in non-Latin and accented scripts
+        SCRIPTS  = 3U,
+    };
+
+    std::optional<CorpusProfile> ParseCorpusProfile(std::string_view name);
+    std::string_view CorpusProfileName(CorpusProfile profile);
+
+    // Synthetic Aesthetic program of at least `size` bytes that lexes
+    // without errors. The output only depends on the arguments, so a corpus
+    // can be regenerated instead of stored.
+    std::string GenerateCorpus(size_t size, CorpusProfile profile, uint64_t seed = 0U);
+} // namespace Aesthetic
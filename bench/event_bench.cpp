@@ -0,0 +1,85 @@
+#include <chrono>
+#include <ostream>
+#include <sstream>
+
+#include "event_bench.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/lexer.hpp"
+#include "memory/arena.hpp"
+#include "parser/parser.hpp"
+#include "runtime/resolver.hpp"
+#include "runtime/runtime.hpp"
+#include "util/interner.hpp"
+
+namespace Aesthetic
+{
+    std::string EventProgram(size_t handlers)
+    {
+        std::ostringstream program;
+        for (size_t i = 0UL; i < handlers; i++)
+            program << 'a' << i << " = " << i << "\nb" << i << " = 1\n";
+
+        // A few dozen instructions per handler, with a branch
+        for (size_t i = 0UL; i < handlers; i++)
+        {
+            program
+                << "when #pulse {\n"
+                << "    a" << i << " = (a" << i << " * 7 + b" << i << ") // 3\n"
+                << "    b" << i << " = b" << i << " + a" << i << " - " << i << '\n'
+                << "    if a" << i << " > 1000000 { a" << i << " = a" << i << " // 1000 }\n"
+                << "    if b" << i << " > 1000000 { b" << i << " = b" << i << " // 1000 }\n"
+                << "}\n";
+        }
+        return program.str();
+    }
+
+    std::optional<EventBenchResult> RunEventBench(size_t handlers, size_t ticks, size_t threads)
+    {
+        const std::string program = EventProgram(handlers);
+        const SourceBuffer source = SourceBuffer::Borrow(program, "<events>");
+
+        Arena arena;
+        const TokenStream tokens = Lexer(source, &arena).Lex();
+        Parser parser(tokens, &arena);
+        const Ast ast = parser.Parse();
+        if (!parser.Errors().empty())
+            return std::nullopt;
+
+        Resolver resolver;
+        const Resolution resolution = resolver.Resolve(ast);
+        if (!resolver.Errors().empty())
+            return std::nullopt;
+
+        const SymbolId pulse = Interner::Global().Intern("pulse");
+        std::ostringstream sink;
+        Runtime runtime(ast, resolution, sink, &arena, threads);
+
+        // The top level writes and `#start` settle before the clock starts
+        runtime.Start();
+        while (runtime.Tick())
+            ;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t tick = 0UL; tick < ticks; tick++)
+        {
+            runtime.Emit(pulse);
+            runtime.Tick();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (!runtime.Errors().empty())
+            return std::nullopt;
+
+        uint64_t checksum = 0U;
+        for (size_t i = 0UL; i < handlers; i++)
+        {
+            for (const char binding : { 'a', 'b' })
+            {
+                const Value value = runtime.Get(Interner::Global().Intern(binding + std::to_string(i)));
+                checksum += static_cast<uint64_t>(value.integer);
+            }
+        }
+
+        return EventBenchResult{ runtime.Threads(), handlers, ticks, seconds, checksum };
+    }
+} // namespace Aesthetic
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Aesthetic
+{
+    struct EventBenchResult
+    {
+        size_t threads;
+        size_t handlers;
+        // Events fired, each one runs every handler
+        size_t ticks;
+        double seconds;
+        // Sum of the bindings the handlers write, the same on any number of threads
+        uint64_t checksum;
+    };
+
+    // `handlers` independent handlers of a `#pulse` event, each updating
+    // bindings of its own
+    std::string EventProgram(size_t handlers);
+
+    // Fires `#pulse` from the host `ticks` times and runs every handler for
+    // it on `threads` threads. Nothing if the program failed.
+    std::optional<EventBenchResult> RunEventBench(size_t handlers, size_t ticks, size_t threads);
+} // namespace Aesthetic
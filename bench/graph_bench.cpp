@@ -0,0 +1,176 @@
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include "graph_bench.hpp"
+#include "runtime/dependency_graph.hpp"
+
+namespace Aesthetic
+{
+    namespace
+    {
+        // splitmix64, the same graph with every standard library
+        class GraphRandom
+        {
+        private:
+            uint64_t m_State;
+        public:
+            GraphRandom(uint64_t seed) : m_State(seed) {}
+
+            uint64_t Next()
+            {
+                uint64_t z = (m_State += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31U);
+            }
+
+            size_t Below(size_t bound) { return Next() % bound; }
+        };
+
+        struct GraphSpec
+        {
+            std::vector<std::pair<GraphNode, GraphNode>> edges;
+            // Nodes nothing else is read by
+            std::vector<GraphNode> sources;
+        };
+
+        GraphSpec GenerateGraph(GraphShape shape, size_t nodes, uint64_t seed)
+        {
+            GraphRandom random(seed);
+            GraphSpec spec;
+
+            switch (shape)
+            {
+            case GraphShape::LAYERED:
+            {
+                const size_t width = std::max<size_t>(1UL, static_cast<size_t>(std::sqrt(static_cast<double>(nodes))));
+                for (size_t node = 0UL; node < nodes; node++)
+                {
+                    if (node < width)
+                    {
+                        spec.sources.push_back(static_cast<GraphNode>(node));
+                        continue;
+                    }
+
+                    const size_t above = node - node % width - width;
+                    const size_t inputs = 1UL + random.Below(3UL);
+                    for (size_t i = 0UL; i < inputs; i++)
+                        spec.edges.emplace_back(static_cast<GraphNode>(above + random.Below(width)), static_cast<GraphNode>(node));
+                }
+                break;
+            }
+            case GraphShape::CHAIN:
+                spec.sources.push_back(0U);
+                for (size_t node = 1UL; node < nodes; node++)
+                    spec.edges.emplace_back(static_cast<GraphNode>(node - 1UL), static_cast<GraphNode>(node));
+                break;
+            case GraphShape::FAN:
+                spec.sources.push_back(0U);
+                for (size_t node = 1UL; node < nodes; node++)
+                    spec.edges.emplace_back(0U, static_cast<GraphNode>(node));
+                break;
+            }
+
+            return spec;
+        }
+
+        DependencyGraph BuildGraph(const GraphSpec& spec, size_t nodes)
+        {
+            DependencyGraph graph(nodes);
+            for (const auto& [from, to] : spec.edges)
+                graph.AddEdge(from, to);
+            graph.Build();
+            return graph;
+        }
+
+        // Repeats `run` for at least `minTime` and keeps the fastest run
+        template<typename Run>
+        GraphBenchResult Measure(GraphBenchResult result, double minTime, Run&& run)
+        {
+            double total = 0.0;
+            result.seconds = 1e300;
+
+            while (total < minTime || !result.iterations)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                result.recomputed = run();
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                result.seconds = std::min(result.seconds, seconds);
+                result.iterations++;
+                total += seconds;
+            }
+
+            return result;
+        }
+    } // namespace
+
+    std::optional<GraphShape> ParseGraphShape(std::string_view name)
+    {
+        if (name == "layered")
+            return GraphShape::LAYERED;
+        if (name == "chain")
+            return GraphShape::CHAIN;
+        if (name == "fan")
+            return GraphShape::FAN;
+        return std::nullopt;
+    }
+
+    std::string_view GraphShapeName(GraphShape shape)
+    {
+        switch (shape)
+        {
+        case GraphShape::LAYERED: return "layered";
+        case GraphShape::CHAIN:   return "chain";
+        case GraphShape::FAN:     return "fan";
+        }
+        return "";
+    }
+
+    std::optional<std::vector<GraphBenchResult>> RunGraphBench(GraphShape shape, size_t nodes, double minTime, uint64_t seed)
+    {
+        const GraphSpec spec = GenerateGraph(shape, nodes, seed);
+        const GraphBenchResult base{ shape, nodes, spec.edges.size(), "", 0UL, 0UL, 0.0 };
+        std::vector<GraphBenchResult> results;
+
+        GraphBenchResult build = base;
+        build.measured = "build";
+        results.push_back(Measure(build, minTime, [&]()
+        {
+            return BuildGraph(spec, nodes).Size();
+        }));
+
+        DependencyGraph graph = BuildGraph(spec, nodes);
+        // Every node changes, like a real one that derives a new value
+        std::vector<uint64_t> values(nodes, 0U);
+        const auto recompute = [&values](GraphNode node)
+        {
+            values[node] = values[node] * 0x9E3779B97F4A7C15ULL + node + 1U;
+            return true;
+        };
+
+        GraphBenchResult full = base;
+        full.measured = "full";
+        results.push_back(Measure(full, minTime, [&]()
+        {
+            for (const GraphNode source : spec.sources)
+                graph.Schedule(source);
+            return graph.Propagate(recompute);
+        }));
+
+        if (results.back().recomputed != nodes)
+            return std::nullopt;
+
+        // Always the same source, so every iteration does the same work
+        GraphBenchResult single = base;
+        single.measured = "single";
+        results.push_back(Measure(single, minTime, [&]()
+        {
+            graph.Schedule(spec.sources.front());
+            return graph.Propagate(recompute);
+        }));
+
+        return results;
+    }
+} // namespace Aesthetic
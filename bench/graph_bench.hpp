@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Aesthetic
+{
+    enum class GraphShape : uint8_t
+    {
+        // Layers as wide as the graph is deep, every node reading one to
+        // three nodes of the layer above
+        LAYERED = 0U,
+        // Every node reads the one before, as deep as a graph gets
+        CHAIN   = 1U,
+        // Every node reads the same source, as wide as a graph gets
+        FAN     = 2U,
+    };
+
+    std::optional<GraphShape> ParseGraphShape(std::string_view name);
+    std::string_view GraphShapeName(GraphShape shape);
+
+    struct GraphBenchResult
+    {
+        GraphShape shape;
+        size_t nodes;
+        size_t edges;
+        // "build", "full" or "single"
+        std::string_view measured;
+        // Nodes recomputed by one iteration
+        size_t recomputed;
+        size_t iterations;
+        // Fastest iteration
+        double seconds;
+    };
+
+    // Measures a DependencyGraph of `nodes` nodes: merging all edges and
+    // computing the heights, one tick with every source changed, and one
+    // tick with a single source changed. Nothing if a full tick did not
+    // recompute every node exactly once.
+    std::optional<std::vector<GraphBenchResult>> RunGraphBench(GraphShape shape, size_t nodes, double minTime, uint64_t seed = 0U);
+} // namespace Aesthetic
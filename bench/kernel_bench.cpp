@@ -0,0 +1,106 @@
+#include <chrono>
+#include <memory_resource>
+#include <string>
+
+#include "corpus.hpp"
+#include "kernel_bench.hpp"
+
+namespace Aesthetic
+{
+    namespace
+    {
+        struct SpanCase
+        {
+            std::string_view name;
+            // Bytes repeated to fill the buffer, all of the kernel's class
+            std::string_view members;
+            ScanKernels::Kernel ScanKernels::* kernel;
+            size_t digits;
+        };
+
+        constexpr size_t s_NoDigits = SIZE_MAX;
+
+        const SpanCase s_SpanCases[] = {
+            { "blanks", " \t  ", &ScanKernels::blanks, s_NoDigits },
+            { "symbolic", "snake_Case42", &ScanKernels::symbolic, s_NoDigits },
+            { "hex", "0123456789abcdefABCDEF", nullptr, static_cast<size_t>(NumberLiteralType::HEX) },
+            { "oct", "01234567", nullptr, static_cast<size_t>(NumberLiteralType::OCT) },
+            { "bin", "01", nullptr, static_cast<size_t>(NumberLiteralType::BIN) },
+            { "dec", "0123456789", nullptr, static_cast<size_t>(NumberLiteralType::DEC) },
+            { "string", "a string body, no quotes ", &ScanKernels::stringBody, s_NoDigits },
+            { "ascii", "x ::= y + 1\n", &ScanKernels::ascii, s_NoDigits },
+        };
+
+        std::string Repeat(std::string_view members, size_t size)
+        {
+            std::string text;
+            text.reserve(size);
+            while (text.size() < size)
+                text += members.substr(0, size - text.size());
+            return text;
+        }
+
+        template<typename Run>
+        KernelBenchResult Measure(KernelSet set, std::string_view kernel, size_t bytes, double minTime, Run&& run)
+        {
+            KernelBenchResult result{ set, kernel, bytes, 0UL, 1e300 };
+            double total = 0.0;
+            // Keeps the results alive, the calls would be dropped otherwise
+            volatile size_t sink = 0UL;
+
+            while (total < minTime || !result.iterations)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                sink = sink + run();
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                result.seconds = std::min(result.seconds, seconds);
+                result.iterations++;
+                total += seconds;
+            }
+            return result;
+        }
+    } // namespace
+
+    std::string_view KernelSetName(KernelSet set)
+    {
+        switch (set)
+        {
+        case KernelSet::SCALAR: return "scalar";
+        case KernelSet::SSE2:   return "sse2";
+        case KernelSet::AVX2:   return "avx2";
+        }
+        return "unknown";
+    }
+
+    std::vector<KernelBenchResult> RunKernelBench(size_t size, double minTime)
+    {
+        std::vector<KernelBenchResult> results;
+        const std::string corpus = GenerateCorpus(size, CorpusProfile::SCRIPTS).substr(0, size);
+
+        for (const KernelSet set : { KernelSet::SCALAR, KernelSet::SSE2, KernelSet::AVX2 })
+        {
+            if (!ScanKernels::Supported(set))
+                continue;
+            const ScanKernels& kernels = ScanKernels::Get(set);
+
+            for (const SpanCase& span : s_SpanCases)
+            {
+                const std::string text = Repeat(span.members, size);
+                const ScanKernels::Kernel kernel = span.kernel ? kernels.*span.kernel : kernels.digits[span.digits];
+                results.push_back(Measure(set, span.name, text.size(), minTime, [&]() { return kernel(text); }));
+            }
+
+            results.push_back(Measure(set, "codepoints", corpus.size(), minTime, [&]() { return kernels.codePoints(corpus); }));
+
+            std::pmr::vector<uint32_t> starts;
+            starts.reserve(corpus.size());
+            results.push_back(Measure(set, "lines", corpus.size(), minTime, [&]()
+            {
+                starts.clear();
+                kernels.lineStarts(corpus, 0U, starts);
+                return starts.size();
+            }));
+        }
+        return results;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "lexer/kernels.hpp"
+
+namespace Aesthetic
+{
+    std::string_view KernelSetName(KernelSet set);
+
+    struct KernelBenchResult
+    {
+        KernelSet set;
+        std::string_view kernel;
+        size_t bytes;
+        size_t iterations;
+        // Fastest iteration
+        double seconds;
+    };
+
+    // Runs every kernel of every set the CPU supports over `size` bytes.
+    // Span kernels get bytes all of their class, so they cover the whole
+    // buffer; code points and line starts run over a corpus in several
+    // scripts.
+    std::vector<KernelBenchResult> RunKernelBench(size_t size, double minTime);
+} // namespace Aesthetic
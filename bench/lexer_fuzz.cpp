@@ -0,0 +1,133 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string_view>
+
+#include "lexer_fuzz.hpp"
+#include "corpus.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/lexer.hpp"
+#include "lexer/scanner.hpp"
+#include "lexer/dfa_scanner.hpp"
+
+namespace Aesthetic
+{
+    namespace
+    {
+        // Shapes at the edges of the token rules
+        constexpr std::array<std::string_view, 48UL> s_Fragments = {
+            "\"", "'", "\\", "\\n", "\\\"", "\\u{", "\\u{41}", "\\u{D800}", "\\u{110000}", "\\u{1F600}", "\\q",
+            "0x", "0o", "0b", "0x.", "1.", ".5", "..", "0b2", "00x", "1e5",
+            ":", "::", "::=", ":=", "~", "~>", "~!", "!", "!!", "!=", "/", "//", "///", "<=", "==",
+            "if", "when", "whenever", "exist", "on", "ifx", "on_",
+            "\xC3\xA9", "\xF0\x9F\x98\x80", "\xE2\x82", "\xED\xA0\x80", "\xC0\x80",
+        };
+
+        std::string Describe(const Lexeme& lexeme)
+        {
+            char text[96];
+            std::snprintf(text, sizeof(text), "kind %u subtype %u %s length %u payload %llu",
+                static_cast<unsigned>(lexeme.kind), static_cast<unsigned>(lexeme.subtype),
+                lexeme.valid ? "valid" : "invalid", lexeme.length, static_cast<unsigned long long>(lexeme.payload));
+            return text;
+        }
+
+        // Bytes outside printable ASCII as \xNN
+        std::string Escape(std::string_view text)
+        {
+            std::string out;
+            for (const char sym : text)
+            {
+                const unsigned char byte = static_cast<unsigned char>(sym);
+                if (byte >= 0x20U && byte < 0x7FU && byte != '\\')
+                {
+                    out += sym;
+                    continue;
+                }
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\x%02X", byte);
+                out += escaped;
+            }
+            return out;
+        }
+
+        bool Same(const Lexeme& lhs, const Lexeme& rhs)
+        {
+            return lhs.kind == rhs.kind && lhs.subtype == rhs.subtype && lhs.valid == rhs.valid
+                && lhs.length == rhs.length && lhs.payload == rhs.payload;
+        }
+
+        std::string Mutate(std::mt19937_64& random, std::string text)
+        {
+            for (size_t edits = random() % 8UL; edits; edits--)
+            {
+                const size_t at = text.empty() ? 0UL : random() % (text.size() + 1UL);
+                switch (random() % 4UL)
+                {
+                case 0:
+                    if (at < text.size())
+                        text[at] = static_cast<char>(random());
+                    break;
+                case 1:
+                    if (at < text.size())
+                        text.erase(at, 1UL + random() % 4UL);
+                    break;
+                default:
+                    text.insert(at, s_Fragments[random() % s_Fragments.size()]);
+                    break;
+                }
+            }
+            return text;
+        }
+    } // namespace
+
+    LexerFuzzResult RunLexerFuzz(size_t inputs, uint64_t seed)
+    {
+        std::mt19937_64 random(seed);
+        LexerFuzzResult result{ 0UL, 0UL, 0UL, 0.0, std::nullopt };
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t input = 0UL; input < inputs && !result.mismatch; input++)
+        {
+            result.inputs++;
+            const CorpusProfile profile = static_cast<CorpusProfile>(random() % 4UL);
+            const std::string corpus = GenerateCorpus(16UL + random() % 160UL, profile, random());
+            const size_t first = random() % corpus.size();
+            const std::string text = Mutate(random, corpus.substr(first, random() % 160UL));
+            result.bytes += text.size();
+
+            // Every offset, so the tokens after the first invalid one count too
+            for (size_t offset = 0UL; offset <= text.size(); offset++)
+            {
+                const std::string_view rest = std::string_view(text).substr(offset);
+                const Lexeme scanned = ScanLexeme(rest);
+                const Lexeme walked = ScanLexemeDfa(rest);
+                result.lexemes++;
+
+                if (!Same(scanned, walked))
+                {
+                    result.mismatch = "input " + std::to_string(input) + " at offset " + std::to_string(offset)
+                        + " `" + Escape(rest.substr(0UL, 24UL)) + "`: scanners " + Describe(scanned)
+                        + ", DFA " + Describe(walked);
+                    break;
+                }
+            }
+
+            const SourceBuffer source = SourceBuffer::Borrow(text, "<fuzz>");
+            const TokenStream scanned = Lexer(source, std::pmr::new_delete_resource()).Lex();
+            const TokenStream walked = DfaLexer(source, std::pmr::new_delete_resource()).Lex();
+            bool same = scanned.Size() == walked.Size();
+            for (size_t i = 0UL; same && i < scanned.Size(); i++)
+                same = scanned.Kind(i) == walked.Kind(i) && scanned.Subtype(i) == walked.Subtype(i)
+                    && scanned.Valid(i) == walked.Valid(i) && scanned.Offset(i) == walked.Offset(i)
+                    && scanned.Length(i) == walked.Length(i) && scanned.Payload(i) == walked.Payload(i);
+
+            if (!same && !result.mismatch)
+                result.mismatch = "input " + std::to_string(input) + " `" + Escape(text) + "`: the token streams differ";
+        }
+
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Aesthetic
+{
+    struct LexerFuzzResult
+    {
+        size_t inputs;
+        size_t bytes;
+        // Tokens recognized by both engines, from every offset of every input
+        size_t lexemes;
+        double seconds;
+        // What the engines disagreed on first, if they did
+        std::optional<std::string> mismatch;
+    };
+
+    // Cross-checks the DFA engine against the scanners on `inputs` random
+    // programs: corpus snippets with bytes flipped and fragments that are
+    // easy to get wrong spliced in, such as unfinished operators, number
+    // prefixes, escapes and broken UTF-8. Both engines scan a token at
+    // every offset and lex every input as a whole.
+    LexerFuzzResult RunLexerFuzz(size_t inputs, uint64_t seed);
+} // namespace Aesthetic
@@ -0,0 +1,67 @@
+#include <chrono>
+#include <ostream>
+#include <streambuf>
+
+#include "loop_bench.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/lexer.hpp"
+#include "memory/arena.hpp"
+#include "parser/parser.hpp"
+#include "runtime/resolver.hpp"
+#include "runtime/runtime.hpp"
+
+namespace Aesthetic
+{
+    namespace
+    {
+        // Formats everything and keeps nothing
+        class NullBuffer : public std::streambuf
+        {
+        protected:
+            int overflow(int c) override { return c; }
+            std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+        };
+    } // namespace
+
+    std::string LoopProgram(size_t iterations, bool print)
+    {
+        std::string program = "when #start {\n";
+        program += "    when x >= " + std::to_string(iterations) + " { ~!x }\n";
+        if (print)
+            program += "    on x { print x }\n";
+        program += "\n    x ::= 0\n    x := x + 1\n}\n";
+        return program;
+    }
+
+    std::optional<LoopBenchResult> RunLoopBench(size_t iterations, bool print)
+    {
+        const std::string program = LoopProgram(iterations, print);
+        const SourceBuffer source = SourceBuffer::Borrow(program, "<loop>");
+
+        Arena arena;
+        const TokenStream tokens = Lexer(source, &arena).Lex();
+        Parser parser(tokens, &arena);
+        const Ast ast = parser.Parse();
+        if (!parser.Errors().empty())
+            return std::nullopt;
+
+        Resolver resolver;
+        const Resolution resolution = resolver.Resolve(ast);
+        if (!resolver.Errors().empty())
+            return std::nullopt;
+
+        NullBuffer buffer;
+        std::ostream sink(&buffer);
+        Runtime runtime(ast, resolution, sink, &arena);
+
+        const auto start = std::chrono::steady_clock::now();
+        const size_t ticks = runtime.Run();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Defining x, one tick per value up to the limit, and the deletion
+        if (!runtime.Errors().empty() || ticks != iterations + 2UL)
+            return std::nullopt;
+
+        return LoopBenchResult{ print ? "print" : "quiet", iterations, ticks, seconds };
+    }
+} // namespace Aesthetic
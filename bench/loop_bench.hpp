@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Aesthetic
+{
+    struct LoopBenchResult
+    {
+        // "quiet" or "print"
+        std::string_view measured;
+        size_t iterations;
+        // Ticks the runtime took, one per iteration and a few to settle
+        size_t ticks;
+        double seconds;
+    };
+
+    // The README loop counting to `iterations` instead of 1000
+    std::string LoopProgram(size_t iterations, bool print);
+
+    // Runs the README loop on the runtime, printing every value into a sink
+    // or without the `on x` handler at all. Nothing if it did not stop
+    // after the expected number of ticks.
+    std::optional<LoopBenchResult> RunLoopBench(size_t iterations, bool print);
+} // namespace Aesthetic
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "corpus.hpp"
+#include "matcher_bench.hpp"
+#include "lexer/matcher.hpp"
+#include "lexer/token.hpp"
+
+namespace Aesthetic
+{
+    namespace
+    {
+        // FindHardToken before the trie, without the token it allocated
+        template<typename T, typename U>
+        std::optional<HardTokenMatch<U>> FindHardToken(
+            const std::string_view& text,
+            std::function<bool (const std::string_view&, const std::string&)>&& check
+        )
+        {
+            std::array<std::string, T::representations.size()> tmp;
+            std::copy(T::representations.begin(), T::representations.end(), tmp.begin());
+            std::sort(tmp.begin(), tmp.end(), std::greater<const std::string&>());
+
+            for (auto& start: tmp)
+                if (check(text, start))
+                    return HardTokenMatch<U>{
+                        static_cast<U>(std::find(
+                                T::representations.begin(),
+                                T::representations.end(),
+                                start
+                            ) - T::representations.begin()
+                        ),
+                        start.size()
+                    };
+
+            return std::nullopt;
+        }
+
+        template<typename T, typename U>
+        std::optional<HardTokenMatch<U>> FindSorted(const std::string_view& text)
+        {
+            return FindHardToken<T, U>(text, [](const std::string_view& text, const std::string& start) -> bool {
+                return text.starts_with(start);
+            });
+        }
+
+        // Sum of the types and lengths found, what both matchers have to agree on
+        template<typename Find>
+        size_t Checksum(std::string_view corpus, Find&& find, size_t& matches)
+        {
+            size_t checksum = 0UL;
+            matches = 0UL;
+            for (size_t offset = 0UL; offset < corpus.size(); offset++)
+            {
+                if (const auto match = find(corpus.substr(offset)))
+                {
+                    checksum += static_cast<size_t>(match->type) * 131UL + match->length;
+                    matches++;
+                }
+            }
+            return checksum;
+        }
+
+        template<typename T, typename U>
+        std::optional<std::array<MatcherBenchResult, 2UL>> MeasureTable(std::string_view table, std::string_view corpus, double minTime)
+        {
+            std::array<MatcherBenchResult, 2UL> results = { {
+                { table, "trie", corpus.size(), 0UL, 0UL, 1e300 },
+                { table, "sorted", corpus.size(), 0UL, 0UL, 1e300 },
+            } };
+            std::array<size_t, 2UL> checksums{};
+
+            for (size_t i = 0UL; i < results.size(); i++)
+            {
+                MatcherBenchResult& result = results[i];
+                double total = 0.0;
+                while (total < minTime || !result.iterations)
+                {
+                    const auto start = std::chrono::steady_clock::now();
+
+                    checksums[i] = i == 0UL
+                        ? Checksum(corpus, HardTokenMatcher<T::representations, U>::Find, result.matches)
+                        : Checksum(corpus, FindSorted<T, U>, result.matches);
+
+                    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    result.seconds = std::min(result.seconds, seconds);
+                    result.iterations++;
+                    total += seconds;
+                }
+            }
+
+            if (checksums[0] != checksums[1] || results[0].matches != results[1].matches)
+                return std::nullopt;
+            return results;
+        }
+    } // namespace
+
+    std::optional<std::vector<MatcherBenchResult>> RunMatcherBench(size_t size, double minTime, uint64_t seed)
+    {
+        const std::string corpus = GenerateCorpus(size, CorpusProfile::MIXED, seed);
+        std::vector<MatcherBenchResult> results;
+
+        const auto operators = MeasureTable<OperatorToken, OperationType>("operators", corpus, minTime);
+        const auto keywords = MeasureTable<KeywordToken, KeywordType>("keywords", corpus, minTime);
+        const auto punctuation = MeasureTable<PunctuationToken, PunctuationType>("punctuation", corpus, minTime);
+        if (!operators || !keywords || !punctuation)
+            return std::nullopt;
+
+        for (const auto& table : { operators.value(), keywords.value(), punctuation.value() })
+            results.insert(results.end(), table.begin(), table.end());
+        return results;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Aesthetic
+{
+    struct MatcherBenchResult
+    {
+        // "operators", "keywords" or "punctuation"
+        std::string_view table;
+        // "trie" or "sorted"
+        std::string_view matcher;
+        // Offsets looked up, and how many of them matched
+        size_t lookups;
+        size_t matches;
+        size_t iterations;
+        // Fastest iteration
+        double seconds;
+    };
+
+    // Looks up every representation table at every offset of a corpus of
+    // `size` bytes, with HardTokenMatcher and with the search it replaced:
+    // the table copied and sorted in descending order, a std::function
+    // check of every entry and std::find for the type. Nothing if the two
+    // disagree on a match.
+    std::optional<std::vector<MatcherBenchResult>> RunMatcherBench(size_t size, double minTime, uint64_t seed = 0U);
+} // namespace Aesthetic
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "corpus.hpp"
+#include "parallel_bench.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/lexer.hpp"
+#include "lexer/parallel_lexer.hpp"
+#include "memory/arena.hpp"
+
+namespace Aesthetic
+{
+    namespace
+    {
+        bool SameTokens(const TokenStream& lhs, const TokenStream& rhs)
+        {
+            if (lhs.Size() != rhs.Size())
+                return false;
+            for (size_t i = 0UL; i < lhs.Size(); i++)
+                if (lhs.Kind(i) != rhs.Kind(i) || lhs.Subtype(i) != rhs.Subtype(i) || lhs.Valid(i) != rhs.Valid(i)
+                    || lhs.Offset(i) != rhs.Offset(i) || lhs.Length(i) != rhs.Length(i) || lhs.Payload(i) != rhs.Payload(i))
+                    return false;
+            return true;
+        }
+    } // namespace
+
+    std::optional<ParallelBenchResult> RunParallelBench(size_t size, size_t threads, double minTime, uint64_t seed)
+    {
+        const std::string corpus = GenerateCorpus(size, CorpusProfile::MIXED, seed);
+        const SourceBuffer source = SourceBuffer::Borrow(corpus, "<corpus>");
+        std::optional<ThreadPool> pool;
+        if (threads)
+            pool.emplace(threads);
+
+        ParallelBenchResult result{ threads, corpus.size(), 0UL, 0UL, 1e300 };
+        double total = 0.0;
+
+        while (total < minTime || !result.iterations)
+        {
+            Arena arena;
+            const auto start = std::chrono::steady_clock::now();
+
+            const TokenStream tokens = pool
+                ? ParallelLexer(source, pool.value(), &arena).Lex()
+                : Lexer(source, &arena).Lex();
+
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            result.seconds = std::min(result.seconds, seconds);
+            result.tokens = tokens.Size();
+            result.iterations++;
+            total += seconds;
+
+            if (pool && result.iterations == 1UL && !SameTokens(tokens, Lexer(source, &arena).Lex()))
+                return std::nullopt;
+        }
+        return result;
+    }
+} // namespace Aesthetic
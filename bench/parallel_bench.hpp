@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace Aesthetic
+{
+    struct ParallelBenchResult
+    {
+        // 0 for the serial Lexer the speedups are against
+        size_t threads;
+        size_t bytes;
+        size_t tokens;
+        size_t iterations;
+        // Fastest iteration
+        double seconds;
+    };
+
+    // Lexes a corpus of `size` bytes with the serial Lexer when `threads`
+    // is 0, and with a ParallelLexer on a pool of `threads` threads
+    // otherwise. Nothing if the tokens differ from the serial ones.
+    std::optional<ParallelBenchResult> RunParallelBench(size_t size, size_t threads, double minTime, uint64_t seed = 0U);
+} // namespace Aesthetic
@@ -1,8 +1,343 @@
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "driver/driver.hpp"
+#include "io/source_buffer.hpp"
+#include "io/syntax_cache.hpp"
+#include "io/token_dump.hpp"
 #include "lexer/lexer.hpp"
+#include "lexer/lexer_stats.hpp"
+#include "lexer/parallel_lexer.hpp"
+#include "memory/arena.hpp"
+#include "parser/parser.hpp"
+#include "runtime/resolver.hpp"
+#include "runtime/runtime.hpp"
+#include "util/interner.hpp"
 
 using namespace Aesthetic;
 
-int main()
+// This file is rebuilt with every build, so caches never outlive the
+// lexer and parser that wrote them
+static const uint64_t s_Build = Interner::Hash(__VERSION__ " " __DATE__ " " __TIME__);
+
+struct Options
+{
+    size_t threads = 1UL;
+    size_t lexThreads = 0UL;
+    size_t jobs = 0UL;
+    bool cache = false;
+    bool check = false;
+    bool time = false;
+    bool stats = false;
+    std::optional<DumpFormat> dump;
+};
+
+static bool ParseCount(std::string_view value, std::string_view what, size_t& count)
+{
+    const auto result = std::from_chars(value.data(), value.data() + value.size(), count);
+    if (result.ec != std::errc() || result.ptr != value.data() + value.size())
+    {
+        std::cerr << "invalid " << what << " '" << value << "'\n";
+        return false;
+    }
+    return true;
+}
+
+static double Seconds(uint64_t nanoseconds)
+{
+    return static_cast<double>(nanoseconds) / 1e9;
+}
+
+static void PrintStats(const DriverStats& stats, size_t jobs)
+{
+    const double megabytes = static_cast<double>(stats.bytes) / (1024.0 * 1024.0);
+
+    std::cerr << std::fixed << std::setprecision(3)
+              << stats.files << " files, " << megabytes << " MiB, " << stats.tokens << " tokens, "
+              << stats.nodes << " nodes, " << stats.cached << " from cache, " << stats.failed << " failed\n"
+              << "wall  " << Seconds(stats.wall) << " s, " << megabytes / std::max(Seconds(stats.wall), 1e-9)
+              << " MiB/s on " << jobs << (jobs == 1UL ? " job\n" : " jobs\n")
+              << "cpu   read " << Seconds(stats.cpu.read) << " s, lex " << Seconds(stats.cpu.lex)
+              << " s, parse " << Seconds(stats.cpu.parse) << " s, resolve " << Seconds(stats.cpu.resolve)
+              << " s, cache " << Seconds(stats.cpu.cache)
+              << " s, total " << Seconds(stats.cpu.Total()) << " s\n";
+}
+
+static void PrintLexerStats()
+{
+    static constexpr std::array<std::string_view, LexerStats::s_Scanners> scanners = {
+        "eof", "string", "number", "operator", "keyword", "punctuation", "symbol"
+    };
+    static constexpr std::array<std::string_view, LexerStats::s_Kinds> kinds = {
+        "invalid", "eof", "operator", "keyword", "punctuation", "symbol", "string", "float", "integer"
+    };
+
+    if (!LexerCounters::s_Enabled)
+    {
+        std::cerr << "lexer statistics are not compiled in, build with LEXER_STATS=1\n";
+        return;
+    }
+
+    const LexerStats stats = LexerCounters::Snapshot();
+    const auto ratio = [](uint64_t part, uint64_t whole) {
+        return whole ? static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+    };
+    const auto row = [&ratio](std::string_view name, const LexerStats::Kind& kind) {
+        std::cerr << std::left << std::setw(14) << name << std::right << std::setw(12) << kind.tokens
+                  << std::setw(14) << kind.bytes << std::setw(16) << kind.Cycles()
+                  << std::setw(10) << ratio(kind.sampledCycles, kind.samples)
+                  << std::setw(10) << ratio(kind.Cycles(), kind.bytes) << '\n';
+    };
+
+    std::cerr << std::fixed << std::setprecision(1)
+              << "lexer: " << stats.Tokens() << " tokens, " << stats.Bytes() << " bytes, "
+              << stats.Cycles() << " cycles (sampled), " << ratio(stats.Cycles(), stats.Bytes()) << " cycles/byte\n"
+              << std::left << std::setw(14) << "scanner" << std::right << std::setw(12) << "attempts"
+              << std::setw(14) << "successes" << std::setw(10) << "hit %\n";
+    for (size_t i = 0UL; i < scanners.size(); i++)
+    {
+        const LexerStats::Scanner& scanner = stats.scanners[i];
+        std::cerr << std::left << std::setw(14) << scanners[i] << std::right << std::setw(12) << scanner.attempts
+                  << std::setw(14) << scanner.successes << std::setw(9) << 100.0 * ratio(scanner.successes, scanner.attempts) << '\n';
+    }
+
+    std::cerr << std::left << std::setw(14) << "kind" << std::right << std::setw(12) << "tokens"
+              << std::setw(14) << "bytes" << std::setw(16) << "cycles" << std::setw(10) << "/token"
+              << std::setw(10) << "/byte" << '\n';
+    for (size_t i = 0UL; i < kinds.size(); i++)
+        row(kinds[i], stats.kinds[i]);
+    row("gaps", stats.gaps);
+
+    // Sampled cycles per token in powers of two, only the buckets any kind used
+    size_t first = LexerStats::s_Buckets;
+    size_t last = 0UL;
+    const auto range = [&first, &last](const LexerStats::Kind& kind) {
+        for (size_t i = 0UL; i < LexerStats::s_Buckets; i++)
+        {
+            if (kind.histogram[i])
+            {
+                first = std::min(first, i);
+                last = std::max(last, i);
+            }
+        }
+    };
+    for (const LexerStats::Kind& kind : stats.kinds)
+        range(kind);
+    range(stats.gaps);
+    if (first > last)
+        return;
+
+    const auto histogram = [first, last](std::string_view name, const LexerStats::Kind& kind) {
+        if (!kind.samples)
+            return;
+        std::cerr << std::left << std::setw(14) << name << std::right;
+        for (size_t i = first; i <= last; i++)
+            std::cerr << std::setw(9) << kind.histogram[i];
+        std::cerr << '\n';
+    };
+
+    std::cerr << std::left << std::setw(14) << "cycles" << std::right;
+    for (size_t i = first; i <= last; i++)
+    {
+        const bool open = i == LexerStats::s_Buckets - 1UL;
+        std::cerr << std::setw(9) << (open ? ">=2^" : "<2^") + std::to_string(open ? i - 1UL : i);
+    }
+    std::cerr << '\n';
+    for (size_t i = 0UL; i < kinds.size(); i++)
+        histogram(kinds[i], stats.kinds[i]);
+    histogram("gaps", stats.gaps);
+}
+
+// Lexes, parses and resolves every input without running anything
+static int CheckFiles(const std::vector<std::string>& inputs, const Options& options)
 {
+    const std::optional<std::vector<std::string>> files = Driver::ExpandInputs(inputs, std::cerr);
+    if (!files)
+        return 1;
+
+    Driver driver(DriverOptions{ options.jobs, options.cache, s_Build });
+    const bool clean = driver.Check(files.value(), std::cerr);
+
+    if (options.time)
+        PrintStats(driver.Stats(), driver.Jobs());
+    return clean ? 0 : 1;
+}
+
+// Large programs are lexed in chunks on a thread pool, into the same tokens
+static TokenStream Lex(const SourceBuffer& source, Arena& arena, size_t threads)
+{
+    if (source.Size() >= ParallelLexer::s_MinParallelSize && threads != 1UL)
+    {
+        ThreadPool pool(threads);
+        if (pool.Size() > 1UL)
+            return ParallelLexer(source, pool, &arena).Lex();
+    }
+    return Lexer(source, &arena).Lex();
+}
+
+// Writes the tokens to stdout instead of running the program
+static int DumpTokens(const SourceBuffer& source, const Options& options)
+{
+    Arena arena;
+    const TokenStream tokens = Lex(source, arena, options.lexThreads);
+
+    OutputBuffer out(1);
+    TokenDumper(out, options.dump.value()).Dump(tokens);
+    if (!out.Flush())
+    {
+        std::cerr << "<stdout>: " << std::strerror(errno) << '\n';
+        return 1;
+    }
     return 0;
 }
+
+static int RunFile(const std::string& path, const Options& options)
+{
+    std::optional<SourceBuffer> source = path == "-"
+        ? SourceBuffer::FromDescriptor(0, "<stdin>")
+        : SourceBuffer::Open(path);
+
+    if (!source)
+    {
+        std::cerr << path << ": " << std::strerror(errno) << '\n';
+        return 1;
+    }
+
+    if (options.dump)
+        return DumpTokens(source.value(), options);
+
+    Arena arena;
+    TokenStream tokens(source->View(), &arena);
+    Ast ast(tokens, &arena);
+
+    // Only programs without parse errors are cached, a hit has none to report
+    const bool cached = options.cache && path != "-";
+    const std::string cachePath = path + ".aec";
+
+    if (const std::optional<SyntaxCache> cache = cached ? SyntaxCache::Open(cachePath, s_Build, source->View()) : std::nullopt)
+        cache->Load(tokens, ast);
+    else
+    {
+        tokens = Lex(source.value(), arena, options.lexThreads);
+
+        Parser parser(tokens, &arena);
+        ast = parser.Parse();
+
+        for (const ParseError& error : parser.Errors())
+            std::cerr << source->Path() << ':' << tokens.Pos(error.token) << ": " << error.message << '\n';
+
+        if (!parser.Errors().empty())
+            return 1;
+
+        // A cache that cannot be written only costs the next run its head start
+        if (cached && !SyntaxCache::Write(cachePath, s_Build, source->View(), tokens, ast))
+            std::cerr << cachePath << ": " << std::strerror(errno) << '\n';
+    }
+
+    Resolver resolver;
+    const Resolution resolution = resolver.Resolve(ast);
+
+    for (const ResolveError& error : resolver.Errors())
+        std::cerr << source->Path() << ':' << tokens.Pos(error.token) << ": " << error.message << '\n';
+
+    if (!resolver.Errors().empty())
+        return 1;
+
+    Runtime runtime(ast, resolution, std::cout, &arena, options.threads);
+    runtime.Run();
+
+    for (const RuntimeError& error : runtime.Errors())
+        std::cerr << source->Path() << ':' << tokens.Pos(error.token) << ": " << error.message << '\n';
+
+    return runtime.Errors().empty() ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    int arg = 1;
+
+    for (; arg < argc && std::string_view(argv[arg]).substr(0UL, 2UL) == "--"; arg++)
+    {
+        const std::string_view option = argv[arg];
+        if (option == "--cache")
+            options.cache = true;
+        else if (option == "--check")
+            options.check = true;
+        else if (option == "--time")
+            options.time = true;
+        else if (option == "--stats")
+            options.stats = true;
+        else if (option.substr(0UL, 13UL) == "--dump-tokens" && (option.size() == 13UL || option[13] == '='))
+        {
+            options.dump = option.size() == 13UL ? DumpFormat::TEXT : TokenDumper::ParseFormat(option.substr(14UL));
+            if (!options.dump)
+            {
+                std::cerr << "invalid dump format '" << option.substr(14UL) << "'\n";
+                return 1;
+            }
+        }
+        else if (option == "--threads" && arg + 1 < argc)
+        {
+            if (!ParseCount(argv[++arg], "thread count", options.threads))
+                return 1;
+        }
+        else if (option == "--lex-threads" && arg + 1 < argc)
+        {
+            if (!ParseCount(argv[++arg], "thread count", options.lexThreads))
+                return 1;
+        }
+        else if (option == "--jobs" && arg + 1 < argc)
+        {
+            if (!ParseCount(argv[++arg], "job count", options.jobs))
+                return 1;
+        }
+        else
+            break;
+    }
+
+    const std::vector<std::string> inputs(argv + arg, argv + argc);
+    if (inputs.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " [options] <file>|-\n"
+                  << "       " << argv[0] << " [options] <file|directory|@list>...\n"
+                  << "One file is run, several files, directories and lists are only checked.\n"
+                  << "  --threads N    runs handlers on N threads, 0 for one per core (default 1)\n"
+                  << "  --lex-threads N\n"
+                  << "                 lexes a file of 4 MiB or more on N threads, 0 for one per core\n"
+                  << "                 (default 0)\n"
+                  << "  --cache        keeps the parsed program in <file>.aec for the next run\n"
+                  << "  --dump-tokens  prints the tokens instead of running, FORMAT is text (default),\n"
+                  << "                 json for JSON lines or binary\n"
+                  << "  --check        only lexes, parses and resolves, even a single file\n"
+                  << "  --jobs N       checks files on N threads, 0 for one per core (default 0)\n"
+                  << "  --time         reports wall-clock and per-stage CPU time of a check\n"
+                  << "  --stats        reports what the lexer did per scanner and token kind\n";
+        return 1;
+    }
+
+    std::error_code error;
+    const bool single = inputs.size() == 1UL && !inputs.front().starts_with('@')
+        && !std::filesystem::is_directory(inputs.front(), error);
+
+    if (options.dump && !single)
+    {
+        std::cerr << "--dump-tokens takes a single file\n";
+        return 1;
+    }
+
+    const int status = single && !options.check ? RunFile(inputs.front(), options) : CheckFiles(inputs, options);
+    if (options.stats)
+        PrintLexerStats();
+    return status;
+}
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+
+#include <time.h>
+
+#include "driver.hpp"
+#include "io/source_buffer.hpp"
+#include "io/syntax_cache.hpp"
+#include "lexer/lexer.hpp"
+#include "parser/parser.hpp"
+
+namespace Aesthetic
+{
+    // Response files listing themselves must end somewhere
+    static constexpr size_t s_MaxResponseDepth = 16UL;
+
+    static uint64_t ThreadCpuTime()
+    {
+        timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000UL + static_cast<uint64_t>(now.tv_nsec);
+    }
+
+    StageTimes& StageTimes::operator+=(const StageTimes& other)
+    {
+        read += other.read;
+        lex += other.lex;
+        parse += other.parse;
+        resolve += other.resolve;
+        cache += other.cache;
+        return *this;
+    }
+
+    Driver::Driver(const DriverOptions& options)
+        : m_Options(options), m_Pool(options.jobs)
+    {
+        for (size_t i = 0UL; i < m_Pool.Size(); i++)
+            m_Workers.push_back(std::make_unique<Worker>());
+    }
+
+    std::optional<std::vector<std::string>> Driver::ExpandInputs(const std::vector<std::string>& inputs, std::ostream& errors)
+    {
+        std::vector<std::string> files;
+        for (const std::string& input : inputs)
+            if (!Expand(input, 0UL, files, errors))
+                return std::nullopt;
+        return files;
+    }
+
+    bool Driver::Expand(const std::string& input, size_t depth, std::vector<std::string>& files, std::ostream& errors)
+    {
+        namespace fs = std::filesystem;
+
+        if (input.size() > 1UL && input.front() == '@')
+        {
+            const std::string path = input.substr(1UL);
+            const std::optional<SourceBuffer> list = SourceBuffer::Open(path);
+            if (!list)
+            {
+                errors << path << ": " << std::strerror(errno) << '\n';
+                return false;
+            }
+            if (depth == s_MaxResponseDepth)
+            {
+                errors << path << ": response files nested too deep\n";
+                return false;
+            }
+
+            std::string_view rest = list->View();
+            while (!rest.empty())
+            {
+                const size_t end = std::min(rest.find('\n'), rest.size());
+                std::string_view line = rest.substr(0UL, end);
+                rest.remove_prefix(std::min(end + 1UL, rest.size()));
+
+                const size_t first = line.find_first_not_of(" \t\r");
+                if (first == std::string_view::npos || line[first] == '#')
+                    continue;
+                line = line.substr(first, line.find_last_not_of(" \t\r") + 1UL - first);
+
+                if (!Expand(std::string(line), depth + 1UL, files, errors))
+                    return false;
+            }
+            return true;
+        }
+
+        std::error_code error;
+        if (!fs::is_directory(input, error))
+        {
+            // Files that cannot be read are reported when they are checked
+            files.push_back(input);
+            return true;
+        }
+
+        std::vector<std::string> found;
+        fs::recursive_directory_iterator it(input, fs::directory_options::skip_permission_denied, error);
+        for (; !error && it != fs::recursive_directory_iterator(); it.increment(error))
+            if (it->path().extension() == ".ae" && it->is_regular_file(error))
+                found.push_back(it->path().string());
+
+        if (error)
+        {
+            errors << input << ": " << error.message() << '\n';
+            return false;
+        }
+
+        std::sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+        return true;
+    }
+
+    bool Driver::Check(const std::vector<std::string>& files, std::ostream& errors)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (std::unique_ptr<Worker>& worker : m_Workers)
+            worker->stats = DriverStats{};
+
+        std::vector<std::string> diagnostics(files.size());
+        m_Pool.ParallelFor(files.size(), [this, &files, &diagnostics](size_t task, size_t worker) {
+            CheckFile(files[task], *m_Workers[worker], diagnostics[task]);
+        });
+
+        m_Stats = DriverStats{};
+        for (const std::string& text : diagnostics)
+            errors << text;
+
+        for (const std::unique_ptr<Worker>& worker : m_Workers)
+        {
+            m_Stats.files += worker->stats.files;
+            m_Stats.failed += worker->stats.failed;
+            m_Stats.cached += worker->stats.cached;
+            m_Stats.bytes += worker->stats.bytes;
+            m_Stats.tokens += worker->stats.tokens;
+            m_Stats.nodes += worker->stats.nodes;
+            m_Stats.cpu += worker->stats.cpu;
+        }
+
+        m_Stats.wall = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        return !m_Stats.failed;
+    }
+
+    void Driver::CheckFile(const std::string& path, Worker& worker, std::string& diagnostics)
+    {
+        DriverStats& stats = worker.stats;
+        stats.files++;
+
+        uint64_t last = ThreadCpuTime();
+        const auto lap = [&last](uint64_t& stage) {
+            const uint64_t now = ThreadCpuTime();
+            stage += now - last;
+            last = now;
+        };
+
+        const std::optional<SourceBuffer> source = SourceBuffer::Open(path);
+        lap(stats.cpu.read);
+        if (!source)
+        {
+            diagnostics = path + ": " + std::strerror(errno) + '\n';
+            stats.failed++;
+            return;
+        }
+
+        {
+            TokenStream tokens(source->View(), &worker.arena);
+            Ast ast(tokens, &worker.arena);
+
+            const std::string cachePath = path + ".aec";
+            bool parsed = true;
+            const std::optional<SyntaxCache> cache = m_Options.cache
+                ? SyntaxCache::Open(cachePath, m_Options.build, source->View())
+                : std::nullopt;
+
+            if (cache)
+            {
+                cache->Load(tokens, ast);
+                lap(stats.cpu.cache);
+                stats.cached++;
+            }
+            else
+            {
+                Lexer lexer(source.value(), &worker.arena);
+                tokens = lexer.Lex();
+                lap(stats.cpu.lex);
+
+                Parser parser(tokens, &worker.arena);
+                ast = parser.Parse();
+                lap(stats.cpu.parse);
+
+                if (!parser.Errors().empty())
+                {
+                    std::ostringstream out;
+                    for (const ParseError& error : parser.Errors())
+                        out << source->Path() << ':' << tokens.Pos(error.token) << ": " << error.message << '\n';
+                    diagnostics = out.str();
+                    stats.failed++;
+                    parsed = false;
+                }
+                else if (m_Options.cache)
+                {
+                    if (!SyntaxCache::Write(cachePath, m_Options.build, source->View(), tokens, ast))
+                        diagnostics = cachePath + ": " + std::strerror(errno) + '\n';
+                    lap(stats.cpu.cache);
+                }
+            }
+
+            // Caches only hold syntax, cached programs are resolved too
+            if (parsed)
+            {
+                worker.resolver.Resolve(ast);
+                lap(stats.cpu.resolve);
+
+                if (!worker.resolver.Errors().empty())
+                {
+                    std::ostringstream out;
+                    for (const ResolveError& error : worker.resolver.Errors())
+                        out << source->Path() << ':' << tokens.Pos(error.token) << ": " << error.message << '\n';
+                    diagnostics += out.str();
+                    stats.failed++;
+                }
+            }
+
+            stats.bytes += source->Size();
+            stats.tokens += tokens.Size();
+            stats.nodes += ast.Size();
+        }
+
+        // Nothing of the file is left, the next one reuses the memory
+        worker.arena.Reset();
+    }
+} // namespace Aesthetic
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "memory/arena.hpp"
+#include "runtime/resolver.hpp"
+#include "util/work_stealing_pool.hpp"
+
+namespace Aesthetic
+{
+    struct DriverOptions
+    {
+        // Zero means one per hardware thread
+        size_t jobs = 0UL;
+        // Use and refresh a SyntaxCache next to every file
+        bool cache = false;
+        // Build ID the caches are tied to
+        uint64_t build = 0U;
+    };
+
+    // CPU time spent in each stage, summed over all workers, in nanoseconds
+    struct StageTimes
+    {
+        uint64_t read = 0U;
+        uint64_t lex = 0U;
+        uint64_t parse = 0U;
+        uint64_t resolve = 0U;
+        uint64_t cache = 0U;
+
+        uint64_t Total() const { return read + lex + parse + resolve + cache; }
+        StageTimes& operator+=(const StageTimes& other);
+    };
+
+    struct DriverStats
+    {
+        size_t files = 0UL;
+        size_t failed = 0UL;
+        size_t cached = 0UL;
+        size_t bytes = 0UL;
+        size_t tokens = 0UL;
+        size_t nodes = 0UL;
+        uint64_t wall = 0U;
+        StageTimes cpu;
+    };
+
+    // Lexes, parses and resolves many files at once on a bounded
+    // WorkStealingPool. Every worker reuses its own Arena and Resolver for
+    // one file after another, and keeps its own counters, so workers share
+    // nothing but the interner.
+    // Diagnostics are collected per file and written in input order, the
+    // output does not depend on the number of workers or on scheduling.
+    class Driver
+    {
+    private:
+        struct alignas(64) Worker
+        {
+            Arena arena;
+            Resolver resolver;
+            // Of the files this worker checked, merged after the run
+            DriverStats stats;
+        };
+
+        DriverOptions m_Options;
+        WorkStealingPool m_Pool;
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        DriverStats m_Stats;
+    public:
+        explicit Driver(const DriverOptions& options);
+
+        // Turns command line inputs into the files they stand for, in order:
+        // a directory is every .ae file below it in sorted order, `@list` is
+        // the inputs in `list`, one per line, blank lines and lines starting
+        // with '#' skipped. Nothing if a directory or list cannot be read,
+        // the reason is written to `errors`.
+        static std::optional<std::vector<std::string>> ExpandInputs(const std::vector<std::string>& inputs, std::ostream& errors);
+
+        size_t Jobs() const { return m_Pool.Size(); }
+
+        // Checks every file and writes the diagnostics to `errors`.
+        // True if all of them were free of errors.
+        bool Check(const std::vector<std::string>& files, std::ostream& errors);
+        // Of the last Check()
+        const DriverStats& Stats() const { return m_Stats; }
+    private:
+        static bool Expand(const std::string& input, size_t depth, std::vector<std::string>& files, std::ostream& errors);
+
+        // Fills `diagnostics` with what went wrong
+        void CheckFile(const std::string& path, Worker& worker, std::string& diagnostics);
+    };
+} // namespace Aesthetic
@@ -0,0 +1,88 @@
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+
+#include <unistd.h>
+
+#include "output_buffer.hpp"
+
+namespace Aesthetic
+{
+    OutputBuffer::OutputBuffer(int descriptor)
+        : m_Descriptor(descriptor), m_Data(new char[s_Capacity]), m_Size(0UL), m_Error(0) {}
+
+    OutputBuffer::~OutputBuffer()
+    {
+        Drain();
+    }
+
+    void OutputBuffer::Unsigned(uint64_t value)
+    {
+        char* first = Claim(s_MaxNumber);
+        const auto result = std::to_chars(first, first + s_MaxNumber, value);
+        Commit(static_cast<size_t>(result.ptr - first));
+    }
+
+    void OutputBuffer::Double(double value)
+    {
+        char* first = Claim(s_MaxNumber);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        const auto result = std::to_chars(first, first + s_MaxNumber, value);
+        Commit(static_cast<size_t>(result.ptr - first));
+#else
+        // No floating point to_chars, snprintf at least skips the stream
+        Commit(static_cast<size_t>(std::snprintf(first, s_MaxNumber, "%.17g", value)));
+#endif
+    }
+
+    void OutputBuffer::Double(double value, int precision)
+    {
+        char* first = Claim(s_MaxNumber);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        const auto result = std::to_chars(first, first + s_MaxNumber, value, std::chars_format::general, precision);
+        Commit(static_cast<size_t>(result.ptr - first));
+#else
+        Commit(static_cast<size_t>(std::snprintf(first, s_MaxNumber, "%.*g", precision, value)));
+#endif
+    }
+
+    bool OutputBuffer::Flush()
+    {
+        Drain();
+        if (m_Error)
+            errno = m_Error;
+        return !m_Error;
+    }
+
+    void OutputBuffer::Drain()
+    {
+        WriteAll(std::string_view(m_Data.get(), m_Size));
+        m_Size = 0UL;
+    }
+
+    void OutputBuffer::Spill(std::string_view text)
+    {
+        Drain();
+        if (text.size() >= s_Capacity)
+            return WriteAll(text);
+
+        std::memcpy(m_Data.get(), text.data(), text.size());
+        m_Size = text.size();
+    }
+
+    void OutputBuffer::WriteAll(std::string_view data)
+    {
+        while (!data.empty() && !m_Error)
+        {
+            const ssize_t written = ::write(m_Descriptor, data.data(), data.size());
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+            {
+                m_Error = written < 0 ? errno : EIO;
+                return;
+            }
+            data.remove_prefix(static_cast<size_t>(written));
+        }
+    }
+} // namespace Aesthetic
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace Aesthetic
+{
+    // Buffered writes to a file descriptor without streams. Text and numbers
+    // are formatted straight into one reusable buffer, which goes out in a
+    // single write() whenever it fills up. After a failed write everything
+    // else is dropped, Flush() reports it with errno set.
+    class OutputBuffer
+    {
+    public:
+        static constexpr size_t s_Capacity = 1UL << 16U;
+        // Longest text Double() and Unsigned() produce
+        static constexpr size_t s_MaxNumber = 32UL;
+    private:
+        int m_Descriptor;
+        std::unique_ptr<char[]> m_Data;
+        size_t m_Size;
+        int m_Error;
+    public:
+        explicit OutputBuffer(int descriptor);
+        ~OutputBuffer();
+
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+        void Append(std::string_view text)
+        {
+            if (text.size() > s_Capacity - m_Size)
+                return Spill(text);
+
+            std::memcpy(m_Data.get() + m_Size, text.data(), text.size());
+            m_Size += text.size();
+        }
+
+        void Append(char sym)
+        {
+            if (m_Size == s_Capacity)
+                Drain();
+            m_Data[m_Size++] = sym;
+        }
+
+        // Room for `bytes` more, at most s_Capacity. Write there and Commit().
+        char* Claim(size_t bytes)
+        {
+            if (bytes > s_Capacity - m_Size)
+                Drain();
+            return m_Data.get() + m_Size;
+        }
+
+        void Commit(size_t bytes) { m_Size += bytes; }
+
+        void Unsigned(uint64_t value);
+        // Shortest text that reads back as the same double
+        void Double(double value);
+        // As printf's %g, an ostream with default flags is Double(value, 6)
+        void Double(double value, int precision);
+
+        // False with errno set if any write failed
+        bool Flush();
+    private:
+        // Writes out the buffer
+        void Drain();
+        // Drains and writes `text` that does not fit as it is
+        void Spill(std::string_view text);
+        void WriteAll(std::string_view data);
+    };
+} // namespace Aesthetic
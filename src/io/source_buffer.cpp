@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "source_buffer.hpp"
+
+namespace Aesthetic
+{
+    SourceBuffer::SourceBuffer(std::string path)
+        : m_Path(std::move(path)), m_Data(nullptr), m_Size(0UL), m_Storage(Storage::OWNED) {}
+
+    SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept
+        : m_Path(std::move(other.m_Path)), m_Data(other.m_Data), m_Size(other.m_Size),
+          m_Storage(other.m_Storage), m_Owned(std::move(other.m_Owned))
+    {
+        if (m_Storage == Storage::OWNED)
+            m_Data = m_Owned.data();
+
+        other.m_Data = nullptr;
+        other.m_Size = 0UL;
+        other.m_Storage = Storage::OWNED;
+    }
+
+    SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        Unmap();
+        m_Path = std::move(other.m_Path);
+        m_Data = other.m_Data;
+        m_Size = other.m_Size;
+        m_Storage = other.m_Storage;
+        m_Owned = std::move(other.m_Owned);
+        if (m_Storage == Storage::OWNED)
+            m_Data = m_Owned.data();
+
+        other.m_Data = nullptr;
+        other.m_Size = 0UL;
+        other.m_Storage = Storage::OWNED;
+        return *this;
+    }
+
+    SourceBuffer::~SourceBuffer()
+    {
+        Unmap();
+    }
+
+    std::optional<SourceBuffer> SourceBuffer::Open(const std::string& path)
+    {
+        const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0)
+            return std::nullopt;
+
+        std::optional<SourceBuffer> result = FromDescriptor(descriptor, path);
+
+        const int error = errno;
+        ::close(descriptor);
+        errno = error;
+
+        return result;
+    }
+
+    std::optional<SourceBuffer> SourceBuffer::FromDescriptor(int descriptor, const std::string& name)
+    {
+        SourceBuffer buffer(name);
+        struct stat info;
+
+        if (::fstat(descriptor, &info) < 0)
+            return std::nullopt;
+
+        if (S_ISREG(info.st_mode) && info.st_size > 0 && buffer.Map(descriptor, static_cast<size_t>(info.st_size)))
+            return buffer;
+
+        if (!buffer.ReadAll(descriptor))
+            return std::nullopt;
+
+        return buffer;
+    }
+
+    SourceBuffer SourceBuffer::FromString(std::string text, const std::string& name)
+    {
+        SourceBuffer buffer(name);
+        buffer.m_Owned = std::move(text);
+        buffer.m_Data = buffer.m_Owned.data();
+        buffer.m_Size = buffer.m_Owned.size();
+        return buffer;
+    }
+
+    SourceBuffer SourceBuffer::Borrow(std::string_view text, const std::string& name)
+    {
+        SourceBuffer buffer(name);
+        buffer.m_Data = text.data();
+        buffer.m_Size = text.size();
+        buffer.m_Storage = Storage::BORROWED;
+        return buffer;
+    }
+
+    bool SourceBuffer::Map(int descriptor, size_t size)
+    {
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data == MAP_FAILED)
+            return false;
+
+        // The lexer walks the text front to back exactly once. Only the start
+        // is read in ahead, sequential readahead keeps up from there without
+        // pulling the whole file into memory at once.
+        constexpr size_t prefetchSize = 2UL * 1024UL * 1024UL;
+        ::madvise(data, size, MADV_SEQUENTIAL);
+        ::madvise(data, std::min(size, prefetchSize), MADV_WILLNEED);
+
+        m_Data = static_cast<const char*>(data);
+        m_Size = size;
+        m_Storage = Storage::MAPPED;
+        return true;
+    }
+
+    bool SourceBuffer::ReadAll(int descriptor)
+    {
+        constexpr size_t chunkSize = 64UL * 1024UL;
+        size_t used = 0UL;
+
+        while (true)
+        {
+            m_Owned.resize(used + chunkSize);
+            const ssize_t read = ::read(descriptor, m_Owned.data() + used, chunkSize);
+
+            if (read < 0 && errno == EINTR)
+                continue;
+            if (read < 0)
+                return false;
+            if (read == 0)
+                break;
+
+            used += static_cast<size_t>(read);
+        }
+
+        m_Owned.resize(used);
+        m_Owned.shrink_to_fit();
+        m_Data = m_Owned.data();
+        m_Size = used;
+        return true;
+    }
+
+    void SourceBuffer::Unmap()
+    {
+        if (m_Storage == Storage::MAPPED)
+            ::munmap(const_cast<char*>(m_Data), m_Size);
+
+        m_Data = nullptr;
+        m_Size = 0UL;
+        m_Storage = Storage::OWNED;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Aesthetic
+{
+    // Read-only program text. Regular files are memory-mapped and lexed in
+    // place, anything else (pipes, terminals) is read into an owned buffer.
+    // Token views point straight into the buffer, so it has to outlive them.
+    // A borrowed buffer only refers to text somebody else keeps alive.
+    class SourceBuffer
+    {
+    private:
+        enum class Storage
+        {
+            OWNED,
+            MAPPED,
+            BORROWED,
+        };
+
+        std::string m_Path;
+        const char* m_Data;
+        size_t m_Size;
+        Storage m_Storage;
+        std::string m_Owned;
+    public:
+        // Returns nothing if the file cannot be opened or read, errno tells why
+        static std::optional<SourceBuffer> Open(const std::string& path);
+        static std::optional<SourceBuffer> FromDescriptor(int descriptor, const std::string& name);
+        static SourceBuffer FromString(std::string text, const std::string& name);
+        static SourceBuffer Borrow(std::string_view text, const std::string& name);
+
+        SourceBuffer(SourceBuffer&& other) noexcept;
+        SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+        SourceBuffer(const SourceBuffer&) = delete;
+        SourceBuffer& operator=(const SourceBuffer&) = delete;
+        ~SourceBuffer();
+
+        const std::string& Path() const { return m_Path; }
+        std::string_view View() const { return std::string_view(m_Data, m_Size); }
+        size_t Size() const { return m_Size; }
+        bool Mapped() const { return m_Storage == Storage::MAPPED; }
+    private:
+        SourceBuffer(std::string path);
+
+        void Unmap();
+        bool Map(int descriptor, size_t size);
+        bool ReadAll(int descriptor);
+    };
+} // namespace Aesthetic
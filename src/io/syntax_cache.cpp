@@ -0,0 +1,270 @@
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "syntax_cache.hpp"
+#include "util/interner.hpp"
+
+namespace Aesthetic
+{
+    static constexpr uint32_t s_ByteOrder = 0x01020304U;
+
+    static constexpr size_t IndexOf(CacheSection section)
+    {
+        return static_cast<size_t>(section);
+    }
+
+    static bool IsList(NodeKind kind)
+    {
+        return kind == NodeKind::PROGRAM || kind == NodeKind::BLOCK || kind == NodeKind::CALL
+            || kind == NodeKind::LIST || kind == NodeKind::TUPLE;
+    }
+
+    // Everything is written, a short write means the disk is full
+    static bool WriteAll(int descriptor, std::string_view data)
+    {
+        while (!data.empty())
+        {
+            const ssize_t written = ::write(descriptor, data.data(), data.size());
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+                return false;
+            data.remove_prefix(static_cast<size_t>(written));
+        }
+        return true;
+    }
+
+    std::optional<SyntaxCache> SyntaxCache::Open(const std::string& path, uint64_t build, std::string_view source)
+    {
+        std::optional<SourceBuffer> file = SourceBuffer::Open(path);
+        if (!file || file->Size() < sizeof(CacheHeader))
+            return std::nullopt;
+
+        SyntaxCache cache(std::move(file.value()));
+        const CacheHeader& header = cache.Header();
+        const uint64_t size = cache.m_File.Size();
+
+        if (header.magic != s_Magic || header.version != s_Version || header.byteOrder != s_ByteOrder)
+            return std::nullopt;
+        if (header.build != build || header.fileSize != size || header.sourceSize != source.size())
+            return std::nullopt;
+        if (header.sourceHash != Interner::Hash(source))
+            return std::nullopt;
+
+        // How many bytes each section has to hold, the names are whatever the starts say
+        const uint64_t tokens = header.tokens;
+        const uint64_t nodes = header.nodes;
+        const std::array<uint64_t, IndexOf(CacheSection::COUNT)> expected = {
+            tokens * sizeof(TokenKind), tokens, tokens, tokens * 4UL, tokens * 4UL, tokens * 8UL,
+            (header.symbols + 1UL) * 4UL, 0UL,
+            nodes * sizeof(NodeKind), nodes * 4UL, nodes * 4UL, nodes * 4UL, header.children * 4UL
+        };
+
+        for (size_t i = 0UL; i < expected.size(); i++)
+        {
+            const CacheHeader::Range& range = header.sections[i];
+            if (range.offset % 8UL || range.offset < sizeof(CacheHeader) || range.offset > size || range.size > size - range.offset)
+                return std::nullopt;
+            if (i != IndexOf(CacheSection::SYMBOL_NAMES) && range.size != expected[i])
+                return std::nullopt;
+        }
+
+        const std::string_view body = cache.m_File.View().substr(sizeof(CacheHeader));
+        if (header.checksum != Interner::Hash(body) || !cache.Consistent())
+            return std::nullopt;
+
+        return cache;
+    }
+
+    bool SyntaxCache::Write(const std::string& path, uint64_t build, std::string_view source,
+                            const TokenStream& tokens, const Ast& ast)
+    {
+        const TokenArrays arrays = tokens.Arrays();
+        Interner& interner = Interner::Global();
+
+        // Symbols are numbered in order of first appearance, which is the
+        // order a fresh lexer would intern them in
+        std::vector<uint32_t> indexOf(interner.Size(), UINT32_MAX);
+        std::vector<uint64_t> payloads(arrays.payloads.begin(), arrays.payloads.end());
+        std::vector<uint32_t> starts{ 0U };
+        std::string names;
+
+        for (size_t i = 0UL; i < payloads.size(); i++)
+        {
+            if (arrays.kinds[i] != TokenKind::SYMBOL)
+                continue;
+
+            const SymbolId symbol = static_cast<SymbolId>(payloads[i]);
+            if (indexOf[symbol] == UINT32_MAX)
+            {
+                indexOf[symbol] = static_cast<uint32_t>(starts.size() - 1UL);
+                names += interner.Name(symbol);
+                starts.push_back(static_cast<uint32_t>(names.size()));
+            }
+            payloads[i] = indexOf[symbol];
+        }
+
+        const AstArrays tree = ast.Arrays();
+        CacheHeader header{};
+        header.magic = s_Magic;
+        header.version = s_Version;
+        header.byteOrder = s_ByteOrder;
+        header.build = build;
+        header.sourceHash = Interner::Hash(source);
+        header.sourceSize = source.size();
+        header.tokens = static_cast<uint32_t>(arrays.kinds.size());
+        header.symbols = static_cast<uint32_t>(starts.size() - 1UL);
+        header.nodes = static_cast<uint32_t>(tree.kinds.size());
+        header.children = static_cast<uint32_t>(tree.children.size());
+        header.root = tree.root;
+
+        std::string file(sizeof(CacheHeader), '\0');
+        const auto append = [&file, &header](CacheSection section, const auto& items)
+        {
+            file.resize((file.size() + 7UL) & ~7UL, '\0');
+            const size_t bytes = items.size() * sizeof(items[0]);
+            header.sections[IndexOf(section)] = CacheHeader::Range{ file.size(), bytes };
+            file.append(reinterpret_cast<const char*>(items.data()), bytes);
+        };
+
+        append(CacheSection::TOKEN_KINDS, arrays.kinds);
+        append(CacheSection::TOKEN_SUBTYPES, arrays.subtypes);
+        append(CacheSection::TOKEN_FLAGS, arrays.flags);
+        append(CacheSection::TOKEN_OFFSETS, arrays.offsets);
+        append(CacheSection::TOKEN_LENGTHS, arrays.lengths);
+        append(CacheSection::TOKEN_PAYLOADS, payloads);
+        append(CacheSection::SYMBOL_STARTS, starts);
+        append(CacheSection::SYMBOL_NAMES, names);
+        append(CacheSection::NODE_KINDS, tree.kinds);
+        append(CacheSection::NODE_TOKENS, tree.tokens);
+        append(CacheSection::NODE_LHS, tree.lhs);
+        append(CacheSection::NODE_RHS, tree.rhs);
+        append(CacheSection::NODE_CHILDREN, tree.children);
+
+        header.fileSize = file.size();
+        header.checksum = Interner::Hash(std::string_view(file).substr(sizeof(CacheHeader)));
+        std::memcpy(file.data(), &header, sizeof(CacheHeader));
+
+        // Unique per process, concurrent writers each rename a whole file
+        const std::string temporary = path + ".tmp" + std::to_string(::getpid());
+        const int descriptor = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (descriptor < 0)
+            return false;
+
+        const bool written = WriteAll(descriptor, file);
+        int error = errno;
+        if (::close(descriptor) < 0 && written)
+            error = errno;
+        else if (written && ::rename(temporary.c_str(), path.c_str()) == 0)
+            return true;
+        else if (written)
+            error = errno;
+
+        ::unlink(temporary.c_str());
+        errno = error;
+        return false;
+    }
+
+    void SyntaxCache::Load(TokenStream& tokens, Ast& ast) const
+    {
+        const CacheHeader& header = Header();
+        const std::span<const uint32_t> starts = Section<uint32_t>(CacheSection::SYMBOL_STARTS);
+        const std::span<const char> names = Section<char>(CacheSection::SYMBOL_NAMES);
+
+        std::vector<SymbolId> symbols(header.symbols);
+        for (size_t i = 0UL; i < symbols.size(); i++)
+            symbols[i] = Interner::Global().Intern(std::string_view(names.data() + starts[i], starts[i + 1UL] - starts[i]));
+
+        tokens.Assign(TokenData());
+        tokens.ResolveSymbols(symbols);
+        ast.Assign(AstData());
+    }
+
+    template<typename T>
+    std::span<const T> SyntaxCache::Section(CacheSection section) const
+    {
+        const CacheHeader::Range& range = Header().sections[IndexOf(section)];
+        return std::span<const T>(reinterpret_cast<const T*>(m_File.View().data() + range.offset), range.size / sizeof(T));
+    }
+
+    TokenArrays SyntaxCache::TokenData() const
+    {
+        return TokenArrays{
+            Section<TokenKind>(CacheSection::TOKEN_KINDS),
+            Section<uint8_t>(CacheSection::TOKEN_SUBTYPES),
+            Section<uint8_t>(CacheSection::TOKEN_FLAGS),
+            Section<uint32_t>(CacheSection::TOKEN_OFFSETS),
+            Section<uint32_t>(CacheSection::TOKEN_LENGTHS),
+            Section<uint64_t>(CacheSection::TOKEN_PAYLOADS),
+        };
+    }
+
+    AstArrays SyntaxCache::AstData() const
+    {
+        return AstArrays{
+            Section<NodeKind>(CacheSection::NODE_KINDS),
+            Section<uint32_t>(CacheSection::NODE_TOKENS),
+            Section<NodeId>(CacheSection::NODE_LHS),
+            Section<NodeId>(CacheSection::NODE_RHS),
+            Section<NodeId>(CacheSection::NODE_CHILDREN),
+            Header().root,
+        };
+    }
+
+    bool SyntaxCache::Consistent() const
+    {
+        const CacheHeader& header = Header();
+        const TokenArrays tokens = TokenData();
+        const AstArrays tree = AstData();
+        const std::span<const uint32_t> starts = Section<uint32_t>(CacheSection::SYMBOL_STARTS);
+
+        for (size_t i = 0UL; i < tokens.kinds.size(); i++)
+        {
+            if (static_cast<uint8_t>(tokens.kinds[i]) > static_cast<uint8_t>(TokenKind::INTEGER))
+                return false;
+            if (static_cast<uint64_t>(tokens.offsets[i]) + tokens.lengths[i] > header.sourceSize)
+                return false;
+            if (tokens.kinds[i] == TokenKind::SYMBOL && tokens.payloads[i] >= header.symbols)
+                return false;
+        }
+
+        if (starts.front() != 0U || starts.back() != Section<char>(CacheSection::SYMBOL_NAMES).size())
+            return false;
+        for (size_t i = 1UL; i < starts.size(); i++)
+            if (starts[i] < starts[i - 1UL])
+                return false;
+
+        // Children come before their parents, so no index can make a cycle
+        for (NodeId node = 0U; node < tree.kinds.size(); node++)
+        {
+            const NodeKind kind = tree.kinds[node];
+            if (static_cast<uint8_t>(kind) > static_cast<uint8_t>(NodeKind::STRING) || tree.tokens[node] >= header.tokens)
+                return false;
+
+            const bool named = kind == NodeKind::NAME || kind == NodeKind::EVENT || kind == NodeKind::MEMBER;
+            if (named && tokens.kinds[tree.tokens[node]] != TokenKind::SYMBOL)
+                return false;
+
+            if (IsList(kind))
+            {
+                if (tree.lhs[node] > tree.children.size() || tree.rhs[node] > tree.children.size() - tree.lhs[node])
+                    return false;
+                for (const NodeId child : tree.children.subspan(tree.lhs[node], tree.rhs[node]))
+                    if (child >= node)
+                        return false;
+            }
+            else
+            {
+                for (const NodeId child : { tree.lhs[node], tree.rhs[node] })
+                    if (child != Ast::s_NoNode && child >= node)
+                        return false;
+            }
+        }
+
+        return tree.root == Ast::s_NoNode || tree.root < tree.kinds.size();
+    }
+} // namespace Aesthetic
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "source_buffer.hpp"
+#include "lexer/token_stream.hpp"
+#include "parser/ast.hpp"
+
+namespace Aesthetic
+{
+    // Arrays stored in a cache file, in file order
+    enum class CacheSection : uint32_t
+    {
+        TOKEN_KINDS    = 0U,
+        TOKEN_SUBTYPES = 1U,
+        TOKEN_FLAGS    = 2U,
+        TOKEN_OFFSETS  = 3U,
+        TOKEN_LENGTHS  = 4U,
+        // Symbols hold an index into the symbol table instead of an ID,
+        // IDs are only valid within one process
+        TOKEN_PAYLOADS = 5U,
+        // Where every name starts in SYMBOL_NAMES, one past the last too
+        SYMBOL_STARTS  = 6U,
+        SYMBOL_NAMES   = 7U,
+        NODE_KINDS     = 8U,
+        NODE_TOKENS    = 9U,
+        NODE_LHS       = 10U,
+        NODE_RHS       = 11U,
+        NODE_CHILDREN  = 12U,
+        COUNT          = 13U,
+    };
+
+    // Start of a cache file, in the byte order of the machine that wrote it
+    struct CacheHeader
+    {
+        struct Range
+        {
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        std::array<char, 8UL> magic;
+        uint32_t version;
+        // 0x01020304 as written, caches of the other byte order are stale
+        uint32_t byteOrder;
+        uint64_t build;
+        uint64_t sourceHash;
+        uint64_t sourceSize;
+        uint64_t fileSize;
+        // Hash of everything after the header
+        uint64_t checksum;
+        uint32_t tokens;
+        uint32_t symbols;
+        uint32_t nodes;
+        uint32_t children;
+        NodeId root;
+        uint32_t reserved;
+        // In bytes from the start of the file, every section is 8-aligned
+        std::array<Range, static_cast<size_t>(CacheSection::COUNT)> sections;
+    };
+
+    // A lexed and parsed program on disk, so runs over unchanged text skip
+    // the Lexer and the Parser. The file is the header followed by the
+    // arrays of the TokenStream and the Ast exactly as they are in memory,
+    // addressed by offset. It is memory-mapped and only checked, never
+    // decoded: loading copies each array in one go and turns symbol indices
+    // into IDs.
+    //
+    // A cache is stale unless it was written by the same build for text
+    // with the same hash and size. Anything wrong with it, from a cut off
+    // file to an index out of range, makes it count as missing, so the
+    // caller lexes again and overwrites it.
+    class SyntaxCache
+    {
+    public:
+        static constexpr std::array<char, 8UL> s_Magic = { 'A', 'E', 'S', 'Y', 'N', 'T', 'A', 'X' };
+        static constexpr uint32_t s_Version = 1U;
+    private:
+        SourceBuffer m_File;
+    public:
+        // Nothing if there is no intact cache of `source` from `build` at `path`
+        static std::optional<SyntaxCache> Open(const std::string& path, uint64_t build, std::string_view source);
+        // Writes a temporary file and renames it over `path`, so readers
+        // never see half a cache. False with errno set if that failed.
+        static bool Write(const std::string& path, uint64_t build, std::string_view source,
+                          const TokenStream& tokens, const Ast& ast);
+
+        size_t Tokens() const { return Header().tokens; }
+        size_t Nodes() const { return Header().nodes; }
+
+        // Replaces the contents of `tokens` and `ast` with the cached ones,
+        // interning the symbols. `tokens` has to view the cached source.
+        void Load(TokenStream& tokens, Ast& ast) const;
+    private:
+        explicit SyntaxCache(SourceBuffer file) : m_File(std::move(file)) {}
+
+        // Looked up every time, the buffer of a small file read from a pipe moves with it
+        const CacheHeader& Header() const { return *reinterpret_cast<const CacheHeader*>(m_File.View().data()); }
+
+        template<typename T>
+        std::span<const T> Section(CacheSection section) const;
+        TokenArrays TokenData() const;
+        AstArrays AstData() const;
+
+        // Whether every index points where it may
+        bool Consistent() const;
+    };
+} // namespace Aesthetic
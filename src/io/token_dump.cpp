@@ -0,0 +1,275 @@
+#include <cstring>
+
+#include "token_dump.hpp"
+#include "lexer/kernels.hpp"
+
+namespace Aesthetic
+{
+    static constexpr std::array<std::string_view, 9UL> s_TextNames = {
+        "BasicToken", "EOFToken", "OperatorToken", "KeywordToken", "PunctuationToken",
+        "SymbolToken", "StringToken", "FloatingPointToken", "IntegerToken"
+    };
+
+    static constexpr std::array<std::string_view, 9UL> s_JsonNames = {
+        "invalid", "eof", "operator", "keyword", "punctuation", "symbol", "string", "float", "integer"
+    };
+
+    static constexpr std::array<std::string_view, 4UL> s_TextLiterals = { "0x", "0o", "0b", "dec" };
+    static constexpr std::array<std::string_view, 4UL> s_JsonLiterals = { "hex", "oct", "bin", "dec" };
+
+    static constexpr char s_HexDigits[] = "0123456789abcdef";
+
+    static_assert(sizeof(TokenDumpHeader) == 32UL && sizeof(TokenRecord) == 32UL, "records are written as they are");
+
+    TokenDumper::TokenDumper(OutputBuffer& out, DumpFormat format)
+        : m_Out(out), m_Format(format), m_Line(1UL), m_Offset(0UL), m_Column(1UL) {}
+
+    std::optional<DumpFormat> TokenDumper::ParseFormat(std::string_view name)
+    {
+        if (name == "text")
+            return DumpFormat::TEXT;
+        if (name == "json")
+            return DumpFormat::JSON_LINES;
+        if (name == "binary")
+            return DumpFormat::BINARY;
+        return std::nullopt;
+    }
+
+    void TokenDumper::Dump(const TokenStream& tokens)
+    {
+        const LineIndex& index = tokens.Index();
+        m_Line = 1UL;
+        m_Offset = 0UL;
+        m_Column = 1UL;
+
+        if (m_Format == DumpFormat::BINARY)
+        {
+            const TokenDumpHeader header = {
+                s_Magic, s_Version, 0x01020304U, static_cast<uint32_t>(sizeof(TokenRecord)), 0U, tokens.Size()
+            };
+            m_Out.Append(std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+        }
+
+        for (size_t i = 0UL; i < tokens.Size(); i++)
+        {
+            const Position pos = Locate(index, tokens.Source(), tokens.Offset(i));
+            switch (m_Format)
+            {
+            case DumpFormat::TEXT:
+                Text(tokens, i, pos);
+                break;
+            case DumpFormat::JSON_LINES:
+                Json(tokens, i, pos);
+                break;
+            case DumpFormat::BINARY:
+                Binary(tokens, i, pos);
+                break;
+            }
+        }
+    }
+
+    Position TokenDumper::Locate(const LineIndex& index, std::string_view source, uint32_t offset)
+    {
+        if (offset < m_Offset)
+            return index.Locate(source, offset);
+
+        const size_t line = m_Line;
+        while (m_Line < index.Lines() && index.LineStart(m_Line + 1UL) <= offset)
+            m_Line++;
+
+        // Code points are counted from the last token on the same line,
+        // from the start of the line otherwise
+        if (m_Line != line)
+        {
+            m_Offset = index.LineStart(m_Line);
+            m_Column = 1UL;
+        }
+        m_Column += CountCodePoints(source.substr(m_Offset, offset - m_Offset));
+        m_Offset = offset;
+        return Position(m_Line, m_Column);
+    }
+
+    void TokenDumper::Text(const TokenStream& tokens, size_t token, Position pos)
+    {
+        const TokenKind kind = tokens.Kind(token);
+        const uint8_t subtype = tokens.Subtype(token);
+        const std::string_view text = tokens.Text(token);
+
+        // What the BasicToken constructors make of the validity and extent
+        bool valid = true;
+        Position length(0UL, tokens.Length(token));
+        switch (kind)
+        {
+        case TokenKind::INVALID:
+            valid = false;
+            length.col = 0UL;
+            break;
+        case TokenKind::END_OF_FILE:
+            length.col = 0UL;
+            break;
+        case TokenKind::PUNCTUATION:
+            length.line = static_cast<PunctuationType>(subtype) == PunctuationType::LINE_END;
+            break;
+        case TokenKind::SYMBOL:
+            length = Position(text);
+            break;
+        case TokenKind::STRING:
+        case TokenKind::FLOATING_POINT:
+        case TokenKind::INTEGER:
+            valid = tokens.Valid(token);
+            length = Position(text);
+            break;
+        default:
+            break;
+        }
+
+        m_Out.Append(s_TextNames[static_cast<size_t>(kind)]);
+        m_Out.Append('[');
+        Pos(pos);
+        m_Out.Append('-');
+        Pos(length);
+        m_Out.Append(valid ? "](valid)" : "](invalid)");
+
+        switch (kind)
+        {
+        case TokenKind::OPERATOR:
+        case TokenKind::KEYWORD:
+        case TokenKind::SYMBOL:
+            m_Out.Append(" `");
+            m_Out.Append(text);
+            m_Out.Append('`');
+            break;
+        case TokenKind::PUNCTUATION:
+            m_Out.Append(" `");
+            m_Out.Append(text == "\n" ? "\\n" : text);
+            m_Out.Append('`');
+            break;
+        case TokenKind::STRING:
+            m_Out.Append(" contents: `");
+            m_Out.Append(text);
+            m_Out.Append("` of length ");
+            m_Out.Unsigned(tokens[token].StringContents().size());
+            break;
+        case TokenKind::FLOATING_POINT:
+        case TokenKind::INTEGER:
+            m_Out.Append(" contents: `");
+            m_Out.Append(text);
+            m_Out.Append("` literal `");
+            m_Out.Append(s_TextLiterals[subtype]);
+            m_Out.Append("` value ");
+            if (kind == TokenKind::INTEGER)
+                m_Out.Unsigned(tokens.Payload(token));
+            else
+                m_Out.Double(tokens[token].FloatingPoint(), 6);
+            break;
+        default:
+            break;
+        }
+        m_Out.Append('\n');
+    }
+
+    void TokenDumper::Json(const TokenStream& tokens, size_t token, Position pos)
+    {
+        const TokenKind kind = tokens.Kind(token);
+
+        m_Out.Append("{\"kind\":\"");
+        m_Out.Append(s_JsonNames[static_cast<size_t>(kind)]);
+        m_Out.Append("\",\"offset\":");
+        m_Out.Unsigned(tokens.Offset(token));
+        m_Out.Append(",\"length\":");
+        m_Out.Unsigned(tokens.Length(token));
+        m_Out.Append(",\"line\":");
+        m_Out.Unsigned(pos.line);
+        m_Out.Append(",\"col\":");
+        m_Out.Unsigned(pos.col);
+        m_Out.Append(tokens.Valid(token) ? ",\"valid\":true,\"text\":" : ",\"valid\":false,\"text\":");
+        JsonString(tokens.Text(token));
+
+        // Invalid numbers have no value, floating points that overflowed included
+        if (kind == TokenKind::INTEGER || kind == TokenKind::FLOATING_POINT)
+        {
+            m_Out.Append(",\"literal\":\"");
+            m_Out.Append(s_JsonLiterals[tokens.Subtype(token)]);
+            m_Out.Append('"');
+
+            if (tokens.Valid(token))
+            {
+                m_Out.Append(",\"value\":");
+                if (kind == TokenKind::INTEGER)
+                    m_Out.Unsigned(tokens.Payload(token));
+                else
+                    m_Out.Double(tokens[token].FloatingPoint());
+            }
+        }
+
+        // The value of strings only differs from their text with escapes
+        if (kind == TokenKind::STRING && tokens.Valid(token)
+            && static_cast<StringLiteralType>(tokens.Subtype(token)) == StringLiteralType::ESCAPED)
+        {
+            m_Out.Append(",\"value\":");
+            JsonString(tokens.StringValue(token));
+        }
+        m_Out.Append("}\n");
+    }
+
+    void TokenDumper::Binary(const TokenStream& tokens, size_t token, Position pos)
+    {
+        const TokenKind kind = tokens.Kind(token);
+        const bool number = kind == TokenKind::INTEGER || kind == TokenKind::FLOATING_POINT;
+
+        TokenRecord record{};
+        record.offset = tokens.Offset(token);
+        record.length = tokens.Length(token);
+        record.line = static_cast<uint32_t>(pos.line);
+        record.col = static_cast<uint32_t>(pos.col);
+        record.payload = number ? tokens.Payload(token) : 0U;
+        record.kind = kind;
+        record.subtype = tokens.Subtype(token);
+        record.valid = tokens.Valid(token);
+
+        std::memcpy(m_Out.Claim(sizeof(record)), &record, sizeof(record));
+        m_Out.Commit(sizeof(record));
+    }
+
+    void TokenDumper::Pos(Position pos)
+    {
+        m_Out.Unsigned(pos.line);
+        m_Out.Append(':');
+        m_Out.Unsigned(pos.col);
+    }
+
+    void TokenDumper::JsonString(std::string_view text)
+    {
+        m_Out.Append('"');
+
+        // Runs that need no escaping are copied in one go. Bytes above
+        // ASCII go out as they are, invalid UTF-8 included.
+        size_t run = 0UL;
+        for (size_t i = 0UL; i < text.size(); i++)
+        {
+            const unsigned char sym = static_cast<unsigned char>(text[i]);
+            if (sym >= 0x20U && sym != '"' && sym != '\\')
+                continue;
+
+            m_Out.Append(text.substr(run, i - run));
+            run = i + 1UL;
+
+            switch (sym)
+            {
+            case '"':  m_Out.Append("\\\""); break;
+            case '\\': m_Out.Append("\\\\"); break;
+            case '\n': m_Out.Append("\\n"); break;
+            case '\r': m_Out.Append("\\r"); break;
+            case '\t': m_Out.Append("\\t"); break;
+            default:
+                m_Out.Append("\\u00");
+                m_Out.Append(s_HexDigits[sym >> 4U]);
+                m_Out.Append(s_HexDigits[sym & 0xFU]);
+                break;
+            }
+        }
+
+        m_Out.Append(text.substr(run));
+        m_Out.Append('"');
+    }
+} // namespace Aesthetic
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "output_buffer.hpp"
+#include "lexer/token_stream.hpp"
+
+namespace Aesthetic
+{
+    enum class DumpFormat : uint8_t
+    {
+        // One line per token, the same as printing its BasicToken
+        TEXT        = 0U,
+        // One JSON object per line
+        JSON_LINES  = 1U,
+        // TokenDumpHeader and then one TokenRecord per token
+        BINARY      = 2U,
+    };
+
+    // Start of a binary dump, in the byte order of the machine that wrote it
+    struct TokenDumpHeader
+    {
+        std::array<char, 8UL> magic;
+        uint32_t version;
+        // 0x01020304 as written
+        uint32_t byteOrder;
+        uint32_t recordSize;
+        uint32_t reserved;
+        uint64_t tokens;
+    };
+
+    struct TokenRecord
+    {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t line;
+        uint32_t col;
+        // Value of integers and bits of floating points. Symbol IDs only
+        // mean something inside one process, their names are at `offset`.
+        uint64_t payload;
+        TokenKind kind;
+        uint8_t subtype;
+        uint8_t valid;
+        std::array<uint8_t, 5UL> reserved;
+    };
+
+    // Writes the tokens of a stream out in one of the DumpFormats, straight
+    // from its arrays into an OutputBuffer, without materializing tokens.
+    class TokenDumper
+    {
+    public:
+        static constexpr std::array<char, 8UL> s_Magic = { 'A', 'E', 'T', 'O', 'K', 'E', 'N', 'S' };
+        static constexpr uint32_t s_Version = 1U;
+    private:
+        OutputBuffer& m_Out;
+        DumpFormat m_Format;
+        // Line of the last token, tokens come in text order so lines are
+        // found by walking forward rather than by searching
+        size_t m_Line;
+        // Byte offset and column of the last token, for counting code points
+        size_t m_Offset;
+        size_t m_Column;
+    public:
+        TokenDumper(OutputBuffer& out, DumpFormat format);
+
+        static std::optional<DumpFormat> ParseFormat(std::string_view name);
+
+        void Dump(const TokenStream& tokens);
+    private:
+        Position Locate(const LineIndex& index, std::string_view source, uint32_t offset);
+
+        void Text(const TokenStream& tokens, size_t token, Position pos);
+        void Json(const TokenStream& tokens, size_t token, Position pos);
+        void Binary(const TokenStream& tokens, size_t token, Position pos);
+
+        void Pos(Position pos);
+        void JsonString(std::string_view text);
+    };
+} // namespace Aesthetic
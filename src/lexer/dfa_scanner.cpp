@@ -0,0 +1,360 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#include "dfa_scanner.hpp"
+#include "scanner.hpp"
+#include "util/interner.hpp"
+
+namespace Aesthetic
+{
+    // What the token is when the DFA stops in a state
+    enum class DfaAction : uint8_t
+    {
+        // Nothing matched, an invalid token of no length
+        REJECT         = 0U,
+        // A token with nothing to decode
+        TOKEN          = 1U,
+        SYMBOL         = 2U,
+        INTEGER        = 3U,
+        FLOATING_POINT = 4U,
+        // Up to ScanLexeme()
+        DEFER          = 5U,
+    };
+
+    struct DfaAccept
+    {
+        DfaAction action = DfaAction::REJECT;
+        TokenKind kind = TokenKind::INVALID;
+        uint8_t subtype = 0U;
+        bool valid = false;
+        // Bytes consumed past the end of the token, inside an operator that
+        // never completed or a UTF-8 sequence that turned out invalid
+        uint8_t back = 0U;
+    };
+
+    template<size_t Capacity>
+    struct DfaTable
+    {
+        // Zero is the dead state, there is no transition
+        std::array<std::array<uint8_t, 256UL>, Capacity> next{};
+        std::array<DfaAccept, Capacity> accept{};
+        size_t states = 0UL;
+    };
+
+    // Continuation bytes that may follow a group of UTF-8 lead bytes. The
+    // second byte is narrower after E0, ED, F0 and F4, which rules out
+    // overlong forms, surrogates and values past U+10FFFF.
+    struct Utf8Lead
+    {
+        uint8_t first;
+        uint8_t last;
+        uint8_t length;
+        uint8_t low;
+        uint8_t high;
+    };
+
+    static constexpr std::array<Utf8Lead, 8UL> s_Utf8Leads = { {
+        { 0xC2U, 0xDFU, 2U, 0x80U, 0xBFU },
+        { 0xE0U, 0xE0U, 3U, 0xA0U, 0xBFU },
+        { 0xE1U, 0xECU, 3U, 0x80U, 0xBFU },
+        { 0xEDU, 0xEDU, 3U, 0x80U, 0x9FU },
+        { 0xEEU, 0xEFU, 3U, 0x80U, 0xBFU },
+        { 0xF0U, 0xF0U, 4U, 0x90U, 0xBFU },
+        { 0xF1U, 0xF3U, 4U, 0x80U, 0xBFU },
+        { 0xF4U, 0xF4U, 4U, 0x80U, 0x8FU },
+    } };
+
+    template<size_t Capacity>
+    class DfaBuilder
+    {
+    public:
+        static constexpr uint8_t s_Dead = 0U;
+        static constexpr uint8_t s_Start = 1U;
+    private:
+        DfaTable<Capacity> m_Table;
+        // Trie nodes inside a representation take the accept of their parent
+        std::array<uint8_t, Capacity> m_Parent{};
+        std::array<bool, Capacity> m_Inherits{};
+    public:
+        constexpr DfaTable<Capacity> Build()
+        {
+            Add(DfaAccept{});
+            Add(DfaAccept{});
+
+            // In the priority order of ScanLexeme(), a node keeps the token
+            // of the first table that ends there
+            AddTrie<OperatorToken::representations>(TokenKind::OPERATOR, true);
+            AddTrie<PunctuationToken::representations>(TokenKind::PUNCTUATION, true);
+            const uint8_t keywords = static_cast<uint8_t>(m_Table.states);
+            AddTrie<KeywordToken::representations>(TokenKind::KEYWORD, false);
+            const uint8_t keywordsEnd = static_cast<uint8_t>(m_Table.states);
+            Inherit();
+
+            AddSymbols(keywords, keywordsEnd);
+            AddNumbers();
+            AddStrings();
+            return m_Table;
+        }
+    private:
+        constexpr uint8_t Add(DfaAccept accept)
+        {
+            m_Table.accept[m_Table.states] = accept;
+            return static_cast<uint8_t>(m_Table.states++);
+        }
+
+        static constexpr DfaAccept Token(TokenKind kind, uint8_t subtype, bool valid = true, uint8_t back = 0U)
+        {
+            return DfaAccept{ DfaAction::TOKEN, kind, subtype, valid, back };
+        }
+
+        constexpr void Link(uint8_t from, uint8_t to, uint8_t first, uint8_t last)
+        {
+            for (size_t sym = first; sym <= last; sym++)
+                m_Table.next[from][sym] = to;
+        }
+
+        template<typename Predicate>
+        constexpr void LinkIf(uint8_t from, uint8_t to, Predicate predicate)
+        {
+            for (size_t sym = 0UL; sym < 256UL; sym++)
+                if (predicate(static_cast<char>(sym)))
+                    m_Table.next[from][sym] = to;
+        }
+
+        // Keywords stand for a symbol until they are complete, the rest
+        // inherits, so a node inside "::=" is a ':' that went too far
+        template<const auto& Representations>
+        constexpr void AddTrie(TokenKind kind, bool inherits)
+        {
+            for (size_t i = 0UL; i < Representations.size(); i++)
+            {
+                uint8_t node = s_Start;
+                for (char sym : Representations[i])
+                {
+                    uint8_t& next = m_Table.next[node][static_cast<uint8_t>(sym)];
+                    if (next == s_Dead)
+                    {
+                        next = Add(inherits ? DfaAccept{} : DfaAccept{ DfaAction::SYMBOL, TokenKind::SYMBOL });
+                        m_Parent[next] = node;
+                        m_Inherits[next] = inherits;
+                    }
+                    node = next;
+                }
+
+                if (m_Table.accept[node].action != DfaAction::TOKEN)
+                {
+                    m_Table.accept[node] = Token(kind, static_cast<uint8_t>(i));
+                    m_Inherits[node] = false;
+                }
+            }
+        }
+
+        // Parents are added before their children
+        constexpr void Inherit()
+        {
+            for (size_t state = s_Start + 1UL; state < m_Table.states; state++)
+            {
+                if (!m_Inherits[state])
+                    continue;
+
+                DfaAccept accept = m_Table.accept[m_Parent[state]];
+                if (accept.action != DfaAction::REJECT)
+                    accept.back++;
+                m_Table.accept[state] = accept;
+            }
+        }
+
+        // Names and whatever of a keyword turns out to be a name. A byte
+        // from 0x80 on may be XID_Start or XID_Continue, which is left to
+        // the scanners.
+        constexpr void AddSymbols(uint8_t keywords, uint8_t keywordsEnd)
+        {
+            const uint8_t symbol = Add(DfaAccept{ DfaAction::SYMBOL, TokenKind::SYMBOL });
+            const uint8_t defer = Add(DfaAccept{ DfaAction::DEFER });
+
+            for (uint8_t state : { s_Start, symbol })
+                Link(state, defer, 0x80U, 0xFFU);
+            for (uint8_t state = keywords; state < keywordsEnd; state++)
+                Link(state, defer, 0x80U, 0xFFU);
+
+            for (size_t sym = 0UL; sym < 0x80UL; sym++)
+            {
+                if (SymbolToken::StartSymbolic(static_cast<char>(sym)) && m_Table.next[s_Start][sym] == s_Dead)
+                    m_Table.next[s_Start][sym] = symbol;
+                if (!SymbolToken::Symbolic(static_cast<char>(sym)))
+                    continue;
+
+                m_Table.next[symbol][sym] = symbol;
+                for (uint8_t state = keywords; state < keywordsEnd; state++)
+                    if (m_Table.next[state][sym] == s_Dead)
+                        m_Table.next[state][sym] = symbol;
+            }
+        }
+
+        // Digits up to a '.' and digits after it, a 0x, 0o or 0b prefix
+        // picks the base. A prefix without digits is an invalid integer
+        // that takes one more byte, whatever it is.
+        constexpr void AddNumbers()
+        {
+            constexpr NumberLiteralType s_Prefixed[] = { NumberLiteralType::HEX, NumberLiteralType::OCT, NumberLiteralType::BIN };
+            constexpr char s_Prefixes[] = { 'x', 'o', 'b' };
+
+            const auto add = [this](NumberLiteralType type, uint8_t& integer, uint8_t& fraction) {
+                const uint8_t subtype = static_cast<uint8_t>(type);
+                integer = Add(DfaAccept{ DfaAction::INTEGER, TokenKind::INTEGER, subtype });
+                fraction = Add(DfaAccept{ DfaAction::FLOATING_POINT, TokenKind::FLOATING_POINT, subtype });
+
+                const auto digit = [type](char sym) { return NumberToken::IsDigit(sym, type); };
+                LinkIf(integer, integer, digit);
+                LinkIf(fraction, fraction, digit);
+                m_Table.next[integer]['.'] = fraction;
+            };
+
+            uint8_t integer = s_Dead;
+            uint8_t fraction = s_Dead;
+            add(NumberLiteralType::DEC, integer, fraction);
+
+            // '.' is punctuation unless a digit follows
+            const uint8_t dot = m_Table.next[s_Start]['.'];
+            LinkIf(dot, fraction, [](char sym) { return NumberToken::IsDigit(sym, NumberLiteralType::DEC); });
+            Link(s_Start, integer, '1', '9');
+
+            const uint8_t zero = Add(m_Table.accept[integer]);
+            m_Table.next[s_Start]['0'] = zero;
+            m_Table.next[zero] = m_Table.next[integer];
+
+            for (size_t i = 0UL; i < 3UL; i++)
+            {
+                const uint8_t subtype = static_cast<uint8_t>(s_Prefixed[i]);
+                const uint8_t prefix = Add(Token(TokenKind::INTEGER, subtype, false));
+                const uint8_t invalid = Add(Token(TokenKind::INTEGER, subtype, false));
+                m_Table.next[zero][static_cast<uint8_t>(s_Prefixes[i])] = prefix;
+
+                add(s_Prefixed[i], integer, fraction);
+                Link(prefix, invalid, 0x00U, 0xFFU);
+                LinkIf(prefix, integer, [type = s_Prefixed[i]](char sym) { return NumberToken::IsDigit(sym, type); });
+                m_Table.next[prefix]['.'] = fraction;
+            }
+        }
+
+        // A family of body states per StringLiteralType, the first escape
+        // moves to the ESCAPED family. A state inside a UTF-8 sequence
+        // stands for an invalid string that ends where the sequence began.
+        constexpr void AddStrings()
+        {
+            const uint8_t escape = Add(Token(TokenKind::STRING, static_cast<uint8_t>(StringLiteralType::ESCAPED), false));
+            const uint8_t plain = AddStringBody(StringLiteralType::PLAIN, escape);
+            const uint8_t escaped = AddStringBody(StringLiteralType::ESCAPED, escape);
+
+            LinkIf(s_Start, plain, [](char sym) { return StringToken::StringBound(sym); });
+            for (char sym : StringToken::escapes)
+                m_Table.next[escape][static_cast<uint8_t>(sym)] = escaped;
+            // Scalar value ranges are up to the scanners
+            m_Table.next[escape]['u'] = Add(DfaAccept{ DfaAction::DEFER });
+        }
+
+        constexpr uint8_t AddStringBody(StringLiteralType type, uint8_t escape)
+        {
+            const uint8_t subtype = static_cast<uint8_t>(type);
+            const uint8_t body = Add(Token(TokenKind::STRING, subtype, false));
+            const uint8_t closed = Add(Token(TokenKind::STRING, subtype));
+
+            Link(body, body, 0x00U, 0x7FU);
+            LinkIf(body, closed, [](char sym) { return StringToken::StringBound(sym); });
+            m_Table.next[body]['\\'] = escape;
+
+            // Continuations still to come and bytes consumed, lead included
+            std::array<std::array<uint8_t, 4UL>, 3UL> tails{};
+            const auto tail = [&](size_t remaining, size_t consumed) {
+                if (!remaining)
+                    return body;
+                uint8_t& state = tails[remaining][consumed];
+                if (state == s_Dead)
+                    state = Add(Token(TokenKind::STRING, subtype, false, static_cast<uint8_t>(consumed)));
+                return state;
+            };
+
+            for (const Utf8Lead& lead : s_Utf8Leads)
+            {
+                const uint8_t first = Add(Token(TokenKind::STRING, subtype, false, 1U));
+                Link(body, first, lead.first, lead.last);
+                Link(first, tail(lead.length - 2UL, 2UL), lead.low, lead.high);
+            }
+            // Longest sequences first, they create the tails of shorter ones
+            for (size_t remaining = 2UL; remaining; remaining--)
+                for (size_t consumed = 2UL; consumed < 4UL; consumed++)
+                    if (tails[remaining][consumed] != s_Dead)
+                        Link(tails[remaining][consumed], tail(remaining - 1UL, consumed + 1UL), 0x80U, 0xBFU);
+
+            return body;
+        }
+    };
+
+    static constexpr size_t s_DfaStates = DfaBuilder<UINT8_MAX>().Build().states;
+    static_assert(s_DfaStates < UINT8_MAX, "the DFA has outgrown 8-bit states");
+    static constexpr DfaTable<s_DfaStates> s_Dfa = DfaBuilder<s_DfaStates>().Build();
+
+    Lexeme ScanLexemeDfa(const std::string_view& text)
+    {
+        if (text.empty())
+            return Lexeme{ TokenKind::END_OF_FILE, 0U, true, 0U };
+
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(text.data());
+        uint8_t state = DfaBuilder<s_DfaStates>::s_Start;
+        size_t i = 0UL;
+        while (i < text.size())
+        {
+            const uint8_t next = s_Dfa.next[state][bytes[i]];
+            if (next == DfaBuilder<s_DfaStates>::s_Dead)
+                break;
+            state = next;
+            i++;
+        }
+
+        const DfaAccept& accept = s_Dfa.accept[state];
+        const size_t length = i - accept.back;
+        const auto lexeme = [&accept, length](uint64_t payload = 0U, bool valid = true) {
+            return Lexeme{ accept.kind, accept.subtype, valid, static_cast<uint32_t>(length), payload };
+        };
+
+        switch (accept.action)
+        {
+        case DfaAction::REJECT:
+            break;
+        case DfaAction::TOKEN:
+            return lexeme(0U, accept.valid);
+        case DfaAction::SYMBOL:
+            return lexeme(Interner::s_NoSymbol);
+        case DfaAction::INTEGER:
+        {
+            const NumberLiteralType type = static_cast<NumberLiteralType>(accept.subtype);
+            const size_t start = type == NumberLiteralType::DEC ? 0UL : 2UL;
+            const std::optional<uint64_t> value = NumberToken::DecodeInteger(text.substr(start, length - start), type);
+            return lexeme(value.value_or(0U), value.has_value());
+        }
+        case DfaAction::FLOATING_POINT:
+        {
+            const NumberLiteralType type = static_cast<NumberLiteralType>(accept.subtype);
+            const size_t start = type == NumberLiteralType::DEC ? 0UL : 2UL;
+            const std::string_view digits = text.substr(start, length - start);
+            const std::optional<double> value = NumberToken::DecodeFloatingPoint(digits, digits.find('.'), type);
+
+            uint64_t bits = 0U;
+            if (value)
+                std::memcpy(&bits, &value.value(), sizeof(bits));
+            return lexeme(bits, value.has_value());
+        }
+        case DfaAction::DEFER:
+            return ScanLexeme(text);
+        }
+
+        return Lexeme{ TokenKind::INVALID, 0U, false, 0U };
+    }
+
+    size_t DfaStates()
+    {
+        return s_DfaStates;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "token.hpp"
+
+namespace Aesthetic
+{
+    // Recognizes the token at the very front of `text` like ScanLexeme(),
+    // in a single pass of a byte DFA. The transition table is built at
+    // compile time from the `representations` tables and the rules for
+    // symbols, numbers and strings. Every state knows what token it stands
+    // for if the next byte has no transition, so the pass never backs up.
+    //
+    // The DFA covers ASCII symbols and keywords, numbers and strings
+    // including their UTF-8 validation. Symbols running into a byte from
+    // 0x80 on and \u{...} escapes are handed to ScanLexeme(), XID classes
+    // and scalar value ranges are not worth encoding in states.
+    Lexeme ScanLexemeDfa(const std::string_view& text);
+
+    // Number of states of the generated DFA, the dead state included
+    size_t DfaStates();
+} // namespace Aesthetic
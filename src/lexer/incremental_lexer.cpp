@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "incremental_lexer.hpp"
+#include "lexer.hpp"
+#include "scanner.hpp"
+
+namespace Aesthetic
+{
+    static Lexeme LexemeOf(const TokenStream& tokens, size_t index)
+    {
+        return Lexeme{ tokens.Kind(index), tokens.Subtype(index), tokens.Valid(index), tokens.Length(index), tokens.Payload(index) };
+    }
+
+    IncrementalLexer::IncrementalLexer(std::string text, std::pmr::memory_resource* resource)
+        : m_Buffer(std::move(text)),
+          m_GapStart(m_Buffer.size()),
+          m_GapEnd(m_Buffer.size()),
+          m_Front(Lexer(SourceBuffer::Borrow(m_Buffer, "<buffer>"), resource).Lex()),
+          m_Moved(false) {}
+
+    std::string_view IncrementalLexer::Text()
+    {
+        MoveTextGap(Size());
+        return std::string_view(m_Buffer.data(), Size());
+    }
+
+    const TokenStream& IncrementalLexer::Tokens()
+    {
+        MoveTokenGap(TokenCount());
+        const std::string_view text = Text();
+        if (m_Moved)
+            m_Front.Rebind(text);
+        m_Moved = false;
+        return m_Front;
+    }
+
+    uint32_t IncrementalLexer::TokenOffset(size_t index) const
+    {
+        if (index < m_Front.Size())
+            return m_Front.Offset(index);
+        return static_cast<uint32_t>(Size()) - m_Back[TokenCount() - 1UL - index].fromEnd;
+    }
+
+    uint32_t IncrementalLexer::TokenEnd(size_t index) const
+    {
+        if (index < m_Front.Size())
+            return m_Front.Offset(index) + m_Front.Length(index);
+        return TokenOffset(index) + m_Back[TokenCount() - 1UL - index].lexeme.length;
+    }
+
+    TokenChange IncrementalLexer::Apply(const TextEdit& edit)
+    {
+        // A token depends on its own bytes and up to MaxLookahead() bytes
+        // after them: operators and punctuation look past their start, names
+        // on at a whole UTF-8 sequence. The first token whose reach touches
+        // the edit is where re-lexing starts.
+        auto reach = [this](size_t i) {
+            return TokenEnd(i) + MaxLookahead();
+        };
+
+        const size_t count = TokenCount();
+        size_t first = 0UL;
+        for (size_t step = count; step; step /= 2)
+            while (first + step <= count && reach(first + step - 1) <= edit.offset)
+                first += step;
+
+        // The edit may fall into the gap in front of that token, so lexing
+        // resumes right behind the one before it
+        const size_t start = first && first < count ? TokenEnd(first - 1) : 0UL;
+
+        MoveTokenGap(first);
+        MoveTextGap(edit.offset);
+        m_GapEnd += edit.removed;
+        Reserve(edit.inserted.size());
+        std::memcpy(m_Buffer.data() + m_GapStart, edit.inserted.data(), edit.inserted.size());
+        m_GapStart += edit.inserted.size();
+        m_Moved = true;
+
+        // Lexing ended in an invalid token before the edit, nothing after it counts
+        if (first == count)
+            return TokenChange{ first, 0UL, 0UL };
+
+        // From the start on the text is one piece behind the gap, and tokens
+        // behind the gap start where they did as far as the end is concerned
+        MoveTextGap(start);
+        const std::string_view rest(m_Buffer.data() + m_GapEnd, m_Buffer.size() - m_GapEnd);
+        const size_t size = Size();
+        const size_t editEnd = edit.offset + edit.inserted.size();
+
+        const SourceBuffer source = SourceBuffer::Borrow(rest, "<buffer>");
+        Lexer lexer(source, m_Front.Resource());
+        TokenStream fresh(rest, m_Front.Resource());
+
+        // Old tokens inside the edit may come out in front of the text
+        const auto moved = [size](const BackToken& token) {
+            return static_cast<int64_t>(size) - static_cast<int64_t>(token.fromEnd);
+        };
+        size_t removed = 0UL;
+        bool synced = false;
+
+        while (true)
+        {
+            const size_t next = start + lexer.Offset() + GapLength(rest.substr(lexer.Offset()));
+
+            // Past the edit the new text equals the old one, so a token
+            // starting where an old one did is that old token again
+            if (next >= editEnd)
+            {
+                while (!m_Back.empty() && moved(m_Back.back()) < static_cast<int64_t>(next))
+                {
+                    m_Back.pop_back();
+                    removed++;
+                }
+
+                if (!m_Back.empty() && moved(m_Back.back()) == static_cast<int64_t>(next))
+                {
+                    synced = true;
+                    break;
+                }
+            }
+
+            if (!lexer.LexNext(fresh))
+                break;
+        }
+
+        if (!synced)
+        {
+            removed += m_Back.size();
+            m_Back.clear();
+        }
+
+        for (size_t i = 0UL; i < fresh.Size(); i++)
+            m_Front.Push(LexemeOf(fresh, i), static_cast<uint32_t>(start + fresh.Offset(i)));
+
+        return TokenChange{ first, removed, fresh.Size() };
+    }
+
+    void IncrementalLexer::MoveTokenGap(size_t index)
+    {
+        const uint32_t size = static_cast<uint32_t>(Size());
+        while (m_Front.Size() > index)
+        {
+            const size_t last = m_Front.Size() - 1UL;
+            m_Back.push_back(BackToken{ LexemeOf(m_Front, last), size - m_Front.Offset(last) });
+            m_Front.Resize(last);
+        }
+
+        while (m_Front.Size() < index)
+        {
+            m_Front.Push(m_Back.back().lexeme, size - m_Back.back().fromEnd);
+            m_Back.pop_back();
+        }
+    }
+
+    void IncrementalLexer::MoveTextGap(size_t offset)
+    {
+        if (offset < m_GapStart)
+        {
+            const size_t moved = m_GapStart - offset;
+            std::memmove(m_Buffer.data() + m_GapEnd - moved, m_Buffer.data() + offset, moved);
+            m_GapStart -= moved;
+            m_GapEnd -= moved;
+        }
+        else if (offset > m_GapStart)
+        {
+            const size_t moved = offset - m_GapStart;
+            std::memmove(m_Buffer.data() + m_GapStart, m_Buffer.data() + m_GapEnd, moved);
+            m_GapStart += moved;
+            m_GapEnd += moved;
+        }
+    }
+
+    void IncrementalLexer::Reserve(size_t size)
+    {
+        if (m_GapEnd - m_GapStart >= size)
+            return;
+
+        // Doubles, so growing the text costs amortized constant time per byte
+        const size_t back = m_Buffer.size() - m_GapEnd;
+        const size_t capacity = std::max(m_Buffer.size() * 2UL, Size() + size + 64UL);
+        m_Buffer.resize(capacity);
+        std::memmove(m_Buffer.data() + capacity - back, m_Buffer.data() + m_GapEnd, back);
+        m_GapEnd = capacity - back;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "token_stream.hpp"
+
+namespace Aesthetic
+{
+    // Replacement of `removed` bytes at `offset` with `inserted`
+    struct TextEdit
+    {
+        size_t offset;
+        size_t removed;
+        std::string_view inserted;
+    };
+
+    // Tokens [first, first + removed) of the old stream were replaced by
+    // tokens [first, first + inserted) of the new one, everything after them
+    // was only moved
+    struct TokenChange
+    {
+        size_t first;
+        size_t removed;
+        size_t inserted;
+    };
+
+    // Keeps the tokens of a text that is edited in place, as in an editor.
+    // An edit only re-lexes from the last token it may affect until the new
+    // tokens line up with the old ones again.
+    //
+    // Text and tokens are gap buffers that open at the last edit. Tokens
+    // behind the gap count their offsets from the end of the text, so they
+    // stay valid however much the text in front of them changes. An edit
+    // costs the tokens it changes plus the distance the gaps move from the
+    // last edit, nothing that depends on the size of the text.
+    class IncrementalLexer
+    {
+    private:
+        // A token behind the gap, `fromEnd` bytes before the end of the text
+        struct BackToken
+        {
+            Lexeme lexeme;
+            uint32_t fromEnd;
+        };
+
+        // The text is [0, m_GapStart) and [m_GapEnd, m_Buffer.size())
+        std::string m_Buffer;
+        size_t m_GapStart;
+        size_t m_GapEnd;
+        // Tokens in front of the gap with their offsets, the ones behind it
+        // last to first, so the gap moves by popping and pushing
+        TokenStream m_Front;
+        std::vector<BackToken> m_Back;
+        // The text moved since m_Front was last pointed at it
+        bool m_Moved;
+    public:
+        IncrementalLexer(std::string text,
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        size_t Size() const { return m_Buffer.size() - (m_GapEnd - m_GapStart); }
+
+        // Both close the gaps, which costs the distance to the last edit
+        std::string_view Text();
+        const TokenStream& Tokens();
+
+        TokenChange Apply(const TextEdit& edit);
+    private:
+        size_t TokenCount() const { return m_Front.Size() + m_Back.size(); }
+        uint32_t TokenOffset(size_t index) const;
+        uint32_t TokenEnd(size_t index) const;
+
+        // Puts the gap in front of token `index`
+        void MoveTokenGap(size_t index);
+        // Puts the gap in front of byte `offset` of the text
+        void MoveTextGap(size_t offset);
+        // Makes room for at least `size` bytes in the gap
+        void Reserve(size_t size);
+    };
+} // namespace Aesthetic
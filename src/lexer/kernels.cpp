@@ -0,0 +1,374 @@
+#include "kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace Aesthetic
+{
+    static constexpr bool InRange(char sym, char lo, char hi)
+    {
+        return lo <= sym && sym <= hi;
+    }
+
+#ifdef AE_X86_KERNELS
+    // Unsigned `lo <= v <= hi` per byte, SSE2 only has signed comparisons
+    static inline __m128i InRange(__m128i v, char lo, char hi)
+    {
+        const __m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+        return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(static_cast<char>(hi - lo))), shifted);
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i InRange(__m256i v, char lo, char hi)
+    {
+        const __m256i shifted = _mm256_sub_epi8(v, _mm256_set1_epi8(lo));
+        return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(static_cast<char>(hi - lo))), shifted);
+    }
+#endif
+
+    struct BlankClass
+    {
+        static bool Scalar(char sym) { return sym == ' ' || sym == '\t'; }
+#ifdef AE_X86_KERNELS
+        static __m128i Match(__m128i v)
+        {
+            return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+        }
+
+        __attribute__((target("avx2")))
+        static __m256i Match(__m256i v)
+        {
+            return _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+        }
+#endif
+    };
+
+    struct SymbolicClass
+    {
+        static bool Scalar(char sym)
+        {
+            return InRange(static_cast<char>(sym | 0x20), 'a', 'z') || InRange(sym, '0', '9') || sym == '_';
+        }
+#ifdef AE_X86_KERNELS
+        static __m128i Match(__m128i v)
+        {
+            const __m128i letter = InRange(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+            const __m128i digit = InRange(v, '0', '9');
+            const __m128i underscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+            return _mm_or_si128(_mm_or_si128(letter, digit), underscore);
+        }
+
+        __attribute__((target("avx2")))
+        static __m256i Match(__m256i v)
+        {
+            const __m256i letter = InRange(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z');
+            const __m256i digit = InRange(v, '0', '9');
+            const __m256i underscore = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+            return _mm256_or_si256(_mm256_or_si256(letter, digit), underscore);
+        }
+#endif
+    };
+
+    // Digits of positional literals with the highest digit `Top`, hex adds letters
+    template<char Top, bool Letters>
+    struct DigitClass
+    {
+        static bool Scalar(char sym)
+        {
+            return InRange(sym, '0', Top) || (Letters && InRange(static_cast<char>(sym | 0x20), 'a', 'f'));
+        }
+#ifdef AE_X86_KERNELS
+        static __m128i Match(__m128i v)
+        {
+            const __m128i digit = InRange(v, '0', Top);
+            if (!Letters)
+                return digit;
+            return _mm_or_si128(digit, InRange(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'f'));
+        }
+
+        __attribute__((target("avx2")))
+        static __m256i Match(__m256i v)
+        {
+            const __m256i digit = InRange(v, '0', Top);
+            if (!Letters)
+                return digit;
+            return _mm256_or_si256(digit, InRange(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'f'));
+        }
+#endif
+    };
+
+    using HexDigitClass = DigitClass<'9', true>;
+    using OctDigitClass = DigitClass<'7', false>;
+    using BinDigitClass = DigitClass<'1', false>;
+    using DecDigitClass = DigitClass<'9', false>;
+
+    struct StringBodyClass
+    {
+        static bool Scalar(char sym) { return sym != '\'' && sym != '"' && sym != '\\'; }
+#ifdef AE_X86_KERNELS
+        static __m128i Match(__m128i v)
+        {
+            const __m128i bound = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\'')), _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+            const __m128i stop = _mm_or_si128(bound, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+            return _mm_xor_si128(stop, _mm_set1_epi8(-1));
+        }
+
+        __attribute__((target("avx2")))
+        static __m256i Match(__m256i v)
+        {
+            const __m256i bound = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\'')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+            const __m256i stop = _mm256_or_si256(bound, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+            return _mm256_xor_si256(stop, _mm256_set1_epi8(-1));
+        }
+#endif
+    };
+
+    struct AsciiClass
+    {
+        static bool Scalar(char sym) { return static_cast<signed char>(sym) >= 0; }
+#ifdef AE_X86_KERNELS
+        static __m128i Match(__m128i v) { return _mm_cmpgt_epi8(v, _mm_set1_epi8(-1)); }
+
+        __attribute__((target("avx2")))
+        static __m256i Match(__m256i v) { return _mm256_cmpgt_epi8(v, _mm256_set1_epi8(-1)); }
+#endif
+    };
+
+    // Everything but the continuation bytes 0x80-0xBF, which are -128 to -65 signed
+    struct LeadByteClass
+    {
+        static bool Scalar(char sym) { return static_cast<signed char>(sym) > -65; }
+#ifdef AE_X86_KERNELS
+        static __m128i Match(__m128i v) { return _mm_cmpgt_epi8(v, _mm_set1_epi8(-65)); }
+
+        __attribute__((target("avx2")))
+        static __m256i Match(__m256i v) { return _mm256_cmpgt_epi8(v, _mm256_set1_epi8(-65)); }
+#endif
+    };
+
+    struct NewlineClass
+    {
+        static bool Scalar(char sym) { return sym == '\n'; }
+#ifdef AE_X86_KERNELS
+        static __m128i Match(__m128i v) { return _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')); }
+
+        __attribute__((target("avx2")))
+        static __m256i Match(__m256i v) { return _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')); }
+#endif
+    };
+
+    template<typename Class>
+    static size_t SpanScalar(std::string_view text)
+    {
+        size_t i = 0UL;
+        while (i < text.size() && Class::Scalar(text[i]))
+            i++;
+        return i;
+    }
+
+#ifdef AE_X86_KERNELS
+    template<typename Class>
+    static size_t SpanSse2(std::string_view text)
+    {
+        const char* data = text.data();
+        size_t i = 0UL;
+
+        for (; i + 16UL <= text.size(); i += 16UL)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const uint32_t outside = ~static_cast<uint32_t>(_mm_movemask_epi8(Class::Match(v))) & 0xFFFFU;
+            if (outside)
+                return i + __builtin_ctz(outside);
+        }
+
+        return i + SpanScalar<Class>(text.substr(i));
+    }
+
+    template<typename Class>
+    __attribute__((target("avx2")))
+    static size_t SpanAvx2(std::string_view text)
+    {
+        const char* data = text.data();
+        size_t i = 0UL;
+
+        for (; i + 32UL <= text.size(); i += 32UL)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const uint32_t outside = ~static_cast<uint32_t>(_mm256_movemask_epi8(Class::Match(v)));
+            if (outside)
+                return i + __builtin_ctz(outside);
+        }
+
+        return i + SpanScalar<Class>(text.substr(i));
+    }
+#endif
+
+    template<typename Class>
+    static size_t CountScalar(std::string_view text)
+    {
+        size_t count = 0UL;
+        for (const char sym : text)
+            count += Class::Scalar(sym);
+        return count;
+    }
+
+#ifdef AE_X86_KERNELS
+    template<typename Class>
+    static size_t CountSse2(std::string_view text)
+    {
+        const char* data = text.data();
+        size_t count = 0UL;
+        size_t i = 0UL;
+
+        for (; i + 16UL <= text.size(); i += 16UL)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            count += __builtin_popcount(static_cast<uint32_t>(_mm_movemask_epi8(Class::Match(v))));
+        }
+
+        return count + CountScalar<Class>(text.substr(i));
+    }
+
+    template<typename Class>
+    __attribute__((target("avx2")))
+    static size_t CountAvx2(std::string_view text)
+    {
+        const char* data = text.data();
+        size_t count = 0UL;
+        size_t i = 0UL;
+
+        for (; i + 32UL <= text.size(); i += 32UL)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            count += __builtin_popcount(static_cast<uint32_t>(_mm256_movemask_epi8(Class::Match(v))));
+        }
+
+        return count + CountScalar<Class>(text.substr(i));
+    }
+#endif
+
+    // Line starts are the byte after each newline, `base` is the offset of `text`
+    static void LineStartsScalar(std::string_view text, uint32_t base, std::pmr::vector<uint32_t>& out)
+    {
+        for (size_t i = 0UL; i < text.size(); i++)
+            if (NewlineClass::Scalar(text[i]))
+                out.push_back(base + static_cast<uint32_t>(i) + 1U);
+    }
+
+#ifdef AE_X86_KERNELS
+    static void LineStartsSse2(std::string_view text, uint32_t base, std::pmr::vector<uint32_t>& out)
+    {
+        const char* data = text.data();
+        size_t i = 0UL;
+
+        for (; i + 16UL <= text.size(); i += 16UL)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            for (uint32_t mask = _mm_movemask_epi8(NewlineClass::Match(v)); mask; mask &= mask - 1U)
+                out.push_back(base + static_cast<uint32_t>(i + __builtin_ctz(mask)) + 1U);
+        }
+
+        LineStartsScalar(text.substr(i), base + static_cast<uint32_t>(i), out);
+    }
+
+    __attribute__((target("avx2")))
+    static void LineStartsAvx2(std::string_view text, uint32_t base, std::pmr::vector<uint32_t>& out)
+    {
+        const char* data = text.data();
+        size_t i = 0UL;
+
+        for (; i + 32UL <= text.size(); i += 32UL)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            for (uint32_t mask = _mm256_movemask_epi8(NewlineClass::Match(v)); mask; mask &= mask - 1U)
+                out.push_back(base + static_cast<uint32_t>(i + __builtin_ctz(mask)) + 1U);
+        }
+
+        LineStartsScalar(text.substr(i), base + static_cast<uint32_t>(i), out);
+    }
+#endif
+
+    template<template<typename> typename Span>
+    struct KernelTable
+    {
+        static constexpr ScanKernels Make(KernelSet set, ScanKernels::Kernel codePoints, ScanKernels::Collector lineStarts)
+        {
+            return ScanKernels{
+                set,
+                Span<BlankClass>::Run,
+                Span<SymbolicClass>::Run,
+                {
+                    Span<HexDigitClass>::Run,
+                    Span<OctDigitClass>::Run,
+                    Span<BinDigitClass>::Run,
+                    Span<DecDigitClass>::Run,
+                },
+                Span<StringBodyClass>::Run,
+                Span<AsciiClass>::Run,
+                codePoints,
+                lineStarts,
+            };
+        }
+    };
+
+    template<typename Class>
+    struct ScalarSpan { static size_t Run(std::string_view text) { return SpanScalar<Class>(text); } };
+
+    static const ScanKernels s_ScalarKernels = KernelTable<ScalarSpan>::Make(KernelSet::SCALAR, CountScalar<LeadByteClass>, LineStartsScalar);
+
+#ifdef AE_X86_KERNELS
+    template<typename Class>
+    struct Sse2Span { static size_t Run(std::string_view text) { return SpanSse2<Class>(text); } };
+
+    template<typename Class>
+    struct Avx2Span { static size_t Run(std::string_view text) { return SpanAvx2<Class>(text); } };
+
+    static const ScanKernels s_Sse2Kernels = KernelTable<Sse2Span>::Make(KernelSet::SSE2, CountSse2<LeadByteClass>, LineStartsSse2);
+    static const ScanKernels s_Avx2Kernels = KernelTable<Avx2Span>::Make(KernelSet::AVX2, CountAvx2<LeadByteClass>, LineStartsAvx2);
+#endif
+
+    bool ScanKernels::Supported(KernelSet set)
+    {
+#ifdef AE_X86_KERNELS
+        __builtin_cpu_init();
+#endif
+        switch (set)
+        {
+        case KernelSet::SCALAR:
+            return true;
+#ifdef AE_X86_KERNELS
+        case KernelSet::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case KernelSet::AVX2:
+            return __builtin_cpu_supports("avx2");
+#else
+        default:
+            return false;
+#endif
+        }
+
+        return false;
+    }
+
+    const ScanKernels& ScanKernels::Get(KernelSet set)
+    {
+#ifdef AE_X86_KERNELS
+        if (set == KernelSet::AVX2)
+            return s_Avx2Kernels;
+        if (set == KernelSet::SSE2)
+            return s_Sse2Kernels;
+#endif
+        return s_ScalarKernels;
+    }
+
+    const ScanKernels& ScanKernels::Active()
+    {
+        static const ScanKernels& active =
+            Supported(KernelSet::AVX2) ? Get(KernelSet::AVX2)
+            : Supported(KernelSet::SSE2) ? Get(KernelSet::SSE2)
+            : Get(KernelSet::SCALAR);
+        return active;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "token.hpp"
+
+namespace Aesthetic
+{
+    enum class KernelSet : uint8_t
+    {
+        SCALAR = 0U,
+        SSE2   = 1U,
+        AVX2   = 2U,
+    };
+
+    // Bulk byte classifiers behind the scanners. Every kernel returns the
+    // length of the longest prefix of `text` whose bytes are in its class.
+    // The vector versions classify 16 or 32 bytes per step and finish the
+    // tail with the scalar loop, so all sets give identical results.
+    struct ScanKernels
+    {
+        using Kernel = size_t (*)(std::string_view text);
+        // Appends `base` plus the index of every byte of `text` in the class
+        using Collector = void (*)(std::string_view text, uint32_t base, std::pmr::vector<uint32_t>& out);
+
+        KernelSet set;
+        // ' ' and '\t'
+        Kernel blanks;
+        // [A-Za-z0-9_], must agree with SymbolToken::Symbolic
+        Kernel symbolic;
+        // Indexed by NumberLiteralType, must agree with NumberToken::IsDigit
+        std::array<Kernel, 4UL> digits;
+        // Everything but the string bounds ' and " and backslashes
+        Kernel stringBody;
+        // Bytes below 0x80
+        Kernel ascii;
+        // Not a span: the number of bytes that do not continue a UTF-8
+        // sequence, which is the number of code points in valid text
+        Kernel codePoints;
+        // Positions right behind every '\n', for line start tables
+        Collector lineStarts;
+
+        static bool Supported(KernelSet set);
+        // Kernels of the given set, which has to be supported by the CPU
+        static const ScanKernels& Get(KernelSet set);
+        // Best set the running CPU supports, chosen once
+        static const ScanKernels& Active();
+    };
+
+    inline size_t SpanBlanks(std::string_view text)
+    {
+        return ScanKernels::Active().blanks(text);
+    }
+
+    inline size_t SpanSymbolic(std::string_view text)
+    {
+        return ScanKernels::Active().symbolic(text);
+    }
+
+    inline size_t SpanDigits(std::string_view text, NumberLiteralType type)
+    {
+        return ScanKernels::Active().digits[static_cast<size_t>(type)](text);
+    }
+
+    inline size_t SpanStringBody(std::string_view text)
+    {
+        return ScanKernels::Active().stringBody(text);
+    }
+
+    inline size_t SpanAscii(std::string_view text)
+    {
+        return ScanKernels::Active().ascii(text);
+    }
+
+    inline size_t CountCodePoints(std::string_view text)
+    {
+        return ScanKernels::Active().codePoints(text);
+    }
+
+    inline void CollectLineStarts(std::string_view text, uint32_t base, std::pmr::vector<uint32_t>& out)
+    {
+        ScanKernels::Active().lineStarts(text, base, out);
+    }
+} // namespace Aesthetic
@@ -1,71 +1,98 @@
+#include <cstdint>
+
 #include "lexer.hpp"
+#include "scanner.hpp"
+#include "dfa_scanner.hpp"
+#include "lexer_stats.hpp"
 
 namespace Aesthetic
 {
-    Lexer::Lexer(const std::string& program)
-        : m_Program(program), m_Left(program), m_CurrentPosition(1, 1) {}
+    template<LexerEngine Engine>
+    BasicLexer<Engine>::BasicLexer(const std::string& program, std::pmr::memory_resource* resource)
+        : m_Resource(resource), m_Owned(program, resource), m_Program(m_Owned), m_Left(m_Program) {}
+
+    template<LexerEngine Engine>
+    BasicLexer<Engine>::BasicLexer(const SourceBuffer& source, std::pmr::memory_resource* resource)
+        : m_Resource(resource), m_Owned(resource), m_Program(source.View()), m_Left(m_Program) {}
     
-    Lexer::~Lexer() {}
+    template<LexerEngine Engine>
+    BasicLexer<Engine>::~BasicLexer() {}
 
-    std::vector<TokenRef> Lexer::LexProgram()
+    template<LexerEngine Engine>
+    TokenStream BasicLexer<Engine>::Lex()
     {
-        std::vector<TokenRef> result;
-        TokenRef token;
-
-        while ((token = LexToken())->valid && (dynamic_cast<EOFToken*>(token.get()) == nullptr))
-            result.push_back(token);
-
-        result.push_back(token);
+        TokenStream stream(m_Program, m_Resource);
+        while (LexNext(stream));
+        return stream;
+    }
 
-        return result;
+    template<LexerEngine Engine>
+    void BasicLexer<Engine>::Seek(size_t offset)
+    {
+        m_Left = m_Program.substr(offset);
     }
 
-    TokenRef Lexer::LexToken()
+    template<LexerEngine Engine>
+    bool BasicLexer<Engine>::LexNext(TokenStream& stream, size_t end, bool commit)
     {
+        // Offsets are 32-bit, longer programs end in an invalid token
+        const size_t limit = UINT32_MAX;
+
+        const bool sampled = LexerCounters::s_Enabled && LexerCounters::Sample();
+        const uint64_t start = sampled ? LexerCounters::Now() : 0U;
+        const size_t gapStart = Offset();
         SkipGap();
 
-        if (auto tokenRef = FindToken<EOFToken>()) { return tokenRef.value(); }
-        if (auto tokenRef = FindToken<StringToken>()) { return tokenRef.value(); }
-        if (auto tokenRef = FindToken<FloatingPointToken>()) { return tokenRef.value(); }
-        if (auto tokenRef = FindToken<IntegerToken>()) { return tokenRef.value(); }
-        if (auto tokenRef = FindToken<OperatorToken>()) { return tokenRef.value(); }
-        if (auto tokenRef = FindToken<KeywordToken>()) { return tokenRef.value(); }
-        if (auto tokenRef = FindToken<PunctuationToken>()) { return tokenRef.value(); }
-        if (auto tokenRef = FindToken<SymbolToken>()) { return tokenRef.value(); }
+        const size_t offset = Offset();
+        const uint64_t scanned = sampled ? LexerCounters::Now() : 0U;
+        if constexpr (LexerCounters::s_Enabled)
+            LexerCounters::Gap(offset - gapStart, sampled, scanned - start);
+
+        if (offset >= end)
+            return false;
 
-        return std::make_shared<Token>(false, m_CurrentPosition, 0UL);
+        Lexeme lexeme = offset < limit
+            ? LexToken()
+            : Lexeme{ TokenKind::INVALID, 0U, false, 0U };
+        if (commit)
+            lexeme = CommitLexeme(lexeme, m_Left);
+
+        if constexpr (LexerCounters::s_Enabled)
+            LexerCounters::Token(lexeme.kind, lexeme.length, sampled, sampled ? LexerCounters::Now() - scanned : 0U);
+
+        stream.Push(lexeme, static_cast<uint32_t>(offset));
+        Advance(lexeme.length);
+
+        return lexeme.valid && lexeme.kind != TokenKind::END_OF_FILE;
+    }
+
+    template<LexerEngine Engine>
+    std::pmr::vector<TokenRef> BasicLexer<Engine>::LexProgram()
+    {
+        return Lex().Refs();
     }
 
-    template<typename T>
-    requires requires(T t, const std::string_view& sv, const Position& pos)
+    template<LexerEngine Engine>
+    Lexeme BasicLexer<Engine>::LexToken() const
     {
-        { T::Find(sv, pos) } -> std::same_as<std::optional<std::shared_ptr<T>>>;
-        t.pos;
+        if constexpr (Engine == LexerEngine::DFA)
+            return ScanLexemeDfa(m_Left);
+        else
+            return ScanLexeme(m_Left);
     }
-    std::optional<std::shared_ptr<T>> Lexer::FindToken()
+
+    template<LexerEngine Engine>
+    void BasicLexer<Engine>::Advance(size_t length)
     {
-        using TRef = std::shared_ptr<T>;
-        if (std::optional<TRef> tokenRef = T::Find(m_Left, m_CurrentPosition))
-        {
-            Position length = tokenRef.value()->length;
-            m_CurrentPosition += length;
-
-            while (length.line--)
-                m_Left.remove_prefix(m_Left.find('\n'));
-            m_Left.remove_prefix(length.col);
-
-            return tokenRef;
-        }
-        return std::nullopt;
+        m_Left.remove_prefix(length);
     }
 
-    void Lexer::SkipGap()
+    template<LexerEngine Engine>
+    void BasicLexer<Engine>::SkipGap()
     {
-        auto start = m_Left.begin();
-        m_Left.remove_prefix(std::min(m_Left.find_first_not_of(" \t"), m_Left.size()));
-        size_t spaces = m_Left.begin() - start;
-        m_CurrentPosition.col += spaces;
+        m_Left.remove_prefix(GapLength(m_Left));
     }
 
+    template class BasicLexer<LexerEngine::SCANNERS>;
+    template class BasicLexer<LexerEngine::DFA>;
 } // namespace Aesthetic
-
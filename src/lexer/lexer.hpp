@@ -1,37 +1,64 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <memory_resource>
 #include <vector>
 #include <string_view>
-#include <optional>
-#include <memory>
-#include <concepts>
 
 #include "token.hpp"
+#include "token_stream.hpp"
+#include "io/source_buffer.hpp"
 
 
 namespace Aesthetic
 {
-    class Lexer
+    // How a lexer recognizes a token: SCANNERS tries the scanner of every
+    // token class that can start with the byte, DFA walks the transition
+    // table generated from the same rules. Both produce the same tokens.
+    enum class LexerEngine : uint8_t
+    {
+        SCANNERS = 0U,
+        DFA      = 1U,
+    };
+
+    template<LexerEngine Engine>
+    class BasicLexer
     {
     private:
-        std::string m_Program;
+        std::pmr::memory_resource* m_Resource;
+        std::pmr::string m_Owned;
+        std::string_view m_Program;
         std::string_view m_Left;
-        Position m_CurrentPosition;
     public:
-        Lexer(const std::string& program);
-        ~Lexer();
+        // Tokens, the program copy and TokenRefs are allocated from `resource`,
+        // usually the Arena of the compilation unit
+        BasicLexer(const std::string& program,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        // Lexes the buffer in place, it has to outlive the lexer and its tokens
+        BasicLexer(const SourceBuffer& source,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        ~BasicLexer();
 
-        std::vector<TokenRef> LexProgram();
+        TokenStream Lex();
+        std::pmr::vector<TokenRef> LexProgram();
+
+        // Continues lexing at `offset`, which has to be a token boundary
+        void Seek(size_t offset);
+        // Lexes the next token into `stream` unless it would start at or after
+        // `end`. Returns false once that limit is reached or the stream ended
+        // in an EOF or invalid token. Tokens that may still be thrown away
+        // are lexed without `commit`, their symbols are interned later by
+        // TokenStream::InternSymbols().
+        bool LexNext(TokenStream& stream, size_t end = SIZE_MAX, bool commit = true);
+
+        size_t Offset() const { return m_Left.data() - m_Program.data(); }
     private:
-        template<typename T>
-        requires requires(T t, const std::string_view& sv, const Position& pos)
-        {
-            { T::Find(sv, pos) } -> std::same_as<std::optional<std::shared_ptr<T>>>;
-            t.pos;
-        }
-        std::optional<std::shared_ptr<T>> FindToken();
-        TokenRef LexToken();
+        Lexeme LexToken() const;
+        void Advance(size_t length);
         void SkipGap();
     };
+
+    using Lexer = BasicLexer<LexerEngine::SCANNERS>;
+    using DfaLexer = BasicLexer<LexerEngine::DFA>;
 } // namespace Aesthetic
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "lexer_stats.hpp"
+
+namespace Aesthetic
+{
+    // Blocks of running threads and the sums of the ones that exited
+    struct LexerCounters::Registry
+    {
+        std::mutex mutex;
+        std::vector<Block*> blocks;
+        LexerStats retired;
+    };
+
+    uint64_t LexerStats::Kind::Cycles() const
+    {
+        if (!samples)
+            return 0U;
+        return static_cast<uint64_t>(static_cast<double>(sampledCycles) * static_cast<double>(tokens) / static_cast<double>(samples));
+    }
+
+    uint64_t LexerStats::Tokens() const
+    {
+        uint64_t result = 0U;
+        for (const Kind& kind : kinds)
+            result += kind.tokens;
+        return result;
+    }
+
+    uint64_t LexerStats::Bytes() const
+    {
+        uint64_t result = gaps.bytes;
+        for (const Kind& kind : kinds)
+            result += kind.bytes;
+        return result;
+    }
+
+    uint64_t LexerStats::Cycles() const
+    {
+        uint64_t result = gaps.Cycles();
+        for (const Kind& kind : kinds)
+            result += kind.Cycles();
+        return result;
+    }
+
+    static void AddKind(LexerStats::Kind& to, const LexerStats::Kind& from)
+    {
+        to.tokens += from.tokens;
+        to.bytes += from.bytes;
+        to.samples += from.samples;
+        to.sampledCycles += from.sampledCycles;
+        for (size_t i = 0UL; i < LexerStats::s_Buckets; i++)
+            to.histogram[i] += from.histogram[i];
+    }
+
+    LexerStats& LexerStats::operator+=(const LexerStats& other)
+    {
+        for (size_t i = 0UL; i < s_Scanners; i++)
+        {
+            scanners[i].attempts += other.scanners[i].attempts;
+            scanners[i].successes += other.scanners[i].successes;
+        }
+        for (size_t i = 0UL; i < s_Kinds; i++)
+            AddKind(kinds[i], other.kinds[i]);
+        AddKind(gaps, other.gaps);
+        return *this;
+    }
+
+    LexerCounters::Block::Block()
+        : countdown(1U), random(reinterpret_cast<uintptr_t>(this) | 1U)
+    {
+        Registry& registry = Registered();
+        std::lock_guard lock(registry.mutex);
+        registry.blocks.push_back(this);
+    }
+
+    LexerCounters::Block::~Block()
+    {
+        Registry& registry = Registered();
+        std::lock_guard lock(registry.mutex);
+        registry.retired += Load();
+        registry.blocks.erase(std::find(registry.blocks.begin(), registry.blocks.end(), this));
+        s_Local = nullptr;
+    }
+
+    LexerStats::Kind LexerCounters::KindCounters::Load() const
+    {
+        LexerStats::Kind kind{ tokens.Load(), bytes.Load(), samples.Load(), cycles.Load() };
+        for (size_t i = 0UL; i < LexerStats::s_Buckets; i++)
+            kind.histogram[i] = histogram[i].Load();
+        return kind;
+    }
+
+    void LexerCounters::KindCounters::Clear()
+    {
+        tokens.Clear();
+        bytes.Clear();
+        samples.Clear();
+        cycles.Clear();
+        for (Counter& counter : histogram)
+            counter.Clear();
+    }
+
+    LexerStats LexerCounters::Block::Load() const
+    {
+        LexerStats stats;
+        for (size_t i = 0UL; i < LexerStats::s_Scanners; i++)
+            stats.scanners[i] = LexerStats::Scanner{ attempts[i].Load(), successes[i].Load() };
+        for (size_t i = 0UL; i < LexerStats::s_Kinds; i++)
+            stats.kinds[i] = kinds[i].Load();
+        stats.gaps = gaps.Load();
+        return stats;
+    }
+
+    void LexerCounters::Block::Clear()
+    {
+        for (size_t i = 0UL; i < LexerStats::s_Scanners; i++)
+        {
+            attempts[i].Clear();
+            successes[i].Clear();
+        }
+        for (KindCounters& counters : kinds)
+            counters.Clear();
+        gaps.Clear();
+    }
+
+    LexerCounters::Registry& LexerCounters::Registered()
+    {
+        // Never destroyed, threads may exit after static destruction began
+        static Registry* registry = new Registry;
+        return *registry;
+    }
+
+    LexerCounters::Block& LexerCounters::Register()
+    {
+        thread_local Block block;
+        s_Local = &block;
+        return block;
+    }
+
+    LexerStats LexerCounters::Snapshot()
+    {
+        Registry& registry = Registered();
+        std::lock_guard lock(registry.mutex);
+
+        LexerStats stats = registry.retired;
+        for (const Block* block : registry.blocks)
+            stats += block->Load();
+        return stats;
+    }
+
+    void LexerCounters::Reset()
+    {
+        Registry& registry = Registered();
+        std::lock_guard lock(registry.mutex);
+
+        registry.retired = LexerStats{};
+        for (Block* block : registry.blocks)
+            block->Clear();
+    }
+} // namespace Aesthetic
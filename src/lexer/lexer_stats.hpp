@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "token.hpp"
+
+// Build with -DAE_LEXER_STATS=1 (make LEXER_STATS=1) to count what the
+// lexer does. Without it every hook compiles to nothing.
+#ifndef AE_LEXER_STATS
+    #define AE_LEXER_STATS 0
+#endif
+
+#if AE_LEXER_STATS && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+#elif AE_LEXER_STATS
+    #include <chrono>
+#endif
+
+namespace Aesthetic
+{
+    // The scanners ScanLexeme() tries, in the order it tries them
+    enum class LexerScanner : uint8_t
+    {
+        END_OF_FILE = 0U,
+        STRING      = 1U,
+        NUMBER      = 2U,
+        OPERATOR    = 3U,
+        KEYWORD     = 4U,
+        PUNCTUATION = 5U,
+        SYMBOL      = 6U,
+        COUNT       = 7U,
+    };
+
+    // What the lexers did, summed over all threads. Counts are exact, time
+    // is only taken for a random sample of tokens and gaps and scaled up.
+    // Cycles are time stamp counter ticks, nanoseconds where there is no
+    // such counter.
+    struct LexerStats
+    {
+        static constexpr size_t s_Kinds = static_cast<size_t>(TokenKind::INTEGER) + 1UL;
+        static constexpr size_t s_Scanners = static_cast<size_t>(LexerScanner::COUNT);
+        // Bucket b of a histogram holds the samples of [2^(b - 1), 2^b)
+        // cycles, the last one everything from there on
+        static constexpr size_t s_Buckets = 24UL;
+
+        static constexpr size_t Bucket(uint64_t cycles)
+        {
+            return std::min(static_cast<size_t>(std::bit_width(cycles)), s_Buckets - 1UL);
+        }
+
+        struct Scanner
+        {
+            uint64_t attempts = 0U;
+            uint64_t successes = 0U;
+        };
+
+        struct Kind
+        {
+            uint64_t tokens = 0U;
+            uint64_t bytes = 0U;
+            // How many of the tokens were timed and how long they took
+            uint64_t samples = 0U;
+            uint64_t sampledCycles = 0U;
+            // The samples by Bucket() of their cycles
+            std::array<uint64_t, s_Buckets> histogram{};
+
+            // Of all tokens, extrapolated from the samples
+            uint64_t Cycles() const;
+        };
+
+        // Every Scan() call of the scanners, by any lexer
+        std::array<Scanner, s_Scanners> scanners{};
+        // Tokens produced by Lexer, by TokenKind
+        std::array<Kind, s_Kinds> kinds{};
+        // Blank runs skipped before tokens, empty ones included
+        Kind gaps;
+
+        uint64_t Tokens() const;
+        // Of tokens and gaps together
+        uint64_t Bytes() const;
+        uint64_t Cycles() const;
+
+        LexerStats& operator+=(const LexerStats& other);
+    };
+
+    // Where the lexer hooks report to. Every thread counts into its own
+    // block, single-writer relaxed atomics that cost what plain increments
+    // do. Snapshot() adds up the blocks of running threads and what exited
+    // threads left behind. Reading the clock costs more than lexing most
+    // tokens, so only about one in s_SamplePeriod is timed, picked at
+    // random intervals so regular code does not alias with the sampling.
+    class LexerCounters
+    {
+    public:
+        static constexpr bool s_Enabled = AE_LEXER_STATS;
+        static constexpr uint32_t s_SamplePeriod = 16U;
+    private:
+        struct Counter
+        {
+            std::atomic<uint64_t> value{ 0U };
+
+            void Add(uint64_t amount) { value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed); }
+            uint64_t Load() const { return value.load(std::memory_order_relaxed); }
+            void Clear() { value.store(0U, std::memory_order_relaxed); }
+        };
+
+        struct KindCounters
+        {
+            Counter tokens;
+            Counter bytes;
+            Counter samples;
+            Counter cycles;
+            std::array<Counter, LexerStats::s_Buckets> histogram;
+
+            void Add(uint64_t length, bool sampled, uint64_t took)
+            {
+                tokens.Add(1U);
+                bytes.Add(length);
+                if (sampled)
+                {
+                    samples.Add(1U);
+                    cycles.Add(took);
+                    histogram[LexerStats::Bucket(took)].Add(1U);
+                }
+            }
+            LexerStats::Kind Load() const;
+            void Clear();
+        };
+
+        struct Block
+        {
+            std::array<Counter, LexerStats::s_Scanners> attempts;
+            std::array<Counter, LexerStats::s_Scanners> successes;
+            std::array<KindCounters, LexerStats::s_Kinds> kinds;
+            KindCounters gaps;
+            // Owner only: tokens until the next sample and the generator
+            // of the interval after it
+            uint32_t countdown;
+            uint64_t random;
+
+            Block();
+            ~Block();
+
+            LexerStats Load() const;
+            void Clear();
+        };
+
+        struct Registry;
+
+        // Constant initialized, so it reads as a plain thread-local load
+        static inline thread_local Block* s_Local = nullptr;
+
+        static Registry& Registered();
+        static Block& Register();
+        static Block& Local() { return s_Local ? *s_Local : Register(); }
+    public:
+        static LexerStats Snapshot();
+        static void Reset();
+
+        static uint64_t Now()
+        {
+#if AE_LEXER_STATS && (defined(__x86_64__) || defined(__i386__))
+            return __rdtsc();
+#elif AE_LEXER_STATS
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#else
+            return 0U;
+#endif
+        }
+
+        static void Attempt(LexerScanner scanner, bool success)
+        {
+            Block& block = Local();
+            block.attempts[static_cast<size_t>(scanner)].Add(1U);
+            block.successes[static_cast<size_t>(scanner)].Add(success);
+        }
+
+        // Whether to time the next gap and token
+        static bool Sample()
+        {
+            Block& block = Local();
+            if (--block.countdown)
+                return false;
+
+            // xorshift, intervals from 1 to twice the period less one
+            block.random ^= block.random << 13U;
+            block.random ^= block.random >> 7U;
+            block.random ^= block.random << 17U;
+            block.countdown = 1U + static_cast<uint32_t>(block.random % (2U * s_SamplePeriod - 1U));
+            return true;
+        }
+
+        // `cycles` only counts if `sampled`
+        static void Token(TokenKind kind, uint64_t bytes, bool sampled, uint64_t cycles)
+        {
+            Local().kinds[static_cast<size_t>(kind)].Add(bytes, sampled, cycles);
+        }
+
+        static void Gap(uint64_t bytes, bool sampled, uint64_t cycles)
+        {
+            Local().gaps.Add(bytes, sampled, cycles);
+        }
+    };
+} // namespace Aesthetic
@@ -0,0 +1,36 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "line_index.hpp"
+#include "kernels.hpp"
+
+namespace Aesthetic
+{
+    LineIndex::LineIndex(std::pmr::memory_resource* resource)
+        : m_Starts(resource) {}
+
+    LineIndex::LineIndex(std::string_view text, std::pmr::memory_resource* resource)
+        : m_Starts(resource)
+    {
+        Build(text);
+    }
+
+    void LineIndex::Build(std::string_view text)
+    {
+        // Offsets are 32-bit like the tokens', nothing is lexed past that
+        text = text.substr(0, UINT32_MAX);
+
+        m_Starts.clear();
+        // Generated and hand written sources average a few dozen bytes per line
+        m_Starts.reserve(text.size() / 32UL + 1UL);
+        m_Starts.push_back(0U);
+        CollectLineStarts(text, 0U, m_Starts);
+    }
+
+    Position LineIndex::Locate(std::string_view text, size_t offset) const
+    {
+        const size_t line = std::upper_bound(m_Starts.begin(), m_Starts.end(), offset) - m_Starts.begin();
+        const size_t start = m_Starts[line - 1];
+        return Position(line, CountCodePoints(text.substr(start, offset - start)) + 1UL);
+    }
+} // namespace Aesthetic
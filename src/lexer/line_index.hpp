@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "token.hpp"
+
+namespace Aesthetic
+{
+    // Offsets at which the lines of a text start, built in one vectorized
+    // pass. Tokens only keep byte offsets, their line and column are looked
+    // up here by binary search when a diagnostic or dump needs them.
+    class LineIndex
+    {
+    private:
+        // Always starts with 0 once built
+        std::pmr::vector<uint32_t> m_Starts;
+    public:
+        LineIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        LineIndex(std::string_view text, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void Build(std::string_view text);
+        void Clear() { m_Starts.clear(); }
+        bool Built() const { return !m_Starts.empty(); }
+
+        size_t Lines() const { return m_Starts.size(); }
+        // Offset of the first byte of `line`, counted from 1
+        uint32_t LineStart(size_t line) const { return m_Starts[line - 1]; }
+        // 1-based line and column of the byte at `offset` of `text`, the
+        // text the index was built from. Columns count code points.
+        Position Locate(std::string_view text, size_t offset) const;
+    };
+} // namespace Aesthetic
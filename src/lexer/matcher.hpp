@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace Aesthetic
+{
+    template<typename U>
+    struct HardTokenMatch
+    {
+        U type;
+        size_t length;
+    };
+
+    // Trie over a `representations` table, built entirely at compile time.
+    // Every node holds a dense 256-wide transition row, so a lookup is one
+    // table load per consumed byte and never allocates.
+    template<const auto& Representations, typename U>
+    class HardTokenMatcher
+    {
+    private:
+        static constexpr uint8_t s_NoTransition = 0U;
+        static constexpr uint8_t s_NoTerminal = UINT8_MAX;
+
+        static constexpr size_t CountNodes()
+        {
+            size_t count = 1UL;
+            for (const auto& representation: Representations)
+                count += representation.size();
+            return count;
+        }
+
+        static constexpr size_t s_MaxNodes = CountNodes();
+        static_assert(s_MaxNodes < UINT8_MAX, "representation table is too large for an 8-bit trie");
+
+        struct Node
+        {
+            std::array<uint8_t, 256UL> next{};
+            uint8_t terminal = s_NoTerminal;
+        };
+
+        static constexpr std::array<Node, s_MaxNodes> Build()
+        {
+            std::array<Node, s_MaxNodes> nodes{};
+            size_t used = 1UL;
+
+            for (size_t i = 0; i < Representations.size(); i++)
+            {
+                size_t node = 0UL;
+                for (char sym: Representations[i])
+                {
+                    uint8_t& next = nodes[node].next[static_cast<uint8_t>(sym)];
+                    if (next == s_NoTransition)
+                        next = static_cast<uint8_t>(used++);
+                    node = next;
+                }
+                nodes[node].terminal = static_cast<uint8_t>(i);
+            }
+
+            return nodes;
+        }
+
+        static constexpr std::array<Node, s_MaxNodes> s_Nodes = Build();
+    public:
+        // Longest representation that prefixes `text`, if any
+        static constexpr std::optional<HardTokenMatch<U>> Find(std::string_view text)
+        {
+            std::optional<HardTokenMatch<U>> result;
+            size_t node = 0UL;
+
+            for (size_t i = 0; i < text.size(); i++)
+            {
+                node = s_Nodes[node].next[static_cast<uint8_t>(text[i])];
+                if (node == s_NoTransition)
+                    break;
+                if (s_Nodes[node].terminal != s_NoTerminal)
+                    result = HardTokenMatch<U>{ static_cast<U>(s_Nodes[node].terminal), i + 1 };
+            }
+
+            return result;
+        }
+    };
+} // namespace Aesthetic
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "parallel_lexer.hpp"
+#include "lexer.hpp"
+#include "scanner.hpp"
+
+namespace Aesthetic
+{
+    struct LexedChunk
+    {
+        // Speculative tokens of the chunk
+        TokenStream speculative;
+        // Tokens re-lexed by the fix-up pass in front of the accepted ones
+        TokenStream fixed;
+        // First speculative token that made it into the result
+        size_t first;
+
+        LexedChunk(std::string_view program)
+            : speculative(program, std::pmr::new_delete_resource()),
+              fixed(program, std::pmr::new_delete_resource()),
+              first(0UL) {}
+    };
+
+    ParallelLexer::ParallelLexer(const SourceBuffer& source, ThreadPool& pool,
+                                 std::pmr::memory_resource* resource, size_t minChunkSize)
+        : m_Source(source), m_Pool(pool), m_Resource(resource), m_MinChunkSize(std::max(minChunkSize, 1UL)) {}
+
+    TokenStream ParallelLexer::Lex()
+    {
+        const std::string_view program = m_Source.View();
+        const std::vector<size_t> bounds = Split();
+        const size_t count = bounds.size() - 1;
+
+        std::vector<LexedChunk> chunks;
+        chunks.reserve(count);
+        for (size_t i = 0; i < count; i++)
+            chunks.emplace_back(program);
+
+        m_Pool.ParallelFor(count, [&](size_t i) {
+            LexedChunk& chunk = chunks[i];
+            const size_t end = i + 1 == count ? SIZE_MAX : bounds[i + 1];
+
+            // Generated sources average a few bytes per token
+            chunk.speculative.Reserve((bounds[i + 1] - bounds[i]) / 4);
+
+            // Tokens in front of where the chunk lines up are thrown away,
+            // names are only interned once they made it into the result
+            Lexer lexer(m_Source, std::pmr::new_delete_resource());
+            lexer.Seek(bounds[i]);
+            while (lexer.LexNext(chunk.speculative, end, false));
+        });
+
+        // Fix-up: find where every chunk's speculative tokens become valid
+        Lexer fixer(m_Source, std::pmr::new_delete_resource());
+        size_t resume = 0UL;
+        bool finished = false;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            LexedChunk& chunk = chunks[i];
+            const TokenStream& speculative = chunk.speculative;
+            chunk.first = speculative.Size();
+
+            size_t j = 0UL;
+            while (!finished)
+            {
+                const size_t next = resume + GapLength(program.substr(resume));
+                while (j < speculative.Size() && speculative.Offset(j) < next)
+                    j++;
+
+                if (j < speculative.Size() && speculative.Offset(j) == next)
+                {
+                    const size_t last = speculative.Size() - 1;
+                    chunk.first = j;
+
+                    resume = speculative.Offset(last) + speculative.Length(last);
+                    finished = !speculative.Valid(last) || speculative.Kind(last) == TokenKind::END_OF_FILE;
+                    break;
+                }
+
+                if (i + 1 < count && next >= bounds[i + 1])
+                    break;
+
+                fixer.Seek(resume);
+                finished = !fixer.LexNext(chunk.fixed);
+                resume = fixer.Offset();
+            }
+        }
+
+        std::vector<size_t> at(count + 1, 0UL);
+        for (size_t i = 0; i < count; i++)
+            at[i + 1] = at[i] + chunks[i].fixed.Size() + chunks[i].speculative.Size() - chunks[i].first;
+
+        TokenStream result(program, m_Resource);
+        result.Resize(at[count]);
+
+        m_Pool.ParallelFor(count, [&](size_t i) {
+            const LexedChunk& chunk = chunks[i];
+            result.Place(at[i], chunk.fixed, 0UL, chunk.fixed.Size());
+            result.Place(at[i] + chunk.fixed.Size(), chunk.speculative, chunk.first, chunk.speculative.Size());
+            result.InternSymbols(at[i] + chunk.fixed.Size(), at[i + 1]);
+        });
+
+        return result;
+    }
+
+    std::vector<size_t> ParallelLexer::Split() const
+    {
+        const std::string_view program = m_Source.View();
+        const size_t count = std::clamp(program.size() / m_MinChunkSize, 1UL, m_Pool.Size() * 4UL);
+        std::vector<size_t> bounds{ 0UL };
+
+        for (size_t k = 1; k < count; k++)
+        {
+            const size_t newline = program.find('\n', std::max(program.size() / count * k, bounds.back()));
+            if (newline == std::string_view::npos)
+                break;
+            if (newline + 1 < program.size())
+                bounds.push_back(newline + 1);
+        }
+
+        bounds.push_back(program.size());
+        return bounds;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "token_stream.hpp"
+#include "io/source_buffer.hpp"
+#include "util/thread_pool.hpp"
+
+namespace Aesthetic
+{
+    // Lexes one large program on a thread pool. The text is cut into chunks
+    // right after newlines and every chunk is lexed speculatively, assuming
+    // a token starts at its first byte. A serial fix-up pass then walks the
+    // chunks in order: where the previous chunk's last token ran past the
+    // cut (a string literal spanning lines), tokens are re-lexed from the
+    // true boundary until they line up with the speculative ones again.
+    // The result is identical to Lexer::Lex().
+    class ParallelLexer
+    {
+    public:
+        static constexpr size_t s_MinChunkSize = 256UL * 1024UL;
+        // Below this the threads cost more than they save, Lexer is faster
+        static constexpr size_t s_MinParallelSize = 4UL * 1024UL * 1024UL;
+    private:
+        const SourceBuffer& m_Source;
+        ThreadPool& m_Pool;
+        std::pmr::memory_resource* m_Resource;
+        size_t m_MinChunkSize;
+    public:
+        ParallelLexer(const SourceBuffer& source, ThreadPool& pool,
+                      std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                      size_t minChunkSize = s_MinChunkSize);
+
+        TokenStream Lex();
+    private:
+        std::vector<size_t> Split() const;
+    };
+} // namespace Aesthetic
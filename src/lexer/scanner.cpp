@@ -0,0 +1,109 @@
+#include <array>
+#include <concepts>
+#include <cstdint>
+
+#include "scanner.hpp"
+#include "kernels.hpp"
+#include "lexer_stats.hpp"
+#include "util/interner.hpp"
+
+namespace Aesthetic
+{
+    // Which scanners can possibly accept a token starting with a given byte
+    enum LeadClass : uint8_t
+    {
+        LEAD_NONE        = 0U,
+        LEAD_STRING      = 1U << 0U,
+        LEAD_NUMBER      = 1U << 1U,
+        LEAD_OPERATOR    = 1U << 2U,
+        LEAD_KEYWORD     = 1U << 3U,
+        LEAD_PUNCTUATION = 1U << 4U,
+        LEAD_SYMBOL      = 1U << 5U,
+    };
+
+    template<const auto& Representations>
+    constexpr void MarkLeads(std::array<uint8_t, 256UL>& table, LeadClass lead)
+    {
+        for (const auto& representation: Representations)
+            table[static_cast<uint8_t>(representation.front())] |= lead;
+    }
+
+    constexpr std::array<uint8_t, 256UL> BuildLeadTable()
+    {
+        std::array<uint8_t, 256UL> table{};
+
+        table['\''] |= LEAD_STRING;
+        table['"'] |= LEAD_STRING;
+        table['.'] |= LEAD_NUMBER;
+        for (char sym = '0'; sym <= '9'; sym++)
+            table[static_cast<uint8_t>(sym)] |= LEAD_NUMBER | LEAD_SYMBOL;
+        for (char sym = 'a'; sym <= 'z'; sym++)
+            table[static_cast<uint8_t>(sym)] |= LEAD_SYMBOL;
+        for (char sym = 'A'; sym <= 'Z'; sym++)
+            table[static_cast<uint8_t>(sym)] |= LEAD_SYMBOL;
+        table['_'] |= LEAD_SYMBOL;
+        // Lead bytes of UTF-8 sequences, the scanner decides on XID_Start
+        for (size_t lead = 0xC2UL; lead <= 0xF4UL; lead++)
+            table[lead] |= LEAD_SYMBOL;
+
+        MarkLeads<OperatorToken::representations>(table, LEAD_OPERATOR);
+        MarkLeads<KeywordToken::representations>(table, LEAD_KEYWORD);
+        MarkLeads<PunctuationToken::representations>(table, LEAD_PUNCTUATION);
+
+        return table;
+    }
+
+    static constexpr std::array<uint8_t, 256UL> s_LeadTable = BuildLeadTable();
+
+    template<LexerScanner Scanner, typename T>
+    requires requires(const std::string_view& sv)
+    {
+        { T::Scan(sv) } -> std::same_as<std::optional<Lexeme>>;
+    }
+    std::optional<Lexeme> ScanToken(const std::string_view& text)
+    {
+        std::optional<Lexeme> lexeme = T::Scan(text);
+        if constexpr (LexerCounters::s_Enabled)
+            LexerCounters::Attempt(Scanner, lexeme.has_value());
+        return lexeme;
+    }
+
+    Lexeme ScanLexeme(const std::string_view& text)
+    {
+        if (auto lexeme = ScanToken<LexerScanner::END_OF_FILE, EOFToken>(text)) { return lexeme.value(); }
+
+        // Scanners are still tried in the original priority order, but only
+        // the ones that can accept the leading byte are attempted at all
+        const uint8_t lead = s_LeadTable[static_cast<uint8_t>(text.front())];
+
+        if (lead & LEAD_STRING)
+            if (auto lexeme = ScanToken<LexerScanner::STRING, StringToken>(text)) { return lexeme.value(); }
+        if (lead & LEAD_NUMBER)
+            if (auto lexeme = ScanToken<LexerScanner::NUMBER, NumberToken>(text)) { return lexeme.value(); }
+        if (lead & LEAD_OPERATOR)
+            if (auto lexeme = ScanToken<LexerScanner::OPERATOR, OperatorToken>(text)) { return lexeme.value(); }
+        if (lead & LEAD_KEYWORD)
+            if (auto lexeme = ScanToken<LexerScanner::KEYWORD, KeywordToken>(text)) { return lexeme.value(); }
+        if (lead & LEAD_PUNCTUATION)
+            if (auto lexeme = ScanToken<LexerScanner::PUNCTUATION, PunctuationToken>(text)) { return lexeme.value(); }
+        if (lead & LEAD_SYMBOL)
+            if (auto lexeme = ScanToken<LexerScanner::SYMBOL, SymbolToken>(text)) { return lexeme.value(); }
+
+        return Lexeme{ TokenKind::INVALID, 0U, false, 0U };
+    }
+
+    Lexeme CommitLexeme(const Lexeme& lexeme, const std::string_view& text)
+    {
+        if (lexeme.kind != TokenKind::SYMBOL)
+            return lexeme;
+
+        Lexeme committed = lexeme;
+        committed.payload = Interner::Global().Intern(text.substr(0, lexeme.length));
+        return committed;
+    }
+
+    size_t GapLength(const std::string_view& text)
+    {
+        return SpanBlanks(text);
+    }
+} // namespace Aesthetic
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include "token.hpp"
+
+namespace Aesthetic
+{
+    // How many bytes past the start of a token a scanner may inspect without
+    // consuming them. A token is only final once the text extends this far
+    // beyond its end, which is what chunked lexers have to wait for.
+    constexpr size_t MaxLookahead()
+    {
+        size_t result = 1UL;
+        for (const auto& representation: OperatorToken::representations)
+            result = std::max(result, representation.size());
+        for (const auto& representation: PunctuationToken::representations)
+            result = std::max(result, representation.size());
+        // Whether a symbol or keyword goes on depends on a whole UTF-8 sequence
+        return std::max(result, 4UL);
+    }
+
+    // Recognizes the token at the very front of `text`. Scanning has no
+    // side effects, lookahead and speculation may scan the same text again.
+    Lexeme ScanLexeme(const std::string_view& text);
+    // The lexeme scanned at the front of `text` as it goes into the tokens:
+    // with the name of a symbol interned
+    Lexeme CommitLexeme(const Lexeme& lexeme, const std::string_view& text);
+    // Number of blank bytes at the front of `text`
+    size_t GapLength(const std::string_view& text);
+} // namespace Aesthetic
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+
+#include "stream_lexer.hpp"
+#include "scanner.hpp"
+
+namespace Aesthetic
+{
+    StreamLexer::StreamLexer(std::istream& input, size_t chunkSize)
+        : m_Input(&input), m_Descriptor(-1), m_ChunkSize(std::max(chunkSize, MaxLookahead())),
+          m_Buffer(m_ChunkSize), m_Begin(0UL), m_End(0UL), m_Offset(0UL),
+          m_CurrentPosition(1, 1), m_Exhausted(false), m_Finished(false), m_Error(0) {}
+
+    StreamLexer::StreamLexer(int descriptor, size_t chunkSize)
+        : m_Input(nullptr), m_Descriptor(descriptor), m_ChunkSize(std::max(chunkSize, MaxLookahead())),
+          m_Buffer(m_ChunkSize), m_Begin(0UL), m_End(0UL), m_Offset(0UL),
+          m_CurrentPosition(1, 1), m_Exhausted(false), m_Finished(false), m_Error(0) {}
+
+    std::optional<StreamToken> StreamLexer::Next()
+    {
+        if (m_Finished)
+            return std::nullopt;
+
+        while (true)
+        {
+            const size_t spaces = GapLength(Window());
+            Consume(spaces);
+
+            // Whatever was read of the token the input failed in is dropped
+            if (m_Error)
+            {
+                m_Finished = true;
+                return StreamToken{ TokenKind::INVALID, 0U, false, m_Offset, m_CurrentPosition, 0U, std::string_view() };
+            }
+
+            std::string_view window = Window();
+            if (window.empty() && !m_Exhausted)
+            {
+                Refill();
+                continue;
+            }
+
+            const Lexeme lexeme = ScanLexeme(window);
+
+            // The token, or the decision between it and a longer one, may
+            // depend on bytes that are not read yet. The window at least
+            // doubles, so a long token is not rescanned once per chunk.
+            if (!m_Exhausted && lexeme.length + MaxLookahead() > window.size())
+            {
+                Refill(window.size());
+                continue;
+            }
+
+            // Refills scanned the token before, only now is it final
+            const Lexeme committed = CommitLexeme(lexeme, window);
+            StreamToken token{
+                committed.kind,
+                committed.subtype,
+                committed.valid,
+                m_Offset,
+                m_CurrentPosition,
+                committed.payload,
+                window.substr(0, committed.length)
+            };
+            Consume(lexeme.length);
+
+            if (!lexeme.valid || lexeme.kind == TokenKind::END_OF_FILE)
+                m_Finished = true;
+
+            return token;
+        }
+    }
+
+    std::string_view StreamLexer::Window() const
+    {
+        return std::string_view(m_Buffer.data() + m_Begin, m_End - m_Begin);
+    }
+
+    void StreamLexer::Consume(size_t length)
+    {
+        m_CurrentPosition += Position(Window().substr(0, length));
+        m_Begin += length;
+        m_Offset += length;
+    }
+
+    void StreamLexer::Refill(size_t room)
+    {
+        // Keep the unconsumed tail and make room for at least one more chunk,
+        // the buffer only outgrows the chunk size for tokens longer than it
+        const size_t left = m_End - m_Begin;
+        if (m_Begin)
+            std::memmove(m_Buffer.data(), m_Buffer.data() + m_Begin, left);
+        m_Begin = 0UL;
+        m_End = left;
+
+        const size_t wanted = std::max(room, m_ChunkSize);
+        if (m_Buffer.size() - m_End < wanted)
+            m_Buffer.resize(m_End + wanted);
+
+        const std::optional<size_t> read = Read(m_Buffer.data() + m_End, m_Buffer.size() - m_End);
+        m_End += read.value_or(0UL);
+
+        if (!read.value_or(0UL))
+            m_Exhausted = true;
+    }
+
+    std::optional<size_t> StreamLexer::Read(char* destination, size_t size)
+    {
+        if (m_Input)
+        {
+            m_Input->read(destination, static_cast<std::streamsize>(size));
+            // Streams keep no errno, badbit is all there is
+            if (m_Input->bad())
+            {
+                m_Error = EIO;
+                return std::nullopt;
+            }
+            return static_cast<size_t>(m_Input->gcount());
+        }
+
+        while (true)
+        {
+            const ssize_t read = ::read(m_Descriptor, destination, size);
+            if (read >= 0)
+                return static_cast<size_t>(read);
+            if (errno != EINTR)
+            {
+                m_Error = errno;
+                return std::nullopt;
+            }
+        }
+    }
+} // namespace Aesthetic
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "token.hpp"
+
+namespace Aesthetic
+{
+    struct StreamToken
+    {
+        TokenKind kind;
+        uint8_t subtype;
+        bool valid;
+        uint64_t offset;
+        Position pos;
+        uint64_t payload;
+        // Points into the lexer's window, only valid until the next token is pulled
+        std::string_view text;
+    };
+
+    // Lexes an input of unbounded size with a fixed-size window. Tokens are
+    // pulled one at a time, so memory stays at the window size plus twice
+    // the longest single token no matter how long the input is.
+    class StreamLexer
+    {
+    public:
+        static constexpr size_t s_DefaultChunkSize = 64UL * 1024UL;
+
+        class Iterator
+        {
+        private:
+            StreamLexer* m_Lexer;
+            std::optional<StreamToken> m_Token;
+        public:
+            Iterator() : m_Lexer(nullptr) {}
+            Iterator(StreamLexer& lexer) : m_Lexer(&lexer), m_Token(lexer.Next()) {}
+
+            const StreamToken& operator*() const { return m_Token.value(); }
+            const StreamToken* operator->() const { return &m_Token.value(); }
+            Iterator& operator++() { m_Token = m_Lexer->Next(); return *this; }
+            bool operator==(const Iterator& other) const { return !m_Token && !other.m_Token; }
+        };
+    private:
+        std::istream* m_Input;
+        int m_Descriptor;
+        size_t m_ChunkSize;
+        std::vector<char> m_Buffer;
+        size_t m_Begin;
+        size_t m_End;
+        uint64_t m_Offset;
+        Position m_CurrentPosition;
+        bool m_Exhausted;
+        bool m_Finished;
+        int m_Error;
+    public:
+        StreamLexer(std::istream& input, size_t chunkSize = s_DefaultChunkSize);
+        StreamLexer(int descriptor, size_t chunkSize = s_DefaultChunkSize);
+
+        StreamLexer(const StreamLexer&) = delete;
+        StreamLexer& operator=(const StreamLexer&) = delete;
+
+        // Next token of the input, the last one is the EOF or the first
+        // invalid token. Returns nothing once that one was handed out.
+        std::optional<StreamToken> Next();
+        // errno of the read that failed, the invalid token handed out last
+        // stands for it. 0 if the input was read to its end.
+        int Error() const { return m_Error; }
+
+        Iterator begin() { return Iterator(*this); }
+        Iterator end() { return Iterator(); }
+    private:
+        std::string_view Window() const;
+        void Consume(size_t length);
+        // Reads once, into room for a chunk or `room` bytes if that is more
+        void Refill(size_t room = 0UL);
+        // Nothing once the input failed, m_Error tells why
+        std::optional<size_t> Read(char* destination, size_t size);
+    };
+} // namespace Aesthetic
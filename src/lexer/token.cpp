@@ -1,10 +1,18 @@
 #include <array>
-#include <functional>
 #include <algorithm>
-#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 #include "token.hpp"
+#include "matcher.hpp"
+#include "kernels.hpp"
+#include "unicode.hpp"
+#include "util/interner.hpp"
 
 namespace Aesthetic
 {
@@ -20,31 +28,21 @@ namespace Aesthetic
         return T::representations.at(static_cast<size_t>(type)).length();
     }
 
-    template<typename T, typename U>
-    requires requires(T t, U u)
+    template<typename T, typename U, typename Check>
+    requires requires(T t, U u, const std::string_view& sv, const HardTokenMatch<U>& match, Check check)
     {
         T::representations;
+        { check(sv, match) } -> std::same_as<bool>;
     }
-    std::optional<std::shared_ptr<T>> FindHardToken(
-        const std::string_view& text,
-        const Position& pos,
-        std::function<bool (const std::string_view&, const std::string&)>&& check
-    )
-    {
-        std::array tmp = T::representations;
-        std::sort(tmp.begin(), tmp.end(), std::greater<const std::string&>());
-
-        for (auto& start: tmp)
-            if (check(text, start))
-                return std::make_shared<T>(
-                    pos,
-                    static_cast<U>(std::find(
-                            T::representations.begin(),
-                            T::representations.end(),
-                            start
-                        ) - T::representations.begin()
-                    )
-                );
+    std::optional<Lexeme> ScanHardToken(const std::string_view& text, TokenKind kind, Check&& check)
+    {
+        if (auto match = HardTokenMatcher<T::representations, U>::Find(text); match && check(text, match.value()))
+            return Lexeme{
+                kind,
+                static_cast<uint8_t>(match->type),
+                true,
+                static_cast<uint32_t>(match->length)
+            };
 
         return std::nullopt;
     }
@@ -53,9 +51,10 @@ namespace Aesthetic
     Position::Position(size_t line, size_t column)
          : line(line), col(column) {}
 
+    // Columns count code points, not bytes
     Position::Position(std::string_view contents)
         : line(std::ranges::count(contents, '\n')),
-          col(contents.size() - std::max(contents.rfind('\n'), contents.rfind("\r\n"))) {}
+          col(line ? CountCodePoints(contents.substr(contents.rfind('\n') + 1UL)) + 1UL : CountCodePoints(contents)) {}
 
     Position Position::operator+(const Position& other)
     {
@@ -108,10 +107,10 @@ namespace Aesthetic
     EndOfFileToken::EndOfFileToken(Position pos)
         : BasicToken(true, pos, 0) {}
 
-    std::optional<EOFTokenRef> EndOfFileToken::Find(const std::string_view& text, const Position& pos)
+    std::optional<Lexeme> EndOfFileToken::Scan(const std::string_view& text)
     {
         if (text.empty())
-            return std::make_shared<EndOfFileToken>(pos);
+            return Lexeme{ TokenKind::END_OF_FILE, 0U, true, 0U };
         
         return std::nullopt;
     }
@@ -125,10 +124,6 @@ namespace Aesthetic
     }
 
 
-    const std::array<std::string, 12UL> OperatorToken::representations  = {
-        "+"s, "-"s, "*"s, "/"s, "//"s, "="s, "::="s, ":="s, "///"s, "~>"s, "!!"s, "~!"s
-    };
-
     OperatorToken::OperatorToken(Position pos, OperationType type)
         : BasicToken(true, pos, OperationTypeToLength(type)), type(type) {}
 
@@ -137,11 +132,11 @@ namespace Aesthetic
         return TTypeToLength<OperatorToken, OperationType>(type);
     }
 
-    std::optional<OperatorTokenRef> OperatorToken::Find(const std::string_view& text, const Position& pos)
+    std::optional<Lexeme> OperatorToken::Scan(const std::string_view& text)
     {
-        return FindHardToken<OperatorToken, OperationType>(text, pos,
-            [](const std::string_view& text, const std::string& start) -> bool {
-                return text.starts_with(start);
+        return ScanHardToken<OperatorToken, OperationType>(text, TokenKind::OPERATOR,
+            [](const std::string_view&, const HardTokenMatch<OperationType>&) -> bool {
+                return true;
             }
         );
     }
@@ -156,10 +151,6 @@ namespace Aesthetic
     }
 
 
-    const std::array<std::string, 5UL> KeywordToken::representations = {
-        "if", "when", "whenever", "exist", "on"
-    };
-
     KeywordToken::KeywordToken(Position pos, KeywordType type)
         : BasicToken(true, pos, KeywordTypeToLength(type)), type(type) {}
 
@@ -168,14 +159,11 @@ namespace Aesthetic
         return TTypeToLength<KeywordToken, KeywordType>(type);
     }
 
-    std::optional<KeywordTokenRef> KeywordToken::Find(const std::string_view& text, const Position& pos)
+    std::optional<Lexeme> KeywordToken::Scan(const std::string_view& text)
     {
-        return FindHardToken<KeywordToken, KeywordType>(text, pos,
-            [](const std::string_view& text, const std::string& start) -> bool {
-                return text.starts_with(start) && (
-                    text.size() == start.size()
-                    || !SymbolToken::Symbolic(text.at(start.size()))
-                );
+        return ScanHardToken<KeywordToken, KeywordType>(text, TokenKind::KEYWORD,
+            [](const std::string_view& text, const HardTokenMatch<KeywordType>& match) -> bool {
+                return !SymbolToken::ContinueLength(text.substr(match.length));
             }
         );
     }
@@ -190,10 +178,6 @@ namespace Aesthetic
     }
 
 
-    const std::array<std::string, 11UL> PunctuationToken::representations = {
-        ";"s, "{"s, "}"s, "("s, ")"s, "["s, "]"s, ","s, "."s, "\n"s, ":"s
-    };
-
     PunctuationToken::PunctuationToken(Position pos, PunctuationType type)
         : BasicToken(true, pos, Position(
             type == PunctuationType::LINE_END,
@@ -205,14 +189,13 @@ namespace Aesthetic
         return TTypeToLength<PunctuationToken, PunctuationType>(type);
     }
 
-    std::optional<PunctuationTokenRef> PunctuationToken::Find(const std::string_view& text, const Position& pos)
+    std::optional<Lexeme> PunctuationToken::Scan(const std::string_view& text)
     {
-        return FindHardToken<PunctuationToken, PunctuationType>(text, pos,
-            [](const std::string_view& text, const std::string& start) {
-                if (start == "."s)
-                    return text.starts_with('.')
-                        && (text.length() == 1 || !NumberToken::IsDigit(text[1], NumberLiteralType::DEC));
-                return text.starts_with(start);
+        return ScanHardToken<PunctuationToken, PunctuationType>(text, TokenKind::PUNCTUATION,
+            [](const std::string_view& text, const HardTokenMatch<PunctuationType>& match) -> bool {
+                if (match.type == PunctuationType::DOT)
+                    return text.length() == 1 || !NumberToken::IsDigit(text[1], NumberLiteralType::DEC);
+                return true;
             }
         );
     }
@@ -222,36 +205,43 @@ namespace Aesthetic
         std::stringstream stream;
         stream << "PunctuationToken";
         CommonString(stream);
-        const std::string& value = representations[static_cast<size_t>(type)];
+        std::string_view value = representations[static_cast<size_t>(type)];
         stream << " `" << (value == "\n"s ? "\\n" : value) << '`';
         return stream.str();
     }
 
 
-    SymbolToken::SymbolToken(Position pos, std::string_view contents)
-        : BasicToken(true, pos, contents), contents(contents) {}
+    SymbolToken::SymbolToken(Position pos, std::string_view contents, uint32_t symbol)
+        : BasicToken(true, pos, contents), contents(contents), symbol(symbol) {}
 
-    bool SymbolToken::StartSymbolic(const char& sym)
+    size_t SymbolToken::ContinueLength(std::string_view text)
     {
-        return std::isalpha(sym) || sym == '_';
-    }
+        if (text.empty())
+            return 0UL;
+        if (static_cast<uint8_t>(text.front()) < 0x80U)
+            return Symbolic(text.front());
 
-    bool SymbolToken::Symbolic(const char& sym)
-    {
-        return std::isalnum(sym) || sym == '_';
+        const CodePoint code = DecodeUtf8(text);
+        return code.length && IsXidContinue(code.value) ? code.length : 0UL;
     }
 
-    std::optional<SymbolTokenRef> SymbolToken::Find(const std::string_view& text, const Position& pos)
+    std::optional<Lexeme> SymbolToken::Scan(const std::string_view& text)
     {
-        if (text.empty() || !text.front())
-            return std::nullopt;
-        
-        auto x = std::find_if_not(text.begin(), text.end(), Symbolic);
+        size_t length = SpanSymbolic(text);
 
-        if (x != text.end() && x != text.begin())
-            return std::make_shared<SymbolToken>(
-                pos, std::string_view(text.begin(), x)
-            );
+        // ASCII names end at a byte below 0x80, anything else is decoded
+        // and classified one code point at a time
+        while (length < text.size() && static_cast<uint8_t>(text[length]) >= 0x80U)
+        {
+            const CodePoint code = DecodeUtf8(text.substr(length));
+            if (!code.length || !(length ? IsXidContinue(code.value) : IsXidStart(code.value)))
+                break;
+            length += code.length;
+            length += SpanSymbolic(text.substr(length));
+        }
+
+        if (length)
+            return Lexeme{ TokenKind::SYMBOL, 0U, true, static_cast<uint32_t>(length), Interner::s_NoSymbol };
         
         return std::nullopt;
     }
@@ -267,7 +257,7 @@ namespace Aesthetic
 
 
     ValueToken::ValueToken(bool valid, Position pos, std::string_view contents)
-        : BasicToken(valid, pos, contents.length()), contents(contents) {}
+        : BasicToken(valid, pos, Position(contents)), contents(contents) {}
     
     void ValueToken::CommonString(std::ostream& out) const
     {
@@ -286,24 +276,114 @@ namespace Aesthetic
     StringToken::StringToken(bool valid, Position pos, std::string_view contents, size_t length)
         : ValueToken(valid, pos, contents), stringLength(length) {}
     
-    bool StringToken::StringBound(const char& sym)
+    std::optional<Lexeme> StringToken::Scan(const std::string_view& text)
     {
-        return sym == '\'' || sym == '"';
+        if (text.empty() || !StringBound(text[0]))
+            return std::nullopt;
+
+        // The body kernel stops at quotes and backslashes, escapes are only
+        // checked here and decoded when the value is first asked for
+        StringLiteralType type = StringLiteralType::PLAIN;
+        size_t end = 1UL;
+        bool escapesValid = true;
+        while (true)
+        {
+            end += SpanStringBody(text.substr(end));
+            if (end == text.size() || text[end] != '\\')
+                break;
+
+            type = StringLiteralType::ESCAPED;
+            const size_t escape = EscapeLength(text.substr(end));
+            if (!escape)
+            {
+                escapesValid = false;
+                break;
+            }
+            end += escape;
+        }
+        const uint8_t subtype = static_cast<uint8_t>(type);
+
+        // Valid UTF-8 only, a string with a bad byte ends at it like an
+        // unterminated one and is escaped only if it is before that byte.
+        // Pure ASCII bodies are the fast path.
+        const std::string_view contents = text.substr(1, end - 1UL);
+        if (SpanAscii(contents) != contents.size())
+        {
+            if (const size_t valid = ValidUtf8Prefix(contents); valid != contents.size())
+            {
+                const bool escaped = contents.substr(0UL, valid).find('\\') != std::string_view::npos;
+                return Lexeme{ TokenKind::STRING, static_cast<uint8_t>(escaped ? StringLiteralType::ESCAPED : StringLiteralType::PLAIN),
+                               false, static_cast<uint32_t>(valid + 1) };
+            }
+        }
+
+        // A bad escape ends the string right behind its backslash
+        if (!escapesValid)
+            return Lexeme{ TokenKind::STRING, subtype, false, static_cast<uint32_t>(end + 1) };
+
+        if (end < text.size())
+            return Lexeme{ TokenKind::STRING, subtype, true, static_cast<uint32_t>(end + 1) };
+
+        return Lexeme{ TokenKind::STRING, subtype, false, static_cast<uint32_t>(text.length()) };
     }
 
-    std::optional<StringTokenRef> StringToken::Find(const std::string_view& text, const Position& pos)
+    size_t StringToken::EscapeLength(std::string_view text)
     {
-        if (text.empty() || !StringBound(text[0]))
-            return std::nullopt;
-        
-        auto x = std::find_if(text.begin() + 1, text.end(), StringBound);
+        if (text.size() < 2UL)
+            return 0UL;
 
-        if (x != text.end())
-            return std::make_shared<StringToken>(
-                true, pos, std::string_view(text.begin(), x + 1), x - text.begin() - 2
-            );
+        if (escapes.find(text[1]) != std::string_view::npos)
+            return 2UL;
+        if (text[1] != 'u' || text.size() < 4UL || text[2] != '{')
+            return 0UL;
 
-        return std::make_shared<StringToken>(false, pos, text, text.length() - 1);
+        size_t i = 3UL;
+        while (i < text.size() && i < 9UL && NumberToken::IsDigit(text[i], NumberLiteralType::HEX))
+            i++;
+        if (i == 3UL || i == text.size() || text[i] != '}')
+            return 0UL;
+
+        uint32_t value = 0U;
+        std::from_chars(text.data() + 3UL, text.data() + i, value, 16);
+        if ((value >= 0xD800U && value <= 0xDFFFU) || value > 0x10FFFFU)
+            return 0UL;
+        return i + 1UL;
+    }
+
+    void StringToken::Decode(std::string_view contents, std::pmr::string& out)
+    {
+        out.reserve(out.size() + contents.size());
+        for (size_t i = 0UL; i < contents.size();)
+        {
+            const size_t escape = contents.find('\\', i);
+            out.append(contents.substr(i, escape - i));
+            if (escape == std::string_view::npos)
+                break;
+
+            const char kind = contents[escape + 1UL];
+            switch (kind)
+            {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case '0': out += '\0'; break;
+            case 'u':
+            {
+                const size_t close = contents.find('}', escape);
+                uint32_t value = 0U;
+                std::from_chars(contents.data() + escape + 3UL, contents.data() + close, value, 16);
+
+                char encoded[4];
+                out.append(encoded, EncodeUtf8(value, encoded));
+                i = close + 1UL;
+                continue;
+            }
+            default:
+                out += kind;
+                break;
+            }
+            i = escape + 2UL;
+        }
     }
 
     std::string StringToken::ToString() const
@@ -328,6 +408,135 @@ namespace Aesthetic
         return std::nullopt;
     }
 
+    std::optional<Lexeme> NumberToken::Scan(const std::string_view& text)
+    {
+        NumberLiteralType literalType = NumberToken::FindPrefix(text).value_or(NumberLiteralType::DEC);
+        auto lexeme = [literalType](TokenKind kind, bool valid, size_t length, uint64_t payload = 0U) {
+            return Lexeme{ kind, static_cast<uint8_t>(literalType), valid, static_cast<uint32_t>(length), payload };
+        };
+
+        const size_t start = (literalType != NumberLiteralType::DEC) * 2;
+        const size_t decimal = start + SpanDigits(text.substr(start), literalType);
+
+        if (decimal < text.size() && text[decimal] == '.')
+        {
+            const size_t fractional = decimal + 1 + SpanDigits(text.substr(decimal + 1), literalType);
+
+            if (fractional - decimal == 1 && decimal == 0)
+                return std::nullopt;
+
+            const std::string_view digits = text.substr(start, fractional - start);
+            const std::optional<double> value = DecodeFloatingPoint(digits, decimal - start, literalType);
+
+            uint64_t bits = 0U;
+            if (value)
+                std::memcpy(&bits, &value.value(), sizeof(bits));
+            return lexeme(TokenKind::FLOATING_POINT, value.has_value(), fractional, bits);
+        }
+
+        if (literalType != NumberLiteralType::DEC && decimal == start)
+            return lexeme(TokenKind::INTEGER, false, std::min(text.size(), 3UL));
+
+        if (decimal == 0)
+            return std::nullopt;
+
+        const std::optional<uint64_t> value = DecodeInteger(text.substr(start, decimal - start), literalType);
+        return lexeme(TokenKind::INTEGER, value.has_value(), decimal, value.value_or(0U));
+    }
+
+    // Bits per digit of the power of two bases
+    static constexpr unsigned DigitBits(NumberLiteralType type)
+    {
+        return type == NumberLiteralType::HEX ? 4U : type == NumberLiteralType::OCT ? 3U : 1U;
+    }
+
+    // Value of a digit the kernels accepted: '0'-'9' keep their low nibble,
+    // letters have bit 6 set and are shifted up by 9 from 'a'/'A' & 0xF == 1
+    static constexpr uint64_t DigitValue(char sym)
+    {
+        return static_cast<uint64_t>((sym & 0xF) + 9 * ((sym >> 6) & 1));
+    }
+
+    std::optional<uint64_t> NumberToken::DecodeInteger(std::string_view digits, NumberLiteralType type)
+    {
+        if (type == NumberLiteralType::DEC)
+        {
+            uint64_t value = 0U;
+            const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+            if (error != std::errc() || end != digits.data() + digits.size())
+                return std::nullopt;
+            return value;
+        }
+
+        // No branch per digit, bits shifted out of the top are collected
+        // and checked once at the end
+        const unsigned bits = DigitBits(type);
+        uint64_t value = 0U;
+        uint64_t lost = 0U;
+        for (const char sym : digits)
+        {
+            lost |= value >> (64U - bits);
+            value = value << bits | DigitValue(sym);
+        }
+
+        if (lost)
+            return std::nullopt;
+        return value;
+    }
+
+    std::optional<double> NumberToken::DecodeFloatingPoint(std::string_view digits, size_t point, NumberLiteralType type)
+    {
+        if (type == NumberLiteralType::DEC)
+        {
+            double value = 0.0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+            if (error != std::errc() || end != digits.data() + digits.size())
+                return std::nullopt;
+#else
+            // Without floating point from_chars, strtod needs a terminated copy
+            const std::string copy(digits);
+            char* end = nullptr;
+            errno = 0;
+            value = std::strtod(copy.c_str(), &end);
+            if (errno == ERANGE || end != copy.c_str() + copy.size())
+                return std::nullopt;
+#endif
+            return value;
+        }
+
+        // A prefix and a point without digits around it is no literal
+        if (digits.size() <= 1UL)
+            return std::nullopt;
+
+        // Power of two bases are exact: the digits form a mantissa that is
+        // scaled by the bits of the fractional digits. Digits that do not fit
+        // in 64 bits only raise the exponent, they are below double precision.
+        const unsigned bits = DigitBits(type);
+        uint64_t mantissa = 0U;
+        int exponent = 0;
+        for (size_t i = 0; i < digits.size(); i++)
+        {
+            if (i == point)
+                continue;
+
+            const bool fraction = i > point;
+            if (mantissa >> (64U - bits))
+            {
+                exponent += fraction ? 0 : static_cast<int>(bits);
+                continue;
+            }
+
+            mantissa = mantissa << bits | DigitValue(digits[i]);
+            exponent -= fraction ? static_cast<int>(bits) : 0;
+        }
+
+        const double value = std::ldexp(static_cast<double>(mantissa), exponent);
+        if (std::isinf(value))
+            return std::nullopt;
+        return value;
+    }
+
     void NumberToken::CommonString(std::ostream& out) const
     {
         ValueToken::CommonString(out);
@@ -358,112 +567,29 @@ namespace Aesthetic
         return stream.str();
     }
 
-    bool NumberToken::IsDigit(const char& sym, NumberLiteralType type)
-    {
-        switch (type)
-        {
-        case NumberLiteralType::BIN: return sym == '0' || sym == '1';
-        case NumberLiteralType::OCT: return '0' <= sym && sym <= '8';
-        case NumberLiteralType::DEC: return '0' <= sym && sym <= '9';
-        case NumberLiteralType::HEX:
-            return ('0' <= sym && sym <= '9')
-                || ('a' <= sym && sym <='f')
-                || ('A' <= sym && sym <= 'F');
-        }
-
-        return false;
-    }
-
-
-    FloatingPointToken::FloatingPointToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type)
-        : NumberToken(valid, pos, contents, type) {}
-
-    std::optional<FloatingPointTokenRef> FloatingPointToken::Find(const std::string_view& text, const Position& pos)
-    {
-        NumberLiteralType literalType = NumberToken::FindPrefix(text).value_or(NumberLiteralType::DEC);
-
-        auto decimal = std::find_if_not(
-            text.begin() + (literalType != NumberLiteralType::DEC) * 2,
-            text.end(),
-            [literalType](const char& sym){ return NumberToken::IsDigit(sym, literalType); }
-        );
-
-        if (decimal == text.end() || *decimal != '.')
-            return std::nullopt;
-        
-        auto fractional = std::find_if_not(
-            decimal + 1,
-            text.end(),
-            [literalType](const char& sym){ return NumberToken::IsDigit(sym, literalType); }
-        );
-
-        if ((fractional - decimal == 1) && !(decimal - text.begin()))
-        {
-            if (literalType != NumberLiteralType::DEC)
-                return std::make_shared<FloatingPointToken>(false, pos, std::string_view(
-                    text.begin(),
-                    text.begin() + (literalType != NumberLiteralType::DEC) * 2 + 1
-                ), literalType);
-            
-            return std::nullopt;
-        }
-
-        return std::make_shared<FloatingPointToken>(
-            true,
-            pos,
-            std::string_view(text.begin(), fractional),
-            literalType
-        );
 
-        return std::nullopt;
-    }
+    FloatingPointToken::FloatingPointToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type, double value)
+        : NumberToken(valid, pos, contents, type), value(value) {}
 
     std::string FloatingPointToken::ToString() const
     {
         std::stringstream stream;
         stream << "FloatingPointToken";
         CommonString(stream);
+        stream << " value " << value;
         return stream.str();
     }
 
 
-    IntegerToken::IntegerToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type)
-        : NumberToken(valid, pos, contents, type) {}
+    IntegerToken::IntegerToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type, uint64_t value)
+        : NumberToken(valid, pos, contents, type), value(value) {}
     
-    std::optional<IntegerTokenRef> IntegerToken::Find(const std::string_view& text, const Position& pos)
-    {
-        NumberLiteralType literalType = NumberToken::FindPrefix(text).value_or(NumberLiteralType::DEC);
-
-        auto number = std::find_if_not(
-            text.begin() + (literalType != NumberLiteralType::DEC) * 2,
-            text.end(),
-            [literalType](const char& sym){ return NumberToken::IsDigit(sym, literalType); }
-        );
-
-        if (literalType != NumberLiteralType::DEC && number == (text.begin() + 2))
-            return std::make_shared<IntegerToken>(
-                false,
-                pos,
-                std::string_view(text.begin(), text.begin() + 3),
-                literalType
-            );
-
-        if (number == text.begin())
-            return std::nullopt;
-        
-        return std::make_shared<IntegerToken>(
-            true,
-            pos,
-            std::string_view(text.begin(), number),
-            literalType
-        );
-    }
-
     std::string IntegerToken::ToString() const
     {
         std::stringstream stream;
         stream << "IntegerToken";
         CommonString(stream);
+        stream << " value " << value;
         return stream.str();
     }
 } // namespace Aesthetic
@@ -2,6 +2,7 @@
 
 #include <ostream>
 #include <cstddef>
+#include <cstdint>
 #include <string_view>
 #include <optional>
 #include <memory>
@@ -20,6 +21,13 @@ namespace Aesthetic
         DEC = 3UL,
     };
 
+    // Whether a string literal has to be decoded or is its source text
+    enum class StringLiteralType : size_t
+    {
+        PLAIN   = 0UL,
+        ESCAPED = 1UL,
+    };
+
     enum class OperationType : size_t
     {
         ADDITION         = 0UL,
@@ -34,6 +42,12 @@ namespace Aesthetic
         PIPE             = 9UL,
         DELETE           = 10UL,
         RECURSION_DELETE = 11UL,
+        LESS             = 12UL,
+        LESS_EQUAL       = 13UL,
+        GREATER          = 14UL,
+        GREATER_EQUAL    = 15UL,
+        EQUAL            = 16UL,
+        NOT_EQUAL        = 17UL,
     };
 
     enum class KeywordType : size_t
@@ -58,6 +72,36 @@ namespace Aesthetic
         DOT               = 8UL,
         LINE_END          = 9UL,
         COLON             = 10UL,
+        HASH              = 11UL,
+    };
+
+    enum class TokenKind : uint8_t
+    {
+        INVALID        = 0U,
+        END_OF_FILE    = 1U,
+        OPERATOR       = 2U,
+        KEYWORD        = 3U,
+        PUNCTUATION    = 4U,
+        SYMBOL         = 5U,
+        STRING         = 6U,
+        FLOATING_POINT = 7U,
+        INTEGER        = 8U,
+    };
+
+    // What a scanner recognised at the front of the text. `subtype` holds the
+    // OperationType, KeywordType, PunctuationType, NumberLiteralType or
+    // StringLiteralType of the token, `length` is the number of bytes it
+    // spans. `payload` carries what the scanner decoded on the way: the
+    // value of integers and the bits of the double of floating points.
+    // Symbols are only interned once a lexer commits to the token, see
+    // CommitLexeme(), until then their payload is Interner::s_NoSymbol.
+    struct Lexeme
+    {
+        TokenKind kind;
+        uint8_t subtype;
+        bool valid;
+        uint32_t length;
+        uint64_t payload = 0U;
     };
 
     struct Position
@@ -93,49 +137,56 @@ namespace Aesthetic
     {
         EndOfFileToken(Position pos);
 
-        static std::optional<std::shared_ptr<EndOfFileToken>> Find(const std::string_view& text, const Position& pos);
+        static std::optional<Lexeme> Scan(const std::string_view& text);
     private:
         std::string ToString() const;
     };
 
     struct OperatorToken : public BasicToken
     {
-        static const std::array<std::string, 12UL> representations;
+        static constexpr std::array<std::string_view, 18UL> representations = {
+            "+", "-", "*", "/", "//", "=", "::=", ":=", "///", "~>", "!!", "~!",
+            "<", "<=", ">", ">=", "==", "!="
+        };
 
         OperationType type;
 
         OperatorToken(Position pos, OperationType type);
 
         size_t OperationTypeToLength(OperationType type);
-        static std::optional<std::shared_ptr<OperatorToken>> Find(const std::string_view& text, const Position& pos);
+        static std::optional<Lexeme> Scan(const std::string_view& text);
     private:
         std::string ToString() const;
     };
     
     struct KeywordToken : public BasicToken
     {
-        static const std::array<std::string, 5UL> representations;
+        static constexpr std::array<std::string_view, 5UL> representations = {
+            "if", "when", "whenever", "exist", "on"
+        };
 
         KeywordType type;
 
         KeywordToken(Position pos, KeywordType type);
 
         size_t KeywordTypeToLength(KeywordType type);
-        static std::optional<std::shared_ptr<KeywordToken>> Find(const std::string_view& text, const Position& pos);
+        static std::optional<Lexeme> Scan(const std::string_view& text);
     private:
         std::string ToString() const;
     };
     
     struct PunctuationToken : public BasicToken
     {
-        static const std::array<std::string, 11UL> representations;
+        static constexpr std::array<std::string_view, 12UL> representations = {
+            ";", "{", "}", "(", ")", "[", "]", ",", ".", "\n", ":", "#"
+        };
 
         PunctuationType type;
 
         PunctuationToken(Position pos, PunctuationType type);
 
         size_t PunctuationTypeToLength(PunctuationType type);
-        static std::optional<std::shared_ptr<PunctuationToken>> Find(const std::string_view& text, const Position& pos);
+        static std::optional<Lexeme> Scan(const std::string_view& text);
     private:
         std::string ToString() const;
     };
@@ -143,12 +194,25 @@ namespace Aesthetic
     struct SymbolToken : public BasicToken
     {
         std::string_view contents;
+        uint32_t symbol;
+
+        SymbolToken(Position pos, std::string_view contents, uint32_t symbol);
+
+        // ASCII only, see ContinueLength() for the rest
+        static constexpr bool StartSymbolic(const char& sym)
+        {
+            return ('a' <= (sym | 0x20) && (sym | 0x20) <= 'z') || sym == '_';
+        }
 
-        SymbolToken(Position pos, std::string_view contents);
+        static constexpr bool Symbolic(const char& sym)
+        {
+            return StartSymbolic(sym) || ('0' <= sym && sym <= '9');
+        }
 
-        static bool StartSymbolic(const char& sym);
-        static bool Symbolic(const char& sym);
-        static std::optional<std::shared_ptr<SymbolToken>> Find(const std::string_view& text, const Position& pos);
+        // Bytes of the character at the front of `text` if it may continue
+        // a symbol: [A-Za-z0-9_] or a UTF-8 encoded XID_Continue code point
+        static size_t ContinueLength(std::string_view text);
+        static std::optional<Lexeme> Scan(const std::string_view& text);
     private:
         std::string ToString() const;
     };
@@ -170,8 +234,23 @@ namespace Aesthetic
 
         StringToken(bool valid, Position pos, std::string_view contents, size_t length);
 
-        static bool StringBound(const char& sym);
-        static std::optional<std::shared_ptr<StringToken>> Find(const std::string_view& text, const Position& pos);
+        // Characters that make a two byte escape after a backslash
+        static constexpr std::string_view escapes = "ntr0\\'\"";
+
+        static constexpr bool StringBound(const char& sym)
+        {
+            return sym == '\'' || sym == '"';
+        }
+
+        static std::optional<Lexeme> Scan(const std::string_view& text);
+
+        // Bytes of the escape at the front of `text`, which starts with a
+        // backslash, or zero if it is not one of \n \t \r \0 \\ \' \" and
+        // \u{X} with 1 to 6 hex digits naming a Unicode scalar value
+        static size_t EscapeLength(std::string_view text);
+        // Appends the value of the contents of an ESCAPED literal to `out`,
+        // the contents have to be lexed as a valid string
+        static void Decode(std::string_view contents, std::pmr::string& out);
     private:
         std::string ToString() const;
     };
@@ -180,9 +259,29 @@ namespace Aesthetic
     {
         NumberLiteralType type;
 
-        static bool IsDigit(const char& sym, NumberLiteralType type);
+        static constexpr bool IsDigit(const char& sym, NumberLiteralType type)
+        {
+            switch (type)
+            {
+            case NumberLiteralType::BIN: return sym == '0' || sym == '1';
+            case NumberLiteralType::OCT: return '0' <= sym && sym <= '7';
+            case NumberLiteralType::DEC: return '0' <= sym && sym <= '9';
+            case NumberLiteralType::HEX:
+                return ('0' <= sym && sym <= '9')
+                    || ('a' <= sym && sym <='f')
+                    || ('A' <= sym && sym <= 'F');
+            }
+
+            return false;
+        }
 
         static std::optional<NumberLiteralType> FindPrefix(const std::string_view& text);
+        static std::optional<Lexeme> Scan(const std::string_view& text);
+
+        // Value of the digits of a literal without prefix, nothing on overflow
+        static std::optional<uint64_t> DecodeInteger(std::string_view digits, NumberLiteralType type);
+        // Value of a literal without prefix, `point` is the index of its '.'
+        static std::optional<double> DecodeFloatingPoint(std::string_view digits, size_t point, NumberLiteralType type);
 
         NumberToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type);
     protected:
@@ -193,18 +292,18 @@ namespace Aesthetic
     
     struct FloatingPointToken : public NumberToken
     {
-        FloatingPointToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type);
+        double value;
 
-        static std::optional<std::shared_ptr<FloatingPointToken>> Find(const std::string_view& text, const Position& pos);
+        FloatingPointToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type, double value);
     private:
         std::string ToString() const;
     };
     
     struct IntegerToken : public NumberToken
     {
-        IntegerToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type);
+        uint64_t value;
 
-        static std::optional<std::shared_ptr<IntegerToken>> Find(const std::string_view& text, const Position& pos);
+        IntegerToken(bool valid, Position pos, std::string_view contents, NumberLiteralType type, uint64_t value);
     private:
         std::string ToString() const;
     };
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "token_stream.hpp"
+
+namespace Aesthetic
+{
+    template<typename T, typename... Args>
+    TokenRef MakeToken(std::pmr::memory_resource* resource, Args&&... args)
+    {
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource), std::forward<Args>(args)...);
+    }
+
+    TokenView::TokenView(const TokenStream& stream, size_t index)
+        : m_Stream(&stream), m_Index(index) {}
+
+    TokenKind TokenView::Kind() const { return m_Stream->Kind(m_Index); }
+    bool TokenView::Valid() const { return m_Stream->Valid(m_Index); }
+    uint32_t TokenView::Offset() const { return m_Stream->Offset(m_Index); }
+    uint32_t TokenView::Length() const { return m_Stream->Length(m_Index); }
+    Position TokenView::Pos() const { return m_Stream->Pos(m_Index); }
+    std::string_view TokenView::Text() const { return m_Stream->Text(m_Index); }
+
+    OperationType TokenView::Operation() const
+    {
+        return static_cast<OperationType>(m_Stream->Subtype(m_Index));
+    }
+
+    KeywordType TokenView::Keyword() const
+    {
+        return static_cast<KeywordType>(m_Stream->Subtype(m_Index));
+    }
+
+    PunctuationType TokenView::Punctuation() const
+    {
+        return static_cast<PunctuationType>(m_Stream->Subtype(m_Index));
+    }
+
+    NumberLiteralType TokenView::Literal() const
+    {
+        return static_cast<NumberLiteralType>(m_Stream->Subtype(m_Index));
+    }
+
+    std::string_view TokenView::StringContents() const
+    {
+        std::string_view text = Text();
+        text.remove_prefix(1);
+        if (Valid())
+            text.remove_suffix(1);
+        return text;
+    }
+
+    std::string_view TokenView::StringValue() const
+    {
+        return m_Stream->StringValue(m_Index);
+    }
+
+    SymbolId TokenView::Symbol() const
+    {
+        return static_cast<SymbolId>(m_Stream->Payload(m_Index));
+    }
+
+    uint64_t TokenView::Integer() const
+    {
+        return m_Stream->Payload(m_Index);
+    }
+
+    double TokenView::FloatingPoint() const
+    {
+        const uint64_t bits = m_Stream->Payload(m_Index);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    TokenRef TokenView::Ref() const { return m_Stream->Ref(m_Index); }
+
+
+    TokenStream::TokenStream(std::string_view source, std::pmr::memory_resource* resource)
+        : m_Source(source), m_Kinds(resource), m_Subtypes(resource), m_Flags(resource),
+          m_Offsets(resource), m_Lengths(resource), m_Payloads(resource), m_LineIndex(resource), m_Decoded(resource) {}
+
+    void TokenStream::Reserve(size_t count)
+    {
+        m_Kinds.reserve(count);
+        m_Subtypes.reserve(count);
+        m_Flags.reserve(count);
+        m_Offsets.reserve(count);
+        m_Lengths.reserve(count);
+        m_Payloads.reserve(count);
+    }
+
+    void TokenStream::Resize(size_t count)
+    {
+        m_Kinds.resize(count);
+        m_Subtypes.resize(count);
+        m_Flags.resize(count);
+        m_Offsets.resize(count);
+        m_Lengths.resize(count);
+        m_Payloads.resize(count);
+        // Clearing costs the buckets even when there is nothing in them
+        if (!m_Decoded.empty())
+            m_Decoded.clear();
+    }
+
+    TokenArrays TokenStream::Arrays() const
+    {
+        return TokenArrays{ m_Kinds, m_Subtypes, m_Flags, m_Offsets, m_Lengths, m_Payloads };
+    }
+
+    void TokenStream::Assign(const TokenArrays& arrays)
+    {
+        m_Kinds.assign(arrays.kinds.begin(), arrays.kinds.end());
+        m_Subtypes.assign(arrays.subtypes.begin(), arrays.subtypes.end());
+        m_Flags.assign(arrays.flags.begin(), arrays.flags.end());
+        m_Offsets.assign(arrays.offsets.begin(), arrays.offsets.end());
+        m_Lengths.assign(arrays.lengths.begin(), arrays.lengths.end());
+        m_Payloads.assign(arrays.payloads.begin(), arrays.payloads.end());
+        m_Decoded.clear();
+    }
+
+    void TokenStream::ResolveSymbols(std::span<const SymbolId> symbols)
+    {
+        for (size_t i = 0UL; i < m_Kinds.size(); i++)
+            if (m_Kinds[i] == TokenKind::SYMBOL)
+                m_Payloads[i] = symbols[m_Payloads[i]];
+    }
+
+    void TokenStream::InternSymbols(size_t first, size_t last)
+    {
+        Interner& interner = Interner::Global();
+        for (size_t i = first; i < last; i++)
+            if (m_Kinds[i] == TokenKind::SYMBOL)
+                m_Payloads[i] = interner.Intern(Text(i));
+    }
+
+    void TokenStream::Place(size_t at, const TokenStream& other, size_t first, size_t last)
+    {
+        std::copy(other.m_Kinds.begin() + first, other.m_Kinds.begin() + last, m_Kinds.begin() + at);
+        std::copy(other.m_Subtypes.begin() + first, other.m_Subtypes.begin() + last, m_Subtypes.begin() + at);
+        std::copy(other.m_Flags.begin() + first, other.m_Flags.begin() + last, m_Flags.begin() + at);
+        std::copy(other.m_Offsets.begin() + first, other.m_Offsets.begin() + last, m_Offsets.begin() + at);
+        std::copy(other.m_Lengths.begin() + first, other.m_Lengths.begin() + last, m_Lengths.begin() + at);
+        std::copy(other.m_Payloads.begin() + first, other.m_Payloads.begin() + last, m_Payloads.begin() + at);
+    }
+
+    void TokenStream::Rebind(std::string_view source)
+    {
+        m_Source = source;
+        m_LineIndex.Clear();
+        if (!m_Decoded.empty())
+            m_Decoded.clear();
+    }
+
+    std::string_view TokenStream::StringValue(size_t index) const
+    {
+        const std::string_view contents = TokenView(*this, index).StringContents();
+        if (static_cast<StringLiteralType>(m_Subtypes[index]) != StringLiteralType::ESCAPED || !Valid(index))
+            return contents;
+
+        const auto [decoded, inserted] = m_Decoded.try_emplace(static_cast<uint32_t>(index));
+        if (inserted)
+            StringToken::Decode(contents, decoded->second);
+        return decoded->second;
+    }
+
+    const LineIndex& TokenStream::Index() const
+    {
+        if (!m_LineIndex.Built())
+            m_LineIndex.Build(m_Source);
+        return m_LineIndex;
+    }
+
+    void TokenStream::Push(const Lexeme& lexeme, uint32_t offset)
+    {
+        m_Kinds.push_back(lexeme.kind);
+        m_Subtypes.push_back(lexeme.subtype);
+        m_Flags.push_back(lexeme.valid ? s_ValidFlag : 0U);
+        m_Offsets.push_back(offset);
+        m_Lengths.push_back(lexeme.length);
+        m_Payloads.push_back(lexeme.payload);
+    }
+
+    TokenRef TokenStream::Ref(size_t index) const
+    {
+        const TokenView token(*this, index);
+        const Position pos = token.Pos();
+        const bool valid = token.Valid();
+
+        switch (token.Kind())
+        {
+        case TokenKind::INVALID:
+            return MakeToken<Token>(Resource(), false, pos, 0UL);
+        case TokenKind::END_OF_FILE:
+            return MakeToken<EOFToken>(Resource(), pos);
+        case TokenKind::OPERATOR:
+            return MakeToken<OperatorToken>(Resource(), pos, token.Operation());
+        case TokenKind::KEYWORD:
+            return MakeToken<KeywordToken>(Resource(), pos, token.Keyword());
+        case TokenKind::PUNCTUATION:
+            return MakeToken<PunctuationToken>(Resource(), pos, token.Punctuation());
+        case TokenKind::SYMBOL:
+            return MakeToken<SymbolToken>(Resource(), pos, token.Text(), token.Symbol());
+        case TokenKind::STRING:
+            return MakeToken<StringToken>(Resource(), valid, pos, token.Text(), token.StringContents().size());
+        case TokenKind::FLOATING_POINT:
+            return MakeToken<FloatingPointToken>(Resource(), valid, pos, token.Text(), token.Literal(), token.FloatingPoint());
+        case TokenKind::INTEGER:
+            return MakeToken<IntegerToken>(Resource(), valid, pos, token.Text(), token.Literal(), token.Integer());
+        }
+
+        return MakeToken<Token>(Resource(), false, pos, 0UL);
+    }
+
+    std::pmr::vector<TokenRef> TokenStream::Refs() const
+    {
+        std::pmr::vector<TokenRef> result(Resource());
+        result.reserve(Size());
+
+        for (size_t i = 0; i < Size(); i++)
+            result.push_back(Ref(i));
+
+        return result;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "token.hpp"
+#include "line_index.hpp"
+#include "util/interner.hpp"
+
+namespace Aesthetic
+{
+    class TokenStream;
+
+    // Cheap handle to a single token of a TokenStream, giving typed access to
+    // the data the BasicToken hierarchy used to carry
+    class TokenView
+    {
+    private:
+        const TokenStream* m_Stream;
+        size_t m_Index;
+    public:
+        TokenView(const TokenStream& stream, size_t index);
+
+        size_t Index() const { return m_Index; }
+        TokenKind Kind() const;
+        bool Is(TokenKind kind) const { return Kind() == kind; }
+        bool Valid() const;
+        uint32_t Offset() const;
+        uint32_t Length() const;
+        Position Pos() const;
+        std::string_view Text() const;
+
+        OperationType Operation() const;
+        KeywordType Keyword() const;
+        PunctuationType Punctuation() const;
+        NumberLiteralType Literal() const;
+        // Interned ID of a symbol's name
+        SymbolId Symbol() const;
+        // Values decoded from number literals
+        uint64_t Integer() const;
+        double FloatingPoint() const;
+        // Contents of a string literal without its quotes, as in the source
+        std::string_view StringContents() const;
+        // What a string literal stands for, its contents with the escapes decoded
+        std::string_view StringValue() const;
+
+        TokenRef Ref() const;
+    };
+
+    // The parallel arrays of a TokenStream, all of the same size
+    struct TokenArrays
+    {
+        std::span<const TokenKind> kinds;
+        std::span<const uint8_t> subtypes;
+        std::span<const uint8_t> flags;
+        std::span<const uint32_t> offsets;
+        std::span<const uint32_t> lengths;
+        std::span<const uint64_t> payloads;
+    };
+
+    // Tokens of a single program, stored as parallel arrays: a token is just
+    // an index. The stream views the program text, it has to outlive it.
+    // Tokens only store byte offsets, the line index that turns them into
+    // positions is built on the first call to Pos(). That call must not race
+    // with others on the same stream, Index() the stream before sharing it.
+    // The same goes for StringValue(), which decodes escaped literals on
+    // first use and keeps the result until the tokens change.
+    class TokenStream
+    {
+    private:
+        static constexpr uint8_t s_ValidFlag = 1U << 0U;
+
+        std::string_view m_Source;
+        std::pmr::vector<TokenKind> m_Kinds;
+        std::pmr::vector<uint8_t> m_Subtypes;
+        std::pmr::vector<uint8_t> m_Flags;
+        std::pmr::vector<uint32_t> m_Offsets;
+        std::pmr::vector<uint32_t> m_Lengths;
+        std::pmr::vector<uint64_t> m_Payloads;
+        mutable LineIndex m_LineIndex;
+        // Values of the escaped string literals decoded so far, by token.
+        // Nodes never move, so views of the strings stay valid.
+        mutable std::pmr::unordered_map<uint32_t, std::pmr::string> m_Decoded;
+    public:
+        class Iterator
+        {
+        private:
+            const TokenStream* m_Stream;
+            size_t m_Index;
+        public:
+            Iterator(const TokenStream& stream, size_t index) : m_Stream(&stream), m_Index(index) {}
+
+            TokenView operator*() const { return TokenView(*m_Stream, m_Index); }
+            Iterator& operator++() { m_Index++; return *this; }
+            bool operator==(const Iterator& other) const { return m_Index == other.m_Index; }
+        };
+
+        TokenStream(std::string_view source,
+                    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void Reserve(size_t count);
+        void Resize(size_t count);
+        void Push(const Lexeme& lexeme, uint32_t offset);
+        // Copies tokens [first, last) of `other` over the tokens starting at
+        // `at`. Distinct ranges may be placed from different threads at once.
+        void Place(size_t at, const TokenStream& other, size_t first, size_t last);
+        // Points the stream at another text, the offsets have to fit it.
+        // Positions and decoded strings of the old text are dropped.
+        void Rebind(std::string_view source);
+
+        // Views of the arrays, valid until the stream changes
+        TokenArrays Arrays() const;
+        // Replaces all tokens with a copy of `arrays`
+        void Assign(const TokenArrays& arrays);
+        // For payloads of symbols that are indices into `symbols` rather
+        // than interned IDs, as stored on disk: makes them the IDs
+        void ResolveSymbols(std::span<const SymbolId> symbols);
+        // Interns the names of the symbols in [first, last) that were lexed
+        // without committing. Distinct ranges may be interned from different
+        // threads at once.
+        void InternSymbols(size_t first, size_t last);
+
+        // Builds the line index now rather than on the first Pos()
+        const LineIndex& Index() const;
+
+        std::string_view Source() const { return m_Source; }
+        std::pmr::memory_resource* Resource() const { return m_Kinds.get_allocator().resource(); }
+        size_t Size() const { return m_Kinds.size(); }
+        bool Empty() const { return m_Kinds.empty(); }
+
+        TokenKind Kind(size_t index) const { return m_Kinds[index]; }
+        uint8_t Subtype(size_t index) const { return m_Subtypes[index]; }
+        bool Valid(size_t index) const { return m_Flags[index] & s_ValidFlag; }
+        uint32_t Offset(size_t index) const { return m_Offsets[index]; }
+        uint32_t Length(size_t index) const { return m_Lengths[index]; }
+        Position Pos(size_t index) const { return Index().Locate(m_Source, m_Offsets[index]); }
+        uint64_t Payload(size_t index) const { return m_Payloads[index]; }
+        std::string_view Text(size_t index) const { return m_Source.substr(m_Offsets[index], m_Lengths[index]); }
+        // Literals without escapes are views of the source, the others are
+        // decoded into storage from the stream's memory resource
+        std::string_view StringValue(size_t index) const;
+
+        TokenView operator[](size_t index) const { return TokenView(*this, index); }
+        Iterator begin() const { return Iterator(*this, 0UL); }
+        Iterator end() const { return Iterator(*this, Size()); }
+
+        // Materializes the token as a BasicToken subclass, allocated from the
+        // same memory resource as the stream
+        TokenRef Ref(size_t index) const;
+        std::pmr::vector<TokenRef> Refs() const;
+    };
+} // namespace Aesthetic
@@ -0,0 +1,106 @@
+#include <algorithm>
+
+#include "unicode.hpp"
+#include "kernels.hpp"
+#include "xid_tables.hpp"
+
+namespace Aesthetic
+{
+    // Sequence length by lead byte, zero for continuation bytes and the
+    // leads 0xC0, 0xC1 and 0xF5 on that can only start invalid sequences
+    static constexpr uint8_t SequenceLength(uint8_t lead)
+    {
+        if (lead < 0x80U)
+            return 1U;
+        if (lead < 0xC2U)
+            return 0U;
+        if (lead < 0xE0U)
+            return 2U;
+        if (lead < 0xF0U)
+            return 3U;
+        if (lead < 0xF5U)
+            return 4U;
+        return 0U;
+    }
+
+    CodePoint DecodeUtf8(std::string_view text)
+    {
+        const uint8_t lead = static_cast<uint8_t>(text.front());
+        const uint32_t length = SequenceLength(lead);
+        if (!length || length > text.size())
+            return CodePoint{ 0U, 0U };
+        if (length == 1U)
+            return CodePoint{ lead, 1U };
+
+        char32_t value = lead & (0x7FU >> length);
+        for (uint32_t i = 1U; i < length; i++)
+        {
+            const uint8_t next = static_cast<uint8_t>(text[i]);
+            if ((next & 0xC0U) != 0x80U)
+                return CodePoint{ 0U, 0U };
+            value = value << 6U | (next & 0x3FU);
+        }
+
+        // The shortest encoding only, and no surrogates or values past Unicode
+        static constexpr char32_t s_Smallest[] = { 0U, 0U, 0x80U, 0x800U, 0x10000U };
+        if (value < s_Smallest[length] || (value >= 0xD800U && value <= 0xDFFFU) || value > 0x10FFFFU)
+            return CodePoint{ 0U, 0U };
+        return CodePoint{ value, length };
+    }
+
+    size_t EncodeUtf8(char32_t code, char* out)
+    {
+        if (code < 0x80U)
+        {
+            out[0] = static_cast<char>(code);
+            return 1UL;
+        }
+
+        const size_t length = code < 0x800U ? 2UL : code < 0x10000U ? 3UL : 4UL;
+        static constexpr uint8_t s_Leads[] = { 0U, 0U, 0xC0U, 0xE0U, 0xF0U };
+        for (size_t i = length - 1UL; i; i--, code >>= 6U)
+            out[i] = static_cast<char>(0x80U | (code & 0x3FU));
+        out[0] = static_cast<char>(s_Leads[length] | code);
+        return length;
+    }
+
+    size_t ValidUtf8Prefix(std::string_view text)
+    {
+        size_t i = 0UL;
+        while (true)
+        {
+            i += SpanAscii(text.substr(i));
+            if (i == text.size())
+                return i;
+
+            const CodePoint code = DecodeUtf8(text.substr(i));
+            if (!code.length)
+                return i;
+            i += code.length;
+        }
+    }
+
+    template<size_t N>
+    static bool InTable(const std::array<uint32_t, N>& table, char32_t code)
+    {
+        // The last entry starting at or before `code`
+        const uint32_t key = static_cast<uint32_t>(code) << s_XidCountBits | ((1U << s_XidCountBits) - 1U);
+        const auto it = std::upper_bound(table.begin(), table.end(), key);
+        if (it == table.begin())
+            return false;
+
+        const uint32_t entry = *(it - 1);
+        const char32_t first = entry >> s_XidCountBits;
+        return code - first <= (entry & ((1U << s_XidCountBits) - 1U));
+    }
+
+    bool IsXidStart(char32_t code)
+    {
+        return code >= 0x80U && InTable(s_XidStartRanges, code);
+    }
+
+    bool IsXidContinue(char32_t code)
+    {
+        return code >= 0x80U && InTable(s_XidContinueRanges, code);
+    }
+} // namespace Aesthetic
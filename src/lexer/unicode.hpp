@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Aesthetic
+{
+    // One decoded UTF-8 sequence, `length` is zero if the bytes are not
+    // valid UTF-8: truncated, overlong, a surrogate or above U+10FFFF
+    struct CodePoint
+    {
+        char32_t value;
+        uint32_t length;
+    };
+
+    // Decodes the sequence at the front of `text`, which must not be empty
+    CodePoint DecodeUtf8(std::string_view text);
+
+    // Writes the UTF-8 encoding of a valid code point to `out`, which must
+    // have room for 4 bytes, and returns its length
+    size_t EncodeUtf8(char32_t code, char* out);
+
+    // Length of the longest prefix of `text` that is valid UTF-8. ASCII
+    // runs are skipped 16 or 32 bytes at a time.
+    size_t ValidUtf8Prefix(std::string_view text);
+
+    // Identifier classes of UAX #31 for code points from 0x80 on, looked
+    // up in generated range tables. ASCII is up to the scanners.
+    bool IsXidStart(char32_t code);
+    bool IsXidContinue(char32_t code);
+} // namespace Aesthetic
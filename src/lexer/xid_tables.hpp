@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Generated by tools/generate_xid_tables.py from Unicode 14.0.0, do not edit
+
+namespace Aesthetic
+{
+    // Sorted code point ranges from 0x80 on, each entry is the first code
+    // point shifted left by 11 bits with the count less one below it
+    inline constexpr unsigned s_XidCountBits = 11U;
+
+    inline constexpr std::array<uint32_t, 702UL> s_XidStartRanges = {
+        0x00055000U, 0x0005A800U, 0x0005D000U, 0x00060016U, 0x0006C01EU, 0x0007C1C9U, 0x0016300BU, 0x00170004U,
+        0x00176000U, 0x00177000U, 0x001B8004U, 0x001BB001U, 0x001BD802U, 0x001BF800U, 0x001C3000U, 0x001C4002U,
+        0x001C6000U, 0x001C7013U, 0x001D1852U, 0x001FB88AU, 0x002450A5U, 0x00298825U, 0x002AC800U, 0x002B0028U,
+        0x002E801AU, 0x002F7803U, 0x0031002AU, 0x00337001U, 0x00338862U, 0x0036A800U, 0x00372801U, 0x00377001U,
+        0x0037D002U, 0x0037F800U, 0x00388000U, 0x0038901DU, 0x003A6858U, 0x003D8800U, 0x003E5020U, 0x003FA001U,
+        0x003FD000U, 0x00400015U, 0x0040D000U, 0x00412000U, 0x00414000U, 0x00420018U, 0x0043000AU, 0x00438017U,
+        0x00444805U, 0x00450029U, 0x00482035U, 0x0049E800U, 0x004A8000U, 0x004AC009U, 0x004B880FU, 0x004C2807U,
+        0x004C7801U, 0x004C9815U, 0x004D5006U, 0x004D9000U, 0x004DB003U, 0x004DE800U, 0x004E7000U, 0x004EE001U,
+        0x004EF802U, 0x004F8001U, 0x004FE000U, 0x00502805U, 0x00507801U, 0x00509815U, 0x00515006U, 0x00519001U,
+        0x0051A801U, 0x0051C001U, 0x0052C803U, 0x0052F000U, 0x00539002U, 0x00542808U, 0x00547802U, 0x00549815U,
+        0x00555006U, 0x00559001U, 0x0055A804U, 0x0055E800U, 0x00568000U, 0x00570001U, 0x0057C800U, 0x00582807U,
+        0x00587801U, 0x00589815U, 0x00595006U, 0x00599001U, 0x0059A804U, 0x0059E800U, 0x005AE001U, 0x005AF802U,
+        0x005B8800U, 0x005C1800U, 0x005C2805U, 0x005C7002U, 0x005C9003U, 0x005CC801U, 0x005CE000U, 0x005CF001U,
+        0x005D1801U, 0x005D4002U, 0x005D700BU, 0x005E8000U, 0x00602807U, 0x00607002U, 0x00609016U, 0x0061500FU,
+        0x0061E800U, 0x0062C002U, 0x0062E800U, 0x00630001U, 0x00640000U, 0x00642807U, 0x00647002U, 0x00649016U,
+        0x00655009U, 0x0065A804U, 0x0065E800U, 0x0066E801U, 0x00670001U, 0x00678801U, 0x00682008U, 0x00687002U,
+        0x00689028U, 0x0069E800U, 0x006A7000U, 0x006AA002U, 0x006AF802U, 0x006BD005U, 0x006C2811U, 0x006CD017U,
+        0x006D9808U, 0x006DE800U, 0x006E0006U, 0x0070082FU, 0x00719000U, 0x00720006U, 0x00740801U, 0x00742000U,
+        0x00743004U, 0x00746017U, 0x00752800U, 0x00753809U, 0x00759000U, 0x0075E800U, 0x00760004U, 0x00763000U,
+        0x0076E003U, 0x00780000U, 0x007A0007U, 0x007A4823U, 0x007C4004U, 0x0080002AU, 0x0081F800U, 0x00828005U,
+        0x0082D003U, 0x00830800U, 0x00832801U, 0x00837002U, 0x0083A80CU, 0x00847000U, 0x00850025U, 0x00863800U,
+        0x00866800U, 0x0086802AU, 0x0087E14CU, 0x00925003U, 0x00928006U, 0x0092C000U, 0x0092D003U, 0x00930028U,
+        0x00945003U, 0x00948020U, 0x00959003U, 0x0095C006U, 0x00960000U, 0x00961003U, 0x0096400EU, 0x0096C038U,
+        0x00989003U, 0x0098C042U, 0x009C000FU, 0x009D0055U, 0x009FC005U, 0x00A00A6BU, 0x00B37810U, 0x00B40819U,
+        0x00B5004AU, 0x00B7700AU, 0x00B80011U, 0x00B8F812U, 0x00BA0011U, 0x00BB000CU, 0x00BB7002U, 0x00BC0033U,
+        0x00BEB800U, 0x00BEE000U, 0x00C10058U, 0x00C40028U, 0x00C55000U, 0x00C58045U, 0x00C8001EU, 0x00CA801DU,
+        0x00CB8004U, 0x00CC002BU, 0x00CD8019U, 0x00D00016U, 0x00D10034U, 0x00D53800U, 0x00D8282EU, 0x00DA2807U,
+        0x00DC181DU, 0x00DD7001U, 0x00DDD02BU, 0x00E00023U, 0x00E26802U, 0x00E2D023U, 0x00E40008U, 0x00E4802AU,
+        0x00E5E802U, 0x00E74803U, 0x00E77005U, 0x00E7A801U, 0x00E7D000U, 0x00E800BFU, 0x00F00115U, 0x00F8C005U,
+        0x00F90025U, 0x00FA4005U, 0x00FA8007U, 0x00FAC800U, 0x00FAD800U, 0x00FAE800U, 0x00FAF81EU, 0x00FC0034U,
+        0x00FDB006U, 0x00FDF000U, 0x00FE1002U, 0x00FE3006U, 0x00FE8003U, 0x00FEB005U, 0x00FF000CU, 0x00FF9002U,
+        0x00FFB006U, 0x01038800U, 0x0103F800U, 0x0104800CU, 0x01081000U, 0x01083800U, 0x01085009U, 0x0108A800U,
+        0x0108C005U, 0x01092000U, 0x01093000U, 0x01094000U, 0x0109500FU, 0x0109E003U, 0x010A2804U, 0x010A7000U,
+        0x010B0028U, 0x016000E4U, 0x01675803U, 0x01679001U, 0x01680025U, 0x01693800U, 0x01696800U, 0x01698037U,
+        0x016B7800U, 0x016C0016U, 0x016D0006U, 0x016D4006U, 0x016D8006U, 0x016DC006U, 0x016E0006U, 0x016E4006U,
+        0x016E8006U, 0x016EC006U, 0x01802802U, 0x01810808U, 0x01818804U, 0x0181C004U, 0x01820855U, 0x0184E802U,
+        0x01850859U, 0x0187E003U, 0x0188282AU, 0x0189885DU, 0x018D001FU, 0x018F800FU, 0x01A007FFU, 0x01E007FFU,
+        0x022007FFU, 0x026001BFU, 0x027007FFU, 0x02B007FFU, 0x02F007FFU, 0x033007FFU, 0x037007FFU, 0x03B007FFU,
+        0x03F007FFU, 0x043007FFU, 0x047007FFU, 0x04B007FFU, 0x04F0068CU, 0x0526802DU, 0x0528010CU, 0x0530800FU,
+        0x05315001U, 0x0532002EU, 0x0533F81EU, 0x0535004FU, 0x0538B808U, 0x05391066U, 0x053C583FU, 0x053E8001U,
+        0x053E9800U, 0x053EA804U, 0x053F900FU, 0x05401802U, 0x05403803U, 0x05406016U, 0x05420033U, 0x05441031U,
+        0x05479005U, 0x0547D800U, 0x0547E801U, 0x0548501BU, 0x05498016U, 0x054B001CU, 0x054C202EU, 0x054E7800U,
+        0x054F0004U, 0x054F3009U, 0x054FD004U, 0x05500028U, 0x05520002U, 0x05522007U, 0x05530016U, 0x0553D000U,
+        0x0553F031U, 0x05558800U, 0x0555A801U, 0x0555C804U, 0x05560000U, 0x05561000U, 0x0556D802U, 0x0557000AU,
+        0x05579002U, 0x05580805U, 0x05584805U, 0x05588805U, 0x05590006U, 0x05594006U, 0x0559802AU, 0x055AE00DU,
+        0x055B8072U, 0x056007FFU, 0x05A007FFU, 0x05E007FFU, 0x062007FFU, 0x066007FFU, 0x06A003A3U, 0x06BD8016U,
+        0x06BE5830U, 0x07C8016DU, 0x07D38069U, 0x07D80006U, 0x07D89804U, 0x07D8E800U, 0x07D8F809U, 0x07D9500CU,
+        0x07D9C004U, 0x07D9F000U, 0x07DA0001U, 0x07DA1801U, 0x07DA306BU, 0x07DE988AU, 0x07E320D9U, 0x07EA803FU,
+        0x07EC9035U, 0x07EF8009U, 0x07F38800U, 0x07F39800U, 0x07F3B800U, 0x07F3C800U, 0x07F3D800U, 0x07F3E800U,
+        0x07F3F87DU, 0x07F90819U, 0x07FA0819U, 0x07FB3037U, 0x07FD001EU, 0x07FE1005U, 0x07FE5005U, 0x07FE9005U,
+        0x07FED002U, 0x0800000BU, 0x08006819U, 0x08014012U, 0x0801E001U, 0x0801F80EU, 0x0802800DU, 0x0804007AU,
+        0x080A0034U, 0x0814001CU, 0x08150030U, 0x0818001FU, 0x0819681DU, 0x081A8025U, 0x081C001DU, 0x081D0023U,
+        0x081E4007U, 0x081E8804U, 0x0820009DU, 0x08258023U, 0x0826C023U, 0x08280027U, 0x08298033U, 0x082B800AU,
+        0x082BE00EU, 0x082C6006U, 0x082CA001U, 0x082CB80AU, 0x082D180EU, 0x082D9806U, 0x082DD801U, 0x08300136U,
+        0x083A0015U, 0x083B0007U, 0x083C0005U, 0x083C3829U, 0x083D9008U, 0x08400005U, 0x08404000U, 0x0840502BU,
+        0x0841B801U, 0x0841E000U, 0x0841F816U, 0x08430016U, 0x0844001EU, 0x08470012U, 0x0847A001U, 0x08480015U,
+        0x08490019U, 0x084C0037U, 0x084DF001U, 0x08500000U, 0x08508003U, 0x0850A802U, 0x0850C81CU, 0x0853001CU,
+        0x0854001CU, 0x08560007U, 0x0856481BU, 0x08580035U, 0x085A0015U, 0x085B0012U, 0x085C0011U, 0x08600048U,
+        0x08640032U, 0x08660032U, 0x08680023U, 0x08740029U, 0x08758001U, 0x0878001CU, 0x08793800U, 0x08798015U,
+        0x087B8011U, 0x087D8014U, 0x087F0016U, 0x08801834U, 0x08838801U, 0x0883A800U, 0x0884182CU, 0x08868018U,
+        0x08881823U, 0x088A2000U, 0x088A3800U, 0x088A8022U, 0x088BB000U, 0x088C182FU, 0x088E0803U, 0x088ED000U,
+        0x088EE000U, 0x08900011U, 0x08909818U, 0x08940006U, 0x08944000U, 0x08945003U, 0x0894780EU, 0x0894F809U,
+        0x0895802EU, 0x08982807U, 0x08987801U, 0x08989815U, 0x08995006U, 0x08999001U, 0x0899A804U, 0x0899E800U,
+        0x089A8000U, 0x089AE804U, 0x08A00034U, 0x08A23803U, 0x08A2F802U, 0x08A4002FU, 0x08A62001U, 0x08A63800U,
+        0x08AC002EU, 0x08AEC003U, 0x08B0002FU, 0x08B22000U, 0x08B4002AU, 0x08B5C000U, 0x08B8001AU, 0x08BA0006U,
+        0x08C0002BU, 0x08C5003FU, 0x08C7F807U, 0x08C84800U, 0x08C86007U, 0x08C8A801U, 0x08C8C017U, 0x08C9F800U,
+        0x08CA0800U, 0x08CD0007U, 0x08CD5026U, 0x08CF0800U, 0x08CF1800U, 0x08D00000U, 0x08D05827U, 0x08D1D000U,
+        0x08D28000U, 0x08D2E02DU, 0x08D4E800U, 0x08D58048U, 0x08E00008U, 0x08E05024U, 0x08E20000U, 0x08E3901DU,
+        0x08E80006U, 0x08E84001U, 0x08E85825U, 0x08EA3000U, 0x08EB0005U, 0x08EB3801U, 0x08EB501FU, 0x08ECC000U,
+        0x08F70012U, 0x08FD8000U, 0x09000399U, 0x0920006EU, 0x092400C3U, 0x097C8060U, 0x0980042EU, 0x0A200246U,
+        0x0B400238U, 0x0B52001EU, 0x0B53804EU, 0x0B56801DU, 0x0B58002FU, 0x0B5A0003U, 0x0B5B1814U, 0x0B5BE812U,
+        0x0B72003FU, 0x0B78004AU, 0x0B7A8000U, 0x0B7C980CU, 0x0B7F0001U, 0x0B7F1800U, 0x0B8007FFU, 0x0BC007FFU,
+        0x0C0007F7U, 0x0C4004D5U, 0x0C680008U, 0x0D7F8003U, 0x0D7FA806U, 0x0D7FE801U, 0x0D800122U, 0x0D8A8002U,
+        0x0D8B2003U, 0x0D8B818BU, 0x0DE0006AU, 0x0DE3800CU, 0x0DE40008U, 0x0DE48009U, 0x0EA00054U, 0x0EA2B046U,
+        0x0EA4F001U, 0x0EA51000U, 0x0EA52801U, 0x0EA54803U, 0x0EA5700BU, 0x0EA5D800U, 0x0EA5E806U, 0x0EA62840U,
+        0x0EA83803U, 0x0EA86807U, 0x0EA8B006U, 0x0EA8F01BU, 0x0EA9D803U, 0x0EAA0004U, 0x0EAA3000U, 0x0EAA5006U,
+        0x0EAA9153U, 0x0EB54018U, 0x0EB61018U, 0x0EB6E01EU, 0x0EB7E018U, 0x0EB8B01EU, 0x0EB9B018U, 0x0EBA801EU,
+        0x0EBB8018U, 0x0EBC501EU, 0x0EBD5018U, 0x0EBE2007U, 0x0EF8001EU, 0x0F08002CU, 0x0F09B806U, 0x0F0A7000U,
+        0x0F14801DU, 0x0F16002BU, 0x0F3F0006U, 0x0F3F4003U, 0x0F3F6801U, 0x0F3F800EU, 0x0F4000C4U, 0x0F480043U,
+        0x0F4A5800U, 0x0F700003U, 0x0F70281AU, 0x0F710801U, 0x0F712000U, 0x0F713800U, 0x0F714809U, 0x0F71A003U,
+        0x0F71C800U, 0x0F71D800U, 0x0F721000U, 0x0F723800U, 0x0F724800U, 0x0F725800U, 0x0F726802U, 0x0F728801U,
+        0x0F72A000U, 0x0F72B800U, 0x0F72C800U, 0x0F72D800U, 0x0F72E800U, 0x0F72F800U, 0x0F730801U, 0x0F732000U,
+        0x0F733803U, 0x0F736006U, 0x0F73A003U, 0x0F73C803U, 0x0F73F000U, 0x0F740009U, 0x0F745810U, 0x0F750802U,
+        0x0F752804U, 0x0F755810U, 0x100007FFU, 0x104007FFU, 0x108007FFU, 0x10C007FFU, 0x110007FFU, 0x114007FFU,
+        0x118007FFU, 0x11C007FFU, 0x120007FFU, 0x124007FFU, 0x128007FFU, 0x12C007FFU, 0x130007FFU, 0x134007FFU,
+        0x138007FFU, 0x13C007FFU, 0x140007FFU, 0x144007FFU, 0x148007FFU, 0x14C007FFU, 0x150006DFU, 0x153807FFU,
+        0x157807FFU, 0x15B80038U, 0x15BA00DDU, 0x15C107FFU, 0x160107FFU, 0x16410681U, 0x167587FFU, 0x16B587FFU,
+        0x16F587FFU, 0x17358530U, 0x17C0021DU, 0x180007FFU, 0x184007FFU, 0x1880034AU,
+    };
+
+    inline constexpr std::array<uint32_t, 808UL> s_XidContinueRanges = {
+        0x00055000U, 0x0005A800U, 0x0005B800U, 0x0005D000U, 0x00060016U, 0x0006C01EU, 0x0007C1C9U, 0x0016300BU,
+        0x00170004U, 0x00176000U, 0x00177000U, 0x00180074U, 0x001BB001U, 0x001BD802U, 0x001BF800U, 0x001C3004U,
+        0x001C6000U, 0x001C7013U, 0x001D1852U, 0x001FB88AU, 0x00241804U, 0x002450A5U, 0x00298825U, 0x002AC800U,
+        0x002B0028U, 0x002C882CU, 0x002DF800U, 0x002E0801U, 0x002E2001U, 0x002E3800U, 0x002E801AU, 0x002F7803U,
+        0x0030800AU, 0x00310049U, 0x00337065U, 0x0036A807U, 0x0036F809U, 0x00375012U, 0x0037F800U, 0x0038803AU,
+        0x003A6864U, 0x003E0035U, 0x003FD000U, 0x003FE800U, 0x0040002DU, 0x0042001BU, 0x0043000AU, 0x00438017U,
+        0x00444805U, 0x0044C049U, 0x00471880U, 0x004B3009U, 0x004B8812U, 0x004C2807U, 0x004C7801U, 0x004C9815U,
+        0x004D5006U, 0x004D9000U, 0x004DB003U, 0x004DE008U, 0x004E3801U, 0x004E5803U, 0x004EB800U, 0x004EE001U,
+        0x004EF804U, 0x004F300BU, 0x004FE000U, 0x004FF000U, 0x00500802U, 0x00502805U, 0x00507801U, 0x00509815U,
+        0x00515006U, 0x00519001U, 0x0051A801U, 0x0051C001U, 0x0051E000U, 0x0051F004U, 0x00523801U, 0x00525802U,
+        0x00528800U, 0x0052C803U, 0x0052F000U, 0x0053300FU, 0x00540802U, 0x00542808U, 0x00547802U, 0x00549815U,
+        0x00555006U, 0x00559001U, 0x0055A804U, 0x0055E009U, 0x00563802U, 0x00565802U, 0x00568000U, 0x00570003U,
+        0x00573009U, 0x0057C806U, 0x00580802U, 0x00582807U, 0x00587801U, 0x00589815U, 0x00595006U, 0x00599001U,
+        0x0059A804U, 0x0059E008U, 0x005A3801U, 0x005A5802U, 0x005AA802U, 0x005AE001U, 0x005AF804U, 0x005B3009U,
+        0x005B8800U, 0x005C1001U, 0x005C2805U, 0x005C7002U, 0x005C9003U, 0x005CC801U, 0x005CE000U, 0x005CF001U,
+        0x005D1801U, 0x005D4002U, 0x005D700BU, 0x005DF004U, 0x005E3002U, 0x005E5003U, 0x005E8000U, 0x005EB800U,
+        0x005F3009U, 0x0060000CU, 0x00607002U, 0x00609016U, 0x0061500FU, 0x0061E008U, 0x00623002U, 0x00625003U,
+        0x0062A801U, 0x0062C002U, 0x0062E800U, 0x00630003U, 0x00633009U, 0x00640003U, 0x00642807U, 0x00647002U,
+        0x00649016U, 0x00655009U, 0x0065A804U, 0x0065E008U, 0x00663002U, 0x00665003U, 0x0066A801U, 0x0066E801U,
+        0x00670003U, 0x00673009U, 0x00678801U, 0x0068000CU, 0x00687002U, 0x00689032U, 0x006A3002U, 0x006A5004U,
+        0x006AA003U, 0x006AF804U, 0x006B3009U, 0x006BD005U, 0x006C0802U, 0x006C2811U, 0x006CD017U, 0x006D9808U,
+        0x006DE800U, 0x006E0006U, 0x006E5000U, 0x006E7805U, 0x006EB000U, 0x006EC007U, 0x006F3009U, 0x006F9001U,
+        0x00700839U, 0x0072000EU, 0x00728009U, 0x00740801U, 0x00742000U, 0x00743004U, 0x00746017U, 0x00752800U,
+        0x00753816U, 0x00760004U, 0x00763000U, 0x00764005U, 0x00768009U, 0x0076E003U, 0x00780000U, 0x0078C001U,
+        0x00790009U, 0x0079A800U, 0x0079B800U, 0x0079C800U, 0x0079F009U, 0x007A4823U, 0x007B8813U, 0x007C3011U,
+        0x007CC823U, 0x007E3000U, 0x00800049U, 0x0082804DU, 0x00850025U, 0x00863800U, 0x00866800U, 0x0086802AU,
+        0x0087E14CU, 0x00925003U, 0x00928006U, 0x0092C000U, 0x0092D003U, 0x00930028U, 0x00945003U, 0x00948020U,
+        0x00959003U, 0x0095C006U, 0x00960000U, 0x00961003U, 0x0096400EU, 0x0096C038U, 0x00989003U, 0x0098C042U,
+        0x009AE802U, 0x009B4808U, 0x009C000FU, 0x009D0055U, 0x009FC005U, 0x00A00A6BU, 0x00B37810U, 0x00B40819U,
+        0x00B5004AU, 0x00B7700AU, 0x00B80015U, 0x00B8F815U, 0x00BA0013U, 0x00BB000CU, 0x00BB7002U, 0x00BB9001U,
+        0x00BC0053U, 0x00BEB800U, 0x00BEE001U, 0x00BF0009U, 0x00C05802U, 0x00C0780AU, 0x00C10058U, 0x00C4002AU,
+        0x00C58045U, 0x00C8001EU, 0x00C9000BU, 0x00C9800BU, 0x00CA3027U, 0x00CB8004U, 0x00CC002BU, 0x00CD8019U,
+        0x00CE800AU, 0x00D0001BU, 0x00D1003EU, 0x00D3001CU, 0x00D3F80AU, 0x00D48009U, 0x00D53800U, 0x00D5800DU,
+        0x00D5F80FU, 0x00D8004CU, 0x00DA8009U, 0x00DB5808U, 0x00DC0073U, 0x00E00037U, 0x00E20009U, 0x00E26830U,
+        0x00E40008U, 0x00E4802AU, 0x00E5E802U, 0x00E68002U, 0x00E6A026U, 0x00E80215U, 0x00F8C005U, 0x00F90025U,
+        0x00FA4005U, 0x00FA8007U, 0x00FAC800U, 0x00FAD800U, 0x00FAE800U, 0x00FAF81EU, 0x00FC0034U, 0x00FDB006U,
+        0x00FDF000U, 0x00FE1002U, 0x00FE3006U, 0x00FE8003U, 0x00FEB005U, 0x00FF000CU, 0x00FF9002U, 0x00FFB006U,
+        0x0101F801U, 0x0102A000U, 0x01038800U, 0x0103F800U, 0x0104800CU, 0x0106800CU, 0x01070800U, 0x0107280BU,
+        0x01081000U, 0x01083800U, 0x01085009U, 0x0108A800U, 0x0108C005U, 0x01092000U, 0x01093000U, 0x01094000U,
+        0x0109500FU, 0x0109E003U, 0x010A2804U, 0x010A7000U, 0x010B0028U, 0x016000E4U, 0x01675808U, 0x01680025U,
+        0x01693800U, 0x01696800U, 0x01698037U, 0x016B7800U, 0x016BF817U, 0x016D0006U, 0x016D4006U, 0x016D8006U,
+        0x016DC006U, 0x016E0006U, 0x016E4006U, 0x016E8006U, 0x016EC006U, 0x016F001FU, 0x01802802U, 0x0181080EU,
+        0x01818804U, 0x0181C004U, 0x01820855U, 0x0184C801U, 0x0184E802U, 0x01850859U, 0x0187E003U, 0x0188282AU,
+        0x0189885DU, 0x018D001FU, 0x018F800FU, 0x01A007FFU, 0x01E007FFU, 0x022007FFU, 0x026001BFU, 0x027007FFU,
+        0x02B007FFU, 0x02F007FFU, 0x033007FFU, 0x037007FFU, 0x03B007FFU, 0x03F007FFU, 0x043007FFU, 0x047007FFU,
+        0x04B007FFU, 0x04F0068CU, 0x0526802DU, 0x0528010CU, 0x0530801BU, 0x0532002FU, 0x0533A009U, 0x0533F872U,
+        0x0538B808U, 0x05391066U, 0x053C583FU, 0x053E8001U, 0x053E9800U, 0x053EA804U, 0x053F9035U, 0x05416000U,
+        0x05420033U, 0x05440045U, 0x05468009U, 0x05470017U, 0x0547D800U, 0x0547E830U, 0x05498023U, 0x054B001CU,
+        0x054C0040U, 0x054E780AU, 0x054F001EU, 0x05500036U, 0x0552000DU, 0x05528009U, 0x05530016U, 0x0553D048U,
+        0x0556D802U, 0x0557000FU, 0x05579004U, 0x05580805U, 0x05584805U, 0x05588805U, 0x05590006U, 0x05594006U,
+        0x0559802AU, 0x055AE00DU, 0x055B807AU, 0x055F6001U, 0x055F8009U, 0x056007FFU, 0x05A007FFU, 0x05E007FFU,
+        0x062007FFU, 0x066007FFU, 0x06A003A3U, 0x06BD8016U, 0x06BE5830U, 0x07C8016DU, 0x07D38069U, 0x07D80006U,
+        0x07D89804U, 0x07D8E80BU, 0x07D9500CU, 0x07D9C004U, 0x07D9F000U, 0x07DA0001U, 0x07DA1801U, 0x07DA306BU,
+        0x07DE988AU, 0x07E320D9U, 0x07EA803FU, 0x07EC9035U, 0x07EF8009U, 0x07F0000FU, 0x07F1000FU, 0x07F19801U,
+        0x07F26802U, 0x07F38800U, 0x07F39800U, 0x07F3B800U, 0x07F3C800U, 0x07F3D800U, 0x07F3E800U, 0x07F3F87DU,
+        0x07F88009U, 0x07F90819U, 0x07F9F800U, 0x07FA0819U, 0x07FB3058U, 0x07FE1005U, 0x07FE5005U, 0x07FE9005U,
+        0x07FED002U, 0x0800000BU, 0x08006819U, 0x08014012U, 0x0801E001U, 0x0801F80EU, 0x0802800DU, 0x0804007AU,
+        0x080A0034U, 0x080FE800U, 0x0814001CU, 0x08150030U, 0x08170000U, 0x0818001FU, 0x0819681DU, 0x081A802AU,
+        0x081C001DU, 0x081D0023U, 0x081E4007U, 0x081E8804U, 0x0820009DU, 0x08250009U, 0x08258023U, 0x0826C023U,
+        0x08280027U, 0x08298033U, 0x082B800AU, 0x082BE00EU, 0x082C6006U, 0x082CA001U, 0x082CB80AU, 0x082D180EU,
+        0x082D9806U, 0x082DD801U, 0x08300136U, 0x083A0015U, 0x083B0007U, 0x083C0005U, 0x083C3829U, 0x083D9008U,
+        0x08400005U, 0x08404000U, 0x0840502BU, 0x0841B801U, 0x0841E000U, 0x0841F816U, 0x08430016U, 0x0844001EU,
+        0x08470012U, 0x0847A001U, 0x08480015U, 0x08490019U, 0x084C0037U, 0x084DF001U, 0x08500003U, 0x08502801U,
+        0x08506007U, 0x0850A802U, 0x0850C81CU, 0x0851C002U, 0x0851F800U, 0x0853001CU, 0x0854001CU, 0x08560007U,
+        0x0856481DU, 0x08580035U, 0x085A0015U, 0x085B0012U, 0x085C0011U, 0x08600048U, 0x08640032U, 0x08660032U,
+        0x08680027U, 0x08698009U, 0x08740029U, 0x08755801U, 0x08758001U, 0x0878001CU, 0x08793800U, 0x08798020U,
+        0x087B8015U, 0x087D8014U, 0x087F0016U, 0x08800046U, 0x0883300FU, 0x0883F83BU, 0x08861000U, 0x08868018U,
+        0x08878009U, 0x08880034U, 0x0889B009U, 0x088A2003U, 0x088A8023U, 0x088BB000U, 0x088C0044U, 0x088E4803U,
+        0x088E700CU, 0x088EE000U, 0x08900011U, 0x08909824U, 0x0891F000U, 0x08940006U, 0x08944000U, 0x08945003U,
+        0x0894780EU, 0x0894F809U, 0x0895803AU, 0x08978009U, 0x08980003U, 0x08982807U, 0x08987801U, 0x08989815U,
+        0x08995006U, 0x08999001U, 0x0899A804U, 0x0899D809U, 0x089A3801U, 0x089A5802U, 0x089A8000U, 0x089AB800U,
+        0x089AE806U, 0x089B3006U, 0x089B8004U, 0x08A0004AU, 0x08A28009U, 0x08A2F003U, 0x08A40045U, 0x08A63800U,
+        0x08A68009U, 0x08AC0035U, 0x08ADC008U, 0x08AEC005U, 0x08B00040U, 0x08B22000U, 0x08B28009U, 0x08B40038U,
+        0x08B60009U, 0x08B8001AU, 0x08B8E80EU, 0x08B98009U, 0x08BA0006U, 0x08C0003AU, 0x08C50049U, 0x08C7F807U,
+        0x08C84800U, 0x08C86007U, 0x08C8A801U, 0x08C8C01DU, 0x08C9B801U, 0x08C9D808U, 0x08CA8009U, 0x08CD0007U,
+        0x08CD502DU, 0x08CED007U, 0x08CF1801U, 0x08D0003EU, 0x08D23800U, 0x08D28049U, 0x08D4E800U, 0x08D58048U,
+        0x08E00008U, 0x08E0502CU, 0x08E1C008U, 0x08E28009U, 0x08E3901DU, 0x08E49015U, 0x08E5480DU, 0x08E80006U,
+        0x08E84001U, 0x08E8582BU, 0x08E9D000U, 0x08E9E001U, 0x08E9F808U, 0x08EA8009U, 0x08EB0005U, 0x08EB3801U,
+        0x08EB5024U, 0x08EC8001U, 0x08EC9805U, 0x08ED0009U, 0x08F70016U, 0x08FD8000U, 0x09000399U, 0x0920006EU,
+        0x092400C3U, 0x097C8060U, 0x0980042EU, 0x0A200246U, 0x0B400238U, 0x0B52001EU, 0x0B530009U, 0x0B53804EU,
+        0x0B560009U, 0x0B56801DU, 0x0B578004U, 0x0B580036U, 0x0B5A0003U, 0x0B5A8009U, 0x0B5B1814U, 0x0B5BE812U,
+        0x0B72003FU, 0x0B78004AU, 0x0B7A7838U, 0x0B7C7810U, 0x0B7F0001U, 0x0B7F1801U, 0x0B7F8001U, 0x0B8007FFU,
+        0x0BC007FFU, 0x0C0007F7U, 0x0C4004D5U, 0x0C680008U, 0x0D7F8003U, 0x0D7FA806U, 0x0D7FE801U, 0x0D800122U,
+        0x0D8A8002U, 0x0D8B2003U, 0x0D8B818BU, 0x0DE0006AU, 0x0DE3800CU, 0x0DE40008U, 0x0DE48009U, 0x0DE4E801U,
+        0x0E78002DU, 0x0E798016U, 0x0E8B2804U, 0x0E8B6805U, 0x0E8BD807U, 0x0E8C2806U, 0x0E8D5003U, 0x0E921002U,
+        0x0EA00054U, 0x0EA2B046U, 0x0EA4F001U, 0x0EA51000U, 0x0EA52801U, 0x0EA54803U, 0x0EA5700BU, 0x0EA5D800U,
+        0x0EA5E806U, 0x0EA62840U, 0x0EA83803U, 0x0EA86807U, 0x0EA8B006U, 0x0EA8F01BU, 0x0EA9D803U, 0x0EAA0004U,
+        0x0EAA3000U, 0x0EAA5006U, 0x0EAA9153U, 0x0EB54018U, 0x0EB61018U, 0x0EB6E01EU, 0x0EB7E018U, 0x0EB8B01EU,
+        0x0EB9B018U, 0x0EBA801EU, 0x0EBB8018U, 0x0EBC501EU, 0x0EBD5018U, 0x0EBE2007U, 0x0EBE7031U, 0x0ED00036U,
+        0x0ED1D831U, 0x0ED3A800U, 0x0ED42000U, 0x0ED4D804U, 0x0ED5080EU, 0x0EF8001EU, 0x0F000006U, 0x0F004010U,
+        0x0F00D806U, 0x0F011801U, 0x0F013004U, 0x0F08002CU, 0x0F09800DU, 0x0F0A0009U, 0x0F0A7000U, 0x0F14801EU,
+        0x0F160039U, 0x0F3F0006U, 0x0F3F4003U, 0x0F3F6801U, 0x0F3F800EU, 0x0F4000C4U, 0x0F468006U, 0x0F48004BU,
+        0x0F4A8009U, 0x0F700003U, 0x0F70281AU, 0x0F710801U, 0x0F712000U, 0x0F713800U, 0x0F714809U, 0x0F71A003U,
+        0x0F71C800U, 0x0F71D800U, 0x0F721000U, 0x0F723800U, 0x0F724800U, 0x0F725800U, 0x0F726802U, 0x0F728801U,
+        0x0F72A000U, 0x0F72B800U, 0x0F72C800U, 0x0F72D800U, 0x0F72E800U, 0x0F72F800U, 0x0F730801U, 0x0F732000U,
+        0x0F733803U, 0x0F736006U, 0x0F73A003U, 0x0F73C803U, 0x0F73F000U, 0x0F740009U, 0x0F745810U, 0x0F750802U,
+        0x0F752804U, 0x0F755810U, 0x0FDF8009U, 0x100007FFU, 0x104007FFU, 0x108007FFU, 0x10C007FFU, 0x110007FFU,
+        0x114007FFU, 0x118007FFU, 0x11C007FFU, 0x120007FFU, 0x124007FFU, 0x128007FFU, 0x12C007FFU, 0x130007FFU,
+        0x134007FFU, 0x138007FFU, 0x13C007FFU, 0x140007FFU, 0x144007FFU, 0x148007FFU, 0x14C007FFU, 0x150006DFU,
+        0x153807FFU, 0x157807FFU, 0x15B80038U, 0x15BA00DDU, 0x15C107FFU, 0x160107FFU, 0x16410681U, 0x167587FFU,
+        0x16B587FFU, 0x16F587FFU, 0x17358530U, 0x17C0021DU, 0x180007FFU, 0x184007FFU, 0x1880034AU, 0x700800EFU,
+    };
+} // namespace Aesthetic
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "arena.hpp"
+
+namespace Aesthetic
+{
+    static std::byte* AlignUp(std::byte* ptr, size_t alignment)
+    {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+        return ptr + ((alignment - address % alignment) % alignment);
+    }
+
+    Arena::Arena(size_t chunkSize, std::pmr::memory_resource* upstream)
+        : m_Upstream(upstream), m_Head(nullptr), m_Cursor(nullptr), m_End(nullptr),
+          m_NextChunkSize(std::max(chunkSize, sizeof(Chunk) * 2)),
+          m_BytesUsed(0UL), m_BytesReserved(0UL), m_Chunks(0UL) {}
+
+    Arena::~Arena()
+    {
+        Release();
+    }
+
+    void* Arena::Allocate(size_t size, size_t alignment)
+    {
+        std::byte* start = AlignUp(m_Cursor, alignment);
+
+        if (!m_Cursor || start + size > m_End)
+        {
+            Grow(size, alignment);
+            start = AlignUp(m_Cursor, alignment);
+        }
+
+        m_Cursor = start + size;
+        m_BytesUsed += size;
+        return start;
+    }
+
+    void Arena::Grow(size_t size, size_t alignment)
+    {
+        const size_t needed = sizeof(Chunk) + size + alignment;
+        const size_t chunkSize = std::max(m_NextChunkSize, needed);
+
+        Chunk* chunk = static_cast<Chunk*>(m_Upstream->allocate(chunkSize, alignof(std::max_align_t)));
+        chunk->next = m_Head;
+        chunk->size = chunkSize;
+        m_Head = chunk;
+
+        m_Cursor = reinterpret_cast<std::byte*>(chunk + 1);
+        m_End = reinterpret_cast<std::byte*>(chunk) + chunkSize;
+        m_BytesReserved += chunkSize;
+        m_Chunks++;
+
+        // Oversized requests get a chunk of their own and do not speed up growth
+        if (needed <= m_NextChunkSize)
+            m_NextChunkSize = std::min(m_NextChunkSize * 2, s_MaxChunkSize);
+    }
+
+    void Arena::Release()
+    {
+        while (m_Head)
+        {
+            Chunk* next = m_Head->next;
+            m_Upstream->deallocate(m_Head, m_Head->size, alignof(std::max_align_t));
+            m_Head = next;
+        }
+
+        m_Cursor = m_End = nullptr;
+        m_BytesUsed = m_BytesReserved = m_Chunks = 0UL;
+    }
+
+    void Arena::Reset()
+    {
+        Chunk* kept = m_Head;
+        for (Chunk* chunk = m_Head; chunk; chunk = chunk->next)
+            if (chunk->size > kept->size)
+                kept = chunk;
+
+        while (m_Head)
+        {
+            Chunk* next = m_Head->next;
+            if (m_Head != kept)
+                m_Upstream->deallocate(m_Head, m_Head->size, alignof(std::max_align_t));
+            m_Head = next;
+        }
+
+        m_BytesUsed = 0UL;
+        if (!kept)
+            return;
+
+        kept->next = nullptr;
+        m_Head = kept;
+        m_Cursor = reinterpret_cast<std::byte*>(kept + 1);
+        m_End = reinterpret_cast<std::byte*>(kept) + kept->size;
+        m_BytesReserved = kept->size;
+        m_Chunks = 1UL;
+    }
+
+    Arena::Usage Arena::Used() const
+    {
+        return Usage{ m_BytesUsed, m_BytesReserved, m_Chunks };
+    }
+
+    void* Arena::do_allocate(size_t bytes, size_t alignment)
+    {
+        return Allocate(bytes, alignment);
+    }
+
+    void Arena::do_deallocate(void*, size_t, size_t) {}
+
+    bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace Aesthetic
+{
+    // Bump allocator for everything that lives as long as a compilation unit.
+    // Memory is taken from the upstream resource in chunks that grow
+    // geometrically, individual deallocations are ignored and the whole
+    // arena is given back at once by Release() or on destruction.
+    class Arena : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t s_DefaultChunkSize = 64UL * 1024UL;
+        static constexpr size_t s_MaxChunkSize = 16UL * 1024UL * 1024UL;
+
+        struct Usage
+        {
+            size_t bytesUsed;
+            size_t bytesReserved;
+            size_t chunks;
+        };
+    private:
+        struct Chunk
+        {
+            Chunk* next;
+            size_t size;
+        };
+
+        std::pmr::memory_resource* m_Upstream;
+        Chunk* m_Head;
+        std::byte* m_Cursor;
+        std::byte* m_End;
+        size_t m_NextChunkSize;
+        size_t m_BytesUsed;
+        size_t m_BytesReserved;
+        size_t m_Chunks;
+    public:
+        Arena(size_t chunkSize = s_DefaultChunkSize,
+              std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        // Objects created here are never destroyed, only their memory is reclaimed
+        template<typename T, typename... Args>
+        T* New(Args&&... args)
+        {
+            return ::new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        void Release();
+        // Frees everything like Release() but keeps the largest chunk, for
+        // arenas that are reused by one compilation unit after another
+        void Reset();
+        Usage Used() const;
+    private:
+        void Grow(size_t size, size_t alignment);
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+} // namespace Aesthetic
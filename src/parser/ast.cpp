@@ -0,0 +1,119 @@
+#include "ast.hpp"
+
+namespace Aesthetic
+{
+    Ast::Ast(const TokenStream& tokens, std::pmr::memory_resource* resource)
+        : m_Tokens(&tokens), m_Kinds(resource), m_NodeTokens(resource),
+          m_Lhs(resource), m_Rhs(resource), m_Children(resource), m_Root(s_NoNode) {}
+
+    void Ast::Reserve(size_t nodes)
+    {
+        m_Kinds.reserve(nodes);
+        m_NodeTokens.reserve(nodes);
+        m_Lhs.reserve(nodes);
+        m_Rhs.reserve(nodes);
+        m_Children.reserve(nodes / 2UL);
+    }
+
+    NodeId Ast::Add(NodeKind kind, uint32_t token, NodeId lhs, NodeId rhs)
+    {
+        m_Kinds.push_back(kind);
+        m_NodeTokens.push_back(token);
+        m_Lhs.push_back(lhs);
+        m_Rhs.push_back(rhs);
+        return static_cast<NodeId>(m_Kinds.size() - 1UL);
+    }
+
+    NodeId Ast::AddList(NodeKind kind, uint32_t token, std::span<const NodeId> children)
+    {
+        const NodeId first = static_cast<NodeId>(m_Children.size());
+        m_Children.insert(m_Children.end(), children.begin(), children.end());
+        return Add(kind, token, first, static_cast<NodeId>(children.size()));
+    }
+
+    AstArrays Ast::Arrays() const
+    {
+        return AstArrays{ m_Kinds, m_NodeTokens, m_Lhs, m_Rhs, m_Children, m_Root };
+    }
+
+    void Ast::Assign(const AstArrays& arrays)
+    {
+        m_Kinds.assign(arrays.kinds.begin(), arrays.kinds.end());
+        m_NodeTokens.assign(arrays.tokens.begin(), arrays.tokens.end());
+        m_Lhs.assign(arrays.lhs.begin(), arrays.lhs.end());
+        m_Rhs.assign(arrays.rhs.begin(), arrays.rhs.end());
+        m_Children.assign(arrays.children.begin(), arrays.children.end());
+        m_Root = arrays.root;
+    }
+
+    std::span<const NodeId> Ast::Children(NodeId node) const
+    {
+        return std::span<const NodeId>(m_Children.data() + m_Lhs[node], m_Rhs[node]);
+    }
+
+    OperationType Ast::Operation(NodeId node) const
+    {
+        return static_cast<OperationType>(m_Tokens->Subtype(m_NodeTokens[node]));
+    }
+
+    SymbolId Ast::Symbol(NodeId node) const
+    {
+        return (*m_Tokens)[m_NodeTokens[node]].Symbol();
+    }
+
+    void Ast::Dump(std::ostream& out, NodeId node) const
+    {
+        auto list = [this, &out](std::string_view name, std::span<const NodeId> children) {
+            out << '(' << name;
+            for (const NodeId child : children)
+            {
+                out << ' ';
+                Dump(out, child);
+            }
+            out << ')';
+        };
+        auto pair = [this, &out](std::string_view name, NodeId lhs, NodeId rhs) {
+            out << '(' << name << ' ';
+            Dump(out, lhs);
+            if (rhs != s_NoNode)
+            {
+                out << ' ';
+                Dump(out, rhs);
+            }
+            out << ')';
+        };
+        const std::string_view text = m_Tokens->Text(m_NodeTokens[node]);
+
+        switch (Kind(node))
+        {
+        case NodeKind::ERROR: out << "(error)"; return;
+        case NodeKind::PROGRAM: return list("program", Children(node));
+        case NodeKind::BLOCK: return list("block", Children(node));
+        case NodeKind::WHEN: return pair("when", Lhs(node), Rhs(node));
+        case NodeKind::WHENEVER: return pair("whenever", Lhs(node), Rhs(node));
+        case NodeKind::ON: return pair("on", Lhs(node), Rhs(node));
+        case NodeKind::IF: return pair("if", Lhs(node), Rhs(node));
+        case NodeKind::BINDING:
+        case NodeKind::PIPE:
+        case NodeKind::BINARY:
+        case NodeKind::UNARY:
+            return pair(text, Lhs(node), Rhs(node));
+        case NodeKind::EXIST: return pair("exist", Lhs(node), s_NoNode);
+        case NodeKind::CALL: return list("call", Children(node));
+        case NodeKind::MEMBER:
+            out << "(. ";
+            Dump(out, Lhs(node));
+            out << ' ' << text << ')';
+            return;
+        case NodeKind::LIST: return list("list", Children(node));
+        case NodeKind::TUPLE: return list("tuple", Children(node));
+        case NodeKind::EVENT: out << '#' << text; return;
+        case NodeKind::NAME:
+        case NodeKind::INTEGER:
+        case NodeKind::FLOATING_POINT:
+        case NodeKind::STRING:
+            out << text;
+            return;
+        }
+    }
+} // namespace Aesthetic
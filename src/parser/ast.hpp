@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "lexer/token_stream.hpp"
+
+namespace Aesthetic
+{
+    using NodeId = uint32_t;
+
+    enum class NodeKind : uint8_t
+    {
+        ERROR          = 0U,
+        // Children are the statements
+        PROGRAM        = 1U,
+        BLOCK          = 2U,
+        // Handlers and `if`: lhs is the condition, rhs the block
+        WHEN           = 3U,
+        WHENEVER       = 4U,
+        ON             = 5U,
+        IF             = 6U,
+        // `::=`, `:=` and `=`: lhs is the target, rhs the value
+        BINDING        = 7U,
+        // `~>`: lhs flows into rhs
+        PIPE           = 8U,
+        // Arithmetic and comparisons
+        BINARY         = 9U,
+        // Prefix `-`, `+`, `~!` and `!!`: lhs is the operand
+        UNARY          = 10U,
+        // `exist x`: lhs is the operand
+        EXIST          = 11U,
+        // Children are the callee followed by the arguments
+        CALL           = 12U,
+        // `a.b`: lhs is the object, the token is the member name
+        MEMBER         = 13U,
+        // `[a, b]` and `(a, b)`, children are the elements
+        LIST           = 14U,
+        TUPLE          = 15U,
+        // Leaves, everything they hold is in their token
+        NAME           = 16U,
+        // `#start`, the token is the name
+        EVENT          = 17U,
+        INTEGER        = 18U,
+        FLOATING_POINT = 19U,
+        STRING         = 20U,
+    };
+
+    // The parallel arrays of an Ast
+    struct AstArrays
+    {
+        std::span<const NodeKind> kinds;
+        std::span<const uint32_t> tokens;
+        std::span<const NodeId> lhs;
+        std::span<const NodeId> rhs;
+        std::span<const NodeId> children;
+        NodeId root;
+    };
+
+    // Syntax tree of one program as parallel arrays. A node is an index,
+    // children are referred to by 32-bit indices and always come before
+    // their parent. Nodes with a variable number of children keep them in a
+    // shared array: lhs is the first index into it, rhs the count.
+    class Ast
+    {
+    public:
+        static constexpr NodeId s_NoNode = UINT32_MAX;
+    private:
+        const TokenStream* m_Tokens;
+        std::pmr::vector<NodeKind> m_Kinds;
+        std::pmr::vector<uint32_t> m_NodeTokens;
+        std::pmr::vector<NodeId> m_Lhs;
+        std::pmr::vector<NodeId> m_Rhs;
+        std::pmr::vector<NodeId> m_Children;
+        NodeId m_Root;
+    public:
+        Ast(const TokenStream& tokens,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void Reserve(size_t nodes);
+        NodeId Add(NodeKind kind, uint32_t token, NodeId lhs = s_NoNode, NodeId rhs = s_NoNode);
+        NodeId AddList(NodeKind kind, uint32_t token, std::span<const NodeId> children);
+        void SetRoot(NodeId root) { m_Root = root; }
+        // Views of the arrays, valid until the tree changes
+        AstArrays Arrays() const;
+        // Replaces all nodes with a copy of `arrays`
+        void Assign(const AstArrays& arrays);
+
+        const TokenStream& Tokens() const { return *m_Tokens; }
+        size_t Size() const { return m_Kinds.size(); }
+        NodeId Root() const { return m_Root; }
+
+        NodeKind Kind(NodeId node) const { return m_Kinds[node]; }
+        // Token the node was made from: the operator, keyword or leaf
+        uint32_t Token(NodeId node) const { return m_NodeTokens[node]; }
+        NodeId Lhs(NodeId node) const { return m_Lhs[node]; }
+        NodeId Rhs(NodeId node) const { return m_Rhs[node]; }
+        std::span<const NodeId> Children(NodeId node) const;
+
+        // Operator of BINDING, PIPE, BINARY and UNARY nodes
+        OperationType Operation(NodeId node) const;
+        // Interned name of NAME, EVENT and MEMBER nodes
+        SymbolId Symbol(NodeId node) const;
+
+        // Writes the tree as an S-expression, mostly for debugging
+        void Dump(std::ostream& out) const { Dump(out, m_Root); }
+        void Dump(std::ostream& out, NodeId node) const;
+    };
+} // namespace Aesthetic
@@ -0,0 +1,502 @@
+#include <array>
+#include <utility>
+
+#include "parser.hpp"
+
+namespace Aesthetic
+{
+    // Binding powers of infix operators. An operator is only taken by an
+    // expression parsed with a minimum power of at most `left`, its right
+    // operand is parsed with `right`: one more for left associative
+    // operators, the same for the right associative bindings.
+    struct InfixPower
+    {
+        uint8_t left;
+        uint8_t right;
+        NodeKind kind;
+    };
+
+    static constexpr uint8_t s_PrefixPower = 60U;
+    static constexpr uint8_t s_ApplicationPower = 70U;
+    static constexpr uint8_t s_MemberPower = 80U;
+
+    static constexpr std::array<InfixPower, OperatorToken::representations.size()> BuildInfixPowers()
+    {
+        std::array<InfixPower, OperatorToken::representations.size()> powers{};
+        auto set = [&powers](OperationType type, uint8_t left, uint8_t right, NodeKind kind) {
+            powers[static_cast<size_t>(type)] = InfixPower{ left, right, kind };
+        };
+
+        set(OperationType::PLAIN_COPY, 10U, 10U, NodeKind::BINDING);
+        set(OperationType::DEFINE_BINDING, 10U, 10U, NodeKind::BINDING);
+        set(OperationType::BOOSTY_BINDING, 10U, 10U, NodeKind::BINDING);
+        set(OperationType::PIPE, 20U, 21U, NodeKind::PIPE);
+        set(OperationType::LESS, 30U, 31U, NodeKind::BINARY);
+        set(OperationType::LESS_EQUAL, 30U, 31U, NodeKind::BINARY);
+        set(OperationType::GREATER, 30U, 31U, NodeKind::BINARY);
+        set(OperationType::GREATER_EQUAL, 30U, 31U, NodeKind::BINARY);
+        set(OperationType::EQUAL, 30U, 31U, NodeKind::BINARY);
+        set(OperationType::NOT_EQUAL, 30U, 31U, NodeKind::BINARY);
+        set(OperationType::ADDITION, 40U, 41U, NodeKind::BINARY);
+        set(OperationType::SUBSTRACTION, 40U, 41U, NodeKind::BINARY);
+        set(OperationType::MULTIPLICATION, 50U, 51U, NodeKind::BINARY);
+        set(OperationType::FLOAT_DIVISION, 50U, 51U, NodeKind::BINARY);
+        set(OperationType::INTEGER_DIVISION, 50U, 51U, NodeKind::BINARY);
+
+        return powers;
+    }
+
+    static constexpr std::array<InfixPower, OperatorToken::representations.size()> s_InfixPowers = BuildInfixPowers();
+
+    Parser::Parser(const TokenStream& tokens, std::pmr::memory_resource* resource)
+        : m_Tokens(tokens), m_Ast(tokens, resource), m_Cursor(0UL), m_Nesting(0UL), m_Depth(0UL), m_TooDeep(false), m_Scratch(resource) {}
+
+    Ast Parser::Parse()
+    {
+        m_Ast.Reserve(m_Tokens.Size());
+
+        const size_t base = m_Scratch.size();
+        while (true)
+        {
+            while (IsSeparator(Peek()))
+                Advance();
+
+            const size_t token = Peek();
+            if (m_Tokens.Kind(token) == TokenKind::END_OF_FILE)
+                break;
+            if (!m_Tokens.Valid(token))
+            {
+                if (m_Errors.empty() || m_Errors.back().token != token)
+                    Error(token, "invalid token");
+                break;
+            }
+
+            // Statements stop in front of a '}', at the top level no block
+            // takes it
+            if (IsPunctuation(token, PunctuationType::SCOPE_CLOSE))
+            {
+                Error(token, "unexpected '}'");
+                Advance();
+                continue;
+            }
+
+            const NodeId statement = Statement();
+            m_Scratch.push_back(statement);
+        }
+
+        const std::span<const NodeId> statements(m_Scratch.data() + base, m_Scratch.size() - base);
+        m_Ast.SetRoot(m_Ast.AddList(NodeKind::PROGRAM, 0U, statements));
+        m_Scratch.resize(base);
+
+        return std::move(m_Ast);
+    }
+
+    NodeId Parser::Statement()
+    {
+        const size_t errors = m_Errors.size();
+        const size_t token = Peek();
+        NodeId statement = Ast::s_NoNode;
+
+        if (m_Tokens.Kind(token) == TokenKind::KEYWORD)
+        {
+            switch (static_cast<KeywordType>(m_Tokens.Subtype(token)))
+            {
+            case KeywordType::WHEN: statement = Handler(NodeKind::WHEN); break;
+            case KeywordType::WHENEVER: statement = Handler(NodeKind::WHENEVER); break;
+            case KeywordType::ON: statement = Handler(NodeKind::ON); break;
+            case KeywordType::IF: statement = Handler(NodeKind::IF); break;
+            case KeywordType::EXIST: break;
+            }
+        }
+
+        if (statement == Ast::s_NoNode)
+            statement = Expression(0U);
+
+        const size_t next = Peek();
+        if (m_Errors.size() == errors && !IsSeparator(next)
+            && !IsPunctuation(next, PunctuationType::SCOPE_CLOSE)
+            && m_Tokens.Kind(next) != TokenKind::END_OF_FILE)
+        {
+            Error(next, "expected a new line or ';' after the statement");
+        }
+
+        if (m_Errors.size() != errors)
+            Synchronize();
+        m_TooDeep = false;
+
+        return statement;
+    }
+
+    NodeId Parser::Handler(NodeKind kind)
+    {
+        const size_t keyword = Advance();
+        const NodeId condition = Expression(0U);
+        const NodeId block = Block();
+        return m_Ast.Add(kind, static_cast<uint32_t>(keyword), condition, block);
+    }
+
+    NodeId Parser::Block()
+    {
+        const size_t open = Peek();
+        if (m_Depth == s_MaxDepth || m_TooDeep)
+        {
+            // Its statements would be too deep as well
+            const NodeId error = TooDeep("block nested too deeply");
+            SkipBlock();
+            return error;
+        }
+        if (!Expect(PunctuationType::SCOPE_OPEN, "expected '{' to open a block"))
+            return m_Ast.Add(NodeKind::ERROR, static_cast<uint32_t>(open));
+        m_Depth++;
+
+        // A block inside parentheses still ends its statements at new lines
+        const size_t nesting = m_Nesting;
+        m_Nesting = 0UL;
+
+        const size_t base = m_Scratch.size();
+        while (true)
+        {
+            while (IsSeparator(Peek()))
+                Advance();
+
+            const size_t token = Peek();
+            if (IsPunctuation(token, PunctuationType::SCOPE_CLOSE))
+            {
+                Advance();
+                break;
+            }
+            if (m_Tokens.Kind(token) == TokenKind::END_OF_FILE || !m_Tokens.Valid(token))
+            {
+                if (m_Errors.empty() || m_Errors.back().token != token)
+                    Error(token, m_Tokens.Valid(token) ? "expected '}' to close the block" : "invalid token");
+                break;
+            }
+
+            // Pushed after parsing, the statement's own lists use the scratch too
+            const NodeId statement = Statement();
+            m_Scratch.push_back(statement);
+        }
+
+        m_Nesting = nesting;
+        m_Depth--;
+
+        const std::span<const NodeId> statements(m_Scratch.data() + base, m_Scratch.size() - base);
+        const NodeId block = m_Ast.AddList(NodeKind::BLOCK, static_cast<uint32_t>(open), statements);
+        m_Scratch.resize(base);
+        return block;
+    }
+
+    NodeId Parser::Expression(uint8_t minPower)
+    {
+        // Operands, groups, lists and prefix operators all nest through here
+        if (m_Depth == s_MaxDepth || m_TooDeep)
+            return TooDeep("expression nested too deeply");
+
+        m_Depth++;
+        NodeId lhs = Prefix();
+
+        while (!m_TooDeep)
+        {
+            const size_t token = Peek();
+            const TokenKind kind = m_Tokens.Kind(token);
+
+            if (kind == TokenKind::OPERATOR)
+            {
+                const InfixPower power = s_InfixPowers[m_Tokens.Subtype(token)];
+                if (!power.left || power.left < minPower)
+                    break;
+
+                Advance();
+                const NodeId rhs = Expression(power.right);
+                lhs = m_Ast.Add(power.kind, static_cast<uint32_t>(token), lhs, rhs);
+            }
+            else if (IsPunctuation(token, PunctuationType::DOT) && s_MemberPower >= minPower)
+            {
+                Advance();
+                const size_t member = Peek();
+                if (m_Tokens.Kind(member) != TokenKind::SYMBOL)
+                {
+                    lhs = Error(member, "expected a member name after '.'");
+                    break;
+                }
+
+                Advance();
+                lhs = m_Ast.Add(NodeKind::MEMBER, static_cast<uint32_t>(member), lhs);
+            }
+            else if (s_ApplicationPower >= minPower && StartsOperand(token))
+            {
+                // Juxtaposition: `print x` calls print with x
+                const size_t base = m_Scratch.size();
+                m_Scratch.push_back(lhs);
+                while (StartsOperand(Peek()) && !m_TooDeep)
+                {
+                    const NodeId argument = Expression(s_ApplicationPower + 1U);
+                    m_Scratch.push_back(argument);
+                }
+
+                const std::span<const NodeId> children(m_Scratch.data() + base, m_Scratch.size() - base);
+                lhs = m_Ast.AddList(NodeKind::CALL, static_cast<uint32_t>(token), children);
+                m_Scratch.resize(base);
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        m_Depth--;
+        return lhs;
+    }
+
+    NodeId Parser::Prefix()
+    {
+        const size_t token = Peek();
+        const uint32_t index = static_cast<uint32_t>(token);
+
+        if (!m_Tokens.Valid(token))
+            return Error(token, "invalid token");
+
+        switch (m_Tokens.Kind(token))
+        {
+        case TokenKind::SYMBOL:
+            Advance();
+            return m_Ast.Add(NodeKind::NAME, index);
+        case TokenKind::INTEGER:
+            Advance();
+            return m_Ast.Add(NodeKind::INTEGER, index);
+        case TokenKind::FLOATING_POINT:
+            Advance();
+            return m_Ast.Add(NodeKind::FLOATING_POINT, index);
+        case TokenKind::STRING:
+            Advance();
+            return m_Ast.Add(NodeKind::STRING, index);
+        case TokenKind::KEYWORD:
+            if (static_cast<KeywordType>(m_Tokens.Subtype(token)) != KeywordType::EXIST)
+                break;
+            Advance();
+            return m_Ast.Add(NodeKind::EXIST, index, Expression(s_PrefixPower));
+        case TokenKind::OPERATOR:
+            switch (static_cast<OperationType>(m_Tokens.Subtype(token)))
+            {
+            case OperationType::ADDITION:
+            case OperationType::SUBSTRACTION:
+            case OperationType::DELETE:
+            case OperationType::RECURSION_DELETE:
+                Advance();
+                return m_Ast.Add(NodeKind::UNARY, index, Expression(s_PrefixPower));
+            default:
+                break;
+            }
+            break;
+        case TokenKind::PUNCTUATION:
+            switch (static_cast<PunctuationType>(m_Tokens.Subtype(token)))
+            {
+            case PunctuationType::HASH:
+            {
+                Advance();
+                const size_t name = Peek();
+                if (m_Tokens.Kind(name) != TokenKind::SYMBOL)
+                    return Error(name, "expected an event name after '#'");
+                Advance();
+                return m_Ast.Add(NodeKind::EVENT, static_cast<uint32_t>(name));
+            }
+            case PunctuationType::BRACKET_OPEN:
+                Advance();
+                m_Nesting++;
+                return Sequence(NodeKind::LIST, index, PunctuationType::BRACKET_CLOSE);
+            case PunctuationType::PARENTHESES_OPEN:
+            {
+                Advance();
+                m_Nesting++;
+                if (IsPunctuation(Peek(), PunctuationType::PARENTHESES_CLOSE))
+                {
+                    m_Nesting--;
+                    Advance();
+                    return m_Ast.Add(NodeKind::TUPLE, index, 0U, 0U);
+                }
+
+                // A single expression in parentheses is just grouped
+                const NodeId inner = Expression(0U);
+                if (IsPunctuation(Peek(), PunctuationType::PARENTHESES_CLOSE))
+                {
+                    m_Nesting--;
+                    Advance();
+                    return inner;
+                }
+
+                if (!IsPunctuation(Peek(), PunctuationType::COMMA))
+                {
+                    m_Nesting--;
+                    return Error(Peek(), "expected ')' or ','");
+                }
+
+                Advance();
+                m_Scratch.push_back(inner);
+                return Sequence(NodeKind::TUPLE, index, PunctuationType::PARENTHESES_CLOSE);
+            }
+            default:
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+
+        return Error(token, "expected an expression");
+    }
+
+    NodeId Parser::Sequence(NodeKind kind, uint32_t token, PunctuationType close)
+    {
+        // The opening token is consumed and counted in m_Nesting already. A
+        // tuple arrives with its first element on the scratch.
+        const size_t base = m_Scratch.size() - (kind == NodeKind::TUPLE ? 1UL : 0UL);
+
+        while (!IsPunctuation(Peek(), close))
+        {
+            const NodeId element = Expression(0U);
+            m_Scratch.push_back(element);
+
+            if (IsPunctuation(Peek(), PunctuationType::COMMA))
+            {
+                Advance();
+                continue;
+            }
+            if (!IsPunctuation(Peek(), close))
+            {
+                m_Nesting--;
+                m_Scratch.resize(base);
+                return Error(Peek(), kind == NodeKind::LIST ? "expected ']' or ','" : "expected ')' or ','");
+            }
+        }
+
+        m_Nesting--;
+        Advance();
+
+        const std::span<const NodeId> elements(m_Scratch.data() + base, m_Scratch.size() - base);
+        const NodeId sequence = m_Ast.AddList(kind, token, elements);
+        m_Scratch.resize(base);
+        return sequence;
+    }
+
+    size_t Parser::Peek()
+    {
+        while (true)
+        {
+            const TokenKind kind = m_Tokens.Kind(m_Cursor);
+
+            if (kind == TokenKind::OPERATOR
+                && static_cast<OperationType>(m_Tokens.Subtype(m_Cursor)) == OperationType::COMMENT_LINE)
+            {
+                // `///` comments out the rest of the line, the new line stays
+                while (m_Tokens.Kind(m_Cursor) != TokenKind::END_OF_FILE && m_Tokens.Valid(m_Cursor)
+                    && !IsPunctuation(m_Cursor, PunctuationType::LINE_END))
+                {
+                    m_Cursor++;
+                }
+                continue;
+            }
+
+            if (m_Nesting && IsPunctuation(m_Cursor, PunctuationType::LINE_END))
+            {
+                m_Cursor++;
+                continue;
+            }
+
+            return m_Cursor;
+        }
+    }
+
+    bool Parser::IsPunctuation(size_t token, PunctuationType type) const
+    {
+        return m_Tokens.Kind(token) == TokenKind::PUNCTUATION
+            && static_cast<PunctuationType>(m_Tokens.Subtype(token)) == type;
+    }
+
+    bool Parser::IsSeparator(size_t token) const
+    {
+        return IsPunctuation(token, PunctuationType::LINE_END) || IsPunctuation(token, PunctuationType::SEMICOLON);
+    }
+
+    bool Parser::StartsOperand(size_t token) const
+    {
+        switch (m_Tokens.Kind(token))
+        {
+        case TokenKind::SYMBOL:
+        case TokenKind::INTEGER:
+        case TokenKind::FLOATING_POINT:
+        case TokenKind::STRING:
+            return m_Tokens.Valid(token);
+        case TokenKind::KEYWORD:
+            return static_cast<KeywordType>(m_Tokens.Subtype(token)) == KeywordType::EXIST;
+        case TokenKind::PUNCTUATION:
+            return IsPunctuation(token, PunctuationType::HASH)
+                || IsPunctuation(token, PunctuationType::PARENTHESES_OPEN)
+                || IsPunctuation(token, PunctuationType::BRACKET_OPEN);
+        default:
+            return false;
+        }
+    }
+
+    bool Parser::Expect(PunctuationType type, std::string_view message)
+    {
+        const size_t token = Peek();
+        if (IsPunctuation(token, type))
+        {
+            Advance();
+            return true;
+        }
+
+        Error(token, message);
+        return false;
+    }
+
+    NodeId Parser::Error(size_t token, std::string_view message)
+    {
+        if (!m_TooDeep)
+            m_Errors.push_back(ParseError{ static_cast<uint32_t>(token), message });
+        return m_Ast.Add(NodeKind::ERROR, static_cast<uint32_t>(token));
+    }
+
+    NodeId Parser::TooDeep(std::string_view message)
+    {
+        const NodeId error = Error(Peek(), message);
+        m_TooDeep = true;
+        return error;
+    }
+
+    void Parser::SkipBlock()
+    {
+        // The condition in front of it may have run out of depth first
+        size_t depth = 0UL;
+        while (true)
+        {
+            const size_t token = Peek();
+            if (m_Tokens.Kind(token) == TokenKind::END_OF_FILE || !m_Tokens.Valid(token))
+                return;
+            if (!depth && (IsSeparator(token) || IsPunctuation(token, PunctuationType::SCOPE_CLOSE)))
+                return;
+
+            depth += IsPunctuation(token, PunctuationType::SCOPE_OPEN);
+            depth -= IsPunctuation(token, PunctuationType::SCOPE_CLOSE);
+            Advance();
+            if (!depth && IsPunctuation(token, PunctuationType::SCOPE_CLOSE))
+                return;
+        }
+    }
+
+    void Parser::Synchronize()
+    {
+        m_Nesting = 0UL;
+
+        while (true)
+        {
+            const size_t token = Peek();
+            if (m_Tokens.Kind(token) == TokenKind::END_OF_FILE || !m_Tokens.Valid(token)
+                || IsSeparator(token) || IsPunctuation(token, PunctuationType::SCOPE_CLOSE))
+            {
+                return;
+            }
+            Advance();
+        }
+    }
+} // namespace Aesthetic
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "ast.hpp"
+#include "lexer/token_stream.hpp"
+
+namespace Aesthetic
+{
+    struct ParseError
+    {
+        // Token the error was found at
+        uint32_t token;
+        std::string_view message;
+    };
+
+    // Builds the Ast of a TokenStream in a single pass. Statements are
+    // parsed by recursive descent, expressions by precedence climbing over
+    // the operator's binding power (Pratt parsing). After an error the
+    // parser skips to the next statement, so one run reports all of them.
+    // Expressions and blocks nested deeper than s_MaxDepth are an error
+    // rather than a stack overflow.
+    class Parser
+    {
+    public:
+        static constexpr size_t s_MaxDepth = 1024UL;
+    private:
+        const TokenStream& m_Tokens;
+        Ast m_Ast;
+        size_t m_Cursor;
+        // Open parentheses and brackets, new lines inside of them are blanks
+        size_t m_Nesting;
+        // Expressions and blocks being parsed, one inside the other
+        size_t m_Depth;
+        // The depth ran out in this statement, the frames unwinding from it
+        // parse nothing more and report no other errors
+        bool m_TooDeep;
+        // Children of the lists being parsed, nested lists stack up here
+        std::pmr::vector<NodeId> m_Scratch;
+        std::vector<ParseError> m_Errors;
+    public:
+        Parser(const TokenStream& tokens,
+               std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        Ast Parse();
+        const std::vector<ParseError>& Errors() const { return m_Errors; }
+    private:
+        NodeId Statement();
+        NodeId Handler(NodeKind kind);
+        NodeId Block();
+        NodeId Expression(uint8_t minPower);
+        NodeId Prefix();
+        NodeId Sequence(NodeKind kind, uint32_t token, PunctuationType close);
+
+        // Index of the next token that is not a comment or an ignored new line
+        size_t Peek();
+        size_t Advance() { const size_t token = Peek(); m_Cursor = token + 1; return token; }
+        bool IsPunctuation(size_t token, PunctuationType type) const;
+        bool IsSeparator(size_t token) const;
+        bool StartsOperand(size_t token) const;
+        bool Expect(PunctuationType type, std::string_view message);
+
+        NodeId Error(size_t token, std::string_view message);
+        NodeId TooDeep(std::string_view message);
+        // Skips the rest of a handler up to the end of its block
+        void SkipBlock();
+        // Skips the rest of a statement that failed to parse
+        void Synchronize();
+    };
+} // namespace Aesthetic
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "resolver.hpp"
+#include "value.hpp"
+#include "parser/ast.hpp"
+
+namespace Aesthetic
+{
+    // Arithmetic and comparisons with the operator they compute. Each one
+    // comes as NAME (R[a] = R[b] op R[c]), NAME_CONSTANT (R[a] = R[b] op
+    // K[c]) and NAME_BINDING_CONSTANT (R[a] = B[b] op K[c]), the last one
+    // for conditions like `x >= 1000`.
+    #define AE_BINARY_OPCODES(X)                     \
+        X(ADD,            ADDITION)                  \
+        X(SUBTRACT,       SUBSTRACTION)              \
+        X(MULTIPLY,       MULTIPLICATION)            \
+        X(FLOAT_DIVIDE,   FLOAT_DIVISION)            \
+        X(INTEGER_DIVIDE, INTEGER_DIVISION)          \
+        X(LESS,           LESS)                      \
+        X(LESS_EQUAL,     LESS_EQUAL)                \
+        X(GREATER,        GREATER)                   \
+        X(GREATER_EQUAL,  GREATER_EQUAL)             \
+        X(EQUAL,          EQUAL)                     \
+        X(NOT_EQUAL,      NOT_EQUAL)
+
+    // Everything but the binary operators. `a`, `b` and `c` name the
+    // operands of the Instruction, R is a register, K a constant, B a
+    // binding slot.
+    #define AE_OPCODES(X)                                                          \
+        X(LOAD_NIL)       /* R[a] = nil                                        */  \
+        X(LOAD_CONSTANT)  /* R[a] = K[c]                                       */  \
+        X(LOAD_BINDING)   /* R[a] = B[c]                                       */  \
+        X(LOAD_EVENT)     /* R[a] = whether the event symbol c fired this tick */  \
+        X(EXISTS)         /* R[a] = whether B[c] exists                        */  \
+        X(MOVE)           /* R[a] = R[b]                                       */  \
+        X(NEGATE)         /* R[a] = -R[b]                                      */  \
+        X(PLUS)           /* R[a] = +R[b]                                      */  \
+        X(JUMP)           /* goto c                                            */  \
+        X(JUMP_IF_FALSE)  /* if R[a] does not hold goto c                      */  \
+        X(WRITE)          /* B[c] = R[a] once the tick is over                 */  \
+        X(STEP_BINDING)   /* B[c] = B[c] + K[b] once the tick is over          */  \
+        X(COPY_BINDING)   /* B[c] = B[b] once the tick is over                 */  \
+        X(DELETE)         /* deletes B[c], with its derived bindings if a      */  \
+        X(DECLARE)        /* hands statement node c to the runtime             */  \
+        X(PRINT)          /* prints R[a] to R[a + b - 1]                       */  \
+        X(FAIL)           /* reports message b, R[a] = nil                     */  \
+        X(RETURN)         /* returns R[a]                                      */
+
+    enum class OpCode : uint8_t
+    {
+        #define AE_OPCODE(name) name,
+        #define AE_BINARY_OPCODE(name, operation) name, name##_CONSTANT, name##_BINDING_CONSTANT,
+        AE_OPCODES(AE_OPCODE)
+        AE_BINARY_OPCODES(AE_BINARY_OPCODE)
+        #undef AE_BINARY_OPCODE
+        #undef AE_OPCODE
+        COUNT
+    };
+
+    // Where the rhs of a binary instruction comes from
+    enum class OperandForm : uint8_t
+    {
+        REGISTERS        = 0U,
+        CONSTANT         = 1U,
+        BINDING_CONSTANT = 2U,
+    };
+
+    // Fixed width of 8 bytes, jumps are instruction indices
+    struct Instruction
+    {
+        OpCode op;
+        uint8_t a;
+        uint16_t b;
+        uint32_t c;
+    };
+
+    // One compiled expression, rule or block
+    struct Chunk
+    {
+        std::vector<Instruction> code;
+        // Node every instruction was compiled from, to report errors at
+        std::vector<NodeId> nodes;
+        std::vector<Value> constants;
+        std::vector<std::string_view> messages;
+        // Slots of the bindings it touches, and of the ones it deletes:
+        // everything else only changes once the tick is over
+        std::vector<SlotId> slots;
+        std::vector<SlotId> deletes;
+        uint32_t registers = 1U;
+        // Whether it declares or deletes recursively, which may change the
+        // graph and any binding, so nothing else may run alongside it
+        bool exclusive = false;
+    };
+} // namespace Aesthetic
@@ -0,0 +1,410 @@
+#include <algorithm>
+
+#include "compiler.hpp"
+#include "util/interner.hpp"
+
+namespace Aesthetic
+{
+    // Instruction computing `operation` on operands of the given form
+    static std::optional<OpCode> BinaryOpCode(OperationType operation, OperandForm form)
+    {
+        switch (operation)
+        {
+        #define AE_BINARY_OPCODE(name, type) \
+            case OperationType::type: return static_cast<OpCode>(static_cast<uint8_t>(OpCode::name) + static_cast<uint8_t>(form));
+        AE_BINARY_OPCODES(AE_BINARY_OPCODE)
+        #undef AE_BINARY_OPCODE
+        default:
+            return std::nullopt;
+        }
+    }
+
+    BytecodeCompiler::BytecodeCompiler(const Ast& ast, const Resolution& resolution)
+        : m_Ast(ast), m_Resolution(resolution), m_Print(Interner::Global().Intern("print")), m_Chunk(nullptr), m_Next(0U),
+          m_Generation(0U), m_Touched(resolution.Size(), 0U)
+    {
+    }
+
+    Chunk BytecodeCompiler::CompileExpression(NodeId expression)
+    {
+        Chunk chunk;
+        Begin(chunk);
+
+        const uint8_t result = Allocate().value();
+        Expression(expression, result);
+        Emit(OpCode::RETURN, expression, result);
+
+        return chunk;
+    }
+
+    Chunk BytecodeCompiler::CompileRule(NodeId statement)
+    {
+        Chunk chunk;
+        Begin(chunk);
+
+        const uint8_t result = Allocate().value();
+        Write(m_Ast.Lhs(statement), m_Ast.Rhs(statement), statement);
+        Emit(OpCode::LOAD_NIL, statement, result);
+        Emit(OpCode::RETURN, statement, result);
+
+        return chunk;
+    }
+
+    Chunk BytecodeCompiler::CompileBlock(NodeId block)
+    {
+        Chunk chunk;
+        Begin(chunk);
+
+        const uint8_t result = Allocate().value();
+        Statement(block);
+        Emit(OpCode::LOAD_NIL, block, result);
+        Emit(OpCode::RETURN, block, result);
+
+        return chunk;
+    }
+
+    void BytecodeCompiler::Begin(Chunk& chunk)
+    {
+        m_Chunk = &chunk;
+        m_Next = 0U;
+
+        // Slots noted by the chunks before are of older generations
+        if (++m_Generation == 0U)
+        {
+            std::fill(m_Touched.begin(), m_Touched.end(), 0U);
+            m_Generation = 1U;
+        }
+    }
+
+    void BytecodeCompiler::Statement(NodeId statement)
+    {
+        switch (m_Ast.Kind(statement))
+        {
+        case NodeKind::PROGRAM:
+        case NodeKind::BLOCK:
+            for (const NodeId child : m_Ast.Children(statement))
+                Statement(child);
+            return;
+        case NodeKind::IF:
+        {
+            const std::optional<uint8_t> condition = Allocate();
+            if (!condition)
+                return Fail(statement, 0U, "statement is nested too deeply");
+
+            Expression(m_Ast.Lhs(statement), condition.value());
+            const size_t jump = Emit(OpCode::JUMP_IF_FALSE, statement, condition.value());
+            Free(1U);
+            Statement(m_Ast.Rhs(statement));
+            Patch(jump);
+            return;
+        }
+        case NodeKind::WHEN:
+        case NodeKind::WHENEVER:
+        case NodeKind::ON:
+            Emit(OpCode::DECLARE, statement, 0U, 0U, statement);
+            m_Chunk->exclusive = true;
+            return;
+        case NodeKind::BINDING:
+        {
+            if (!IsName(m_Ast.Lhs(statement)))
+                return Fail(statement, 0U, "only names can be bound");
+
+            // Definitions and rules only register with the runtime here
+            const OperationType operation = m_Ast.Operation(statement);
+            if (operation == OperationType::DEFINE_BINDING || operation == OperationType::BOOSTY_BINDING)
+            {
+                Emit(OpCode::DECLARE, statement, 0U, 0U, statement);
+                m_Chunk->exclusive = true;
+            }
+            else
+                Write(m_Ast.Lhs(statement), m_Ast.Rhs(statement), statement);
+            return;
+        }
+        case NodeKind::UNARY:
+        {
+            const OperationType operation = m_Ast.Operation(statement);
+            if (operation != OperationType::DELETE && operation != OperationType::RECURSION_DELETE)
+                break;
+
+            const NodeId operand = m_Ast.Lhs(statement);
+            if (!IsName(operand))
+                return Fail(statement, 0U, "only names can be deleted");
+            const SlotId slot = Slot(operand);
+            Emit(OpCode::DELETE, statement, operation == OperationType::RECURSION_DELETE, 0U, slot);
+            // A recursive deletion reaches bindings nobody can name up front
+            if (operation == OperationType::RECURSION_DELETE)
+                m_Chunk->exclusive = true;
+            else
+                m_Chunk->deletes.push_back(slot);
+            return;
+        }
+        case NodeKind::ERROR:
+            return;
+        default:
+            break;
+        }
+
+        const std::optional<uint8_t> scratch = Allocate();
+        if (!scratch)
+            return Fail(statement, 0U, "statement is nested too deeply");
+        Expression(statement, scratch.value());
+        Free(1U);
+    }
+
+    void BytecodeCompiler::Write(NodeId target, NodeId value, NodeId statement)
+    {
+        const SlotId slot = Slot(target);
+
+        // `x := x + 1`, `x = x - 2`: one instruction reads, adds and writes
+        if (m_Ast.Kind(value) == NodeKind::BINARY && IsName(m_Ast.Lhs(value)) && m_Resolution.Slot(m_Ast.Lhs(value)) == slot)
+        {
+            const OperationType operation = m_Ast.Operation(value);
+            std::optional<Value> step = Literal(m_Ast.Rhs(value));
+
+            if (step && step->IsNumber() && operation == OperationType::SUBSTRACTION)
+                step = ApplyUnary(OperationType::SUBSTRACTION, step.value());
+            if (step && step->IsNumber() && (operation == OperationType::ADDITION || operation == OperationType::SUBSTRACTION))
+            {
+                const uint32_t constant = Constant(step.value());
+                if (constant <= UINT16_MAX)
+                {
+                    Emit(OpCode::STEP_BINDING, value, 0U, static_cast<uint16_t>(constant), slot);
+                    return;
+                }
+            }
+        }
+
+        // `x = y` copies without a register
+        if (IsName(value))
+        {
+            const SlotId source = Slot(value);
+            if (source <= UINT16_MAX)
+            {
+                Emit(OpCode::COPY_BINDING, statement, 0U, static_cast<uint16_t>(source), slot);
+                return;
+            }
+        }
+
+        const std::optional<uint8_t> result = Allocate();
+        if (!result)
+            return Fail(statement, 0U, "statement is nested too deeply");
+        Expression(value, result.value());
+        Emit(OpCode::WRITE, statement, result.value(), 0U, slot);
+        Free(1U);
+    }
+
+    void BytecodeCompiler::Expression(NodeId expression, uint8_t target)
+    {
+        if (const std::optional<Value> literal = Literal(expression))
+        {
+            Emit(OpCode::LOAD_CONSTANT, expression, target, 0U, Constant(literal.value()));
+            return;
+        }
+
+        switch (m_Ast.Kind(expression))
+        {
+        case NodeKind::NAME:
+            Emit(OpCode::LOAD_BINDING, expression, target, 0U, Slot(expression));
+            return;
+        case NodeKind::EVENT:
+            Emit(OpCode::LOAD_EVENT, expression, target, 0U, m_Ast.Symbol(expression));
+            return;
+        case NodeKind::EXIST:
+        {
+            const NodeId operand = m_Ast.Lhs(expression);
+            if (!IsName(operand))
+                return Fail(expression, target, "only names can be checked for existence");
+            Emit(OpCode::EXISTS, expression, target, 0U, Slot(operand));
+            return;
+        }
+        case NodeKind::UNARY:
+        {
+            const OperationType operation = m_Ast.Operation(expression);
+            if (operation == OperationType::DELETE || operation == OperationType::RECURSION_DELETE)
+            {
+                Statement(expression);
+                Emit(OpCode::LOAD_NIL, expression, target);
+                return;
+            }
+
+            Expression(m_Ast.Lhs(expression), target);
+            Emit(operation == OperationType::SUBSTRACTION ? OpCode::NEGATE : OpCode::PLUS, expression, target, target);
+            return;
+        }
+        case NodeKind::BINARY:
+        {
+            const OperationType operation = m_Ast.Operation(expression);
+            const NodeId lhs = m_Ast.Lhs(expression);
+            const NodeId rhs = m_Ast.Rhs(expression);
+            const std::optional<Value> literal = Literal(rhs);
+
+            if (!BinaryOpCode(operation, OperandForm::REGISTERS))
+                return Fail(expression, target, "operator is not supported by the runtime");
+
+            // `x >= 1000` reads the binding within the instruction
+            if (literal && IsName(lhs))
+            {
+                const SlotId slot = Slot(lhs);
+                if (slot <= UINT16_MAX)
+                {
+                    const OpCode op = BinaryOpCode(operation, OperandForm::BINDING_CONSTANT).value();
+                    Emit(op, expression, target, static_cast<uint16_t>(slot), Constant(literal.value()));
+                    return;
+                }
+            }
+
+            Expression(lhs, target);
+
+            if (literal)
+            {
+                const OpCode op = BinaryOpCode(operation, OperandForm::CONSTANT).value();
+                Emit(op, expression, target, target, Constant(literal.value()));
+                return;
+            }
+
+            const std::optional<uint8_t> scratch = Allocate();
+            if (!scratch)
+                return Fail(expression, target, "expression is nested too deeply");
+            Expression(rhs, scratch.value());
+            Emit(BinaryOpCode(operation, OperandForm::REGISTERS).value(), expression, target, target, scratch.value());
+            Free(1U);
+            return;
+        }
+        case NodeKind::CALL:
+        {
+            const std::span<const NodeId> children = m_Ast.Children(expression);
+            return Print(children.front(), children.subspan(1UL), Ast::s_NoNode, target);
+        }
+        case NodeKind::PIPE:
+        {
+            // `a ~> f` calls f with a after the arguments it already has
+            const NodeId rhs = m_Ast.Rhs(expression);
+            if (m_Ast.Kind(rhs) == NodeKind::CALL)
+            {
+                const std::span<const NodeId> children = m_Ast.Children(rhs);
+                return Print(children.front(), children.subspan(1UL), m_Ast.Lhs(expression), target);
+            }
+            return Print(rhs, {}, m_Ast.Lhs(expression), target);
+        }
+        case NodeKind::BINDING:
+            Statement(expression);
+            Emit(OpCode::LOAD_NIL, expression, target);
+            return;
+        case NodeKind::ERROR:
+            Emit(OpCode::LOAD_NIL, expression, target);
+            return;
+        default:
+            return Fail(expression, target, "expression is not supported by the runtime");
+        }
+    }
+
+    void BytecodeCompiler::Print(NodeId callee, std::span<const NodeId> arguments, NodeId piped, uint8_t target)
+    {
+        if (!IsName(callee) || m_Ast.Symbol(callee) != m_Print)
+            return Fail(callee, target, "unknown function");
+
+        // The values to print go into consecutive registers, `print(a, b)`
+        // passes a tuple and prints its elements
+        const uint32_t first = m_Next;
+        uint32_t count = 0U;
+        const auto element = [&](NodeId value)
+        {
+            const std::optional<uint8_t> slot = Allocate();
+            if (!slot)
+                return false;
+            Expression(value, slot.value());
+            count++;
+            return true;
+        };
+        const auto argument = [&](NodeId value)
+        {
+            if (m_Ast.Kind(value) != NodeKind::TUPLE)
+                return element(value);
+
+            bool fits = true;
+            for (const NodeId child : m_Ast.Children(value))
+                fits = fits && element(child);
+            return fits;
+        };
+
+        bool fits = true;
+        for (const NodeId value : arguments)
+            fits = fits && argument(value);
+        if (piped != Ast::s_NoNode)
+            fits = fits && argument(piped);
+        Free(count);
+
+        if (!fits)
+            return Fail(callee, target, "call has too many arguments");
+        Emit(OpCode::PRINT, callee, static_cast<uint8_t>(count ? first : 0U), static_cast<uint16_t>(count));
+        Emit(OpCode::LOAD_NIL, callee, target);
+    }
+
+    std::optional<Value> BytecodeCompiler::Literal(NodeId expression) const
+    {
+        const TokenStream& tokens = m_Ast.Tokens();
+        const uint32_t token = m_Ast.Token(expression);
+
+        switch (m_Ast.Kind(expression))
+        {
+        case NodeKind::INTEGER:
+            return Value::Integer(static_cast<int64_t>(tokens[token].Integer()));
+        case NodeKind::FLOATING_POINT:
+            return Value::FloatingPoint(tokens[token].FloatingPoint());
+        case NodeKind::STRING:
+            return Value::String(tokens[token].StringValue());
+        case NodeKind::UNARY:
+        {
+            const OperationType operation = m_Ast.Operation(expression);
+            if (operation != OperationType::ADDITION && operation != OperationType::SUBSTRACTION)
+                return std::nullopt;
+
+            const std::optional<Value> operand = Literal(m_Ast.Lhs(expression));
+            if (!operand || !operand->IsNumber())
+                return std::nullopt;
+            return ApplyUnary(operation, operand.value());
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    std::optional<uint8_t> BytecodeCompiler::Allocate()
+    {
+        if (m_Next == s_MaxRegisters)
+            return std::nullopt;
+
+        m_Chunk->registers = std::max(m_Chunk->registers, m_Next + 1U);
+        return static_cast<uint8_t>(m_Next++);
+    }
+
+    size_t BytecodeCompiler::Emit(OpCode op, NodeId node, uint8_t a, uint16_t b, uint32_t c)
+    {
+        m_Chunk->code.push_back(Instruction{ op, a, b, c });
+        m_Chunk->nodes.push_back(node);
+        return m_Chunk->code.size() - 1UL;
+    }
+
+    uint32_t BytecodeCompiler::Constant(const Value& value)
+    {
+        m_Chunk->constants.push_back(value);
+        return static_cast<uint32_t>(m_Chunk->constants.size() - 1UL);
+    }
+
+    SlotId BytecodeCompiler::Slot(NodeId name)
+    {
+        const SlotId slot = m_Resolution.Slot(name);
+        if (m_Touched[slot] != m_Generation)
+        {
+            m_Touched[slot] = m_Generation;
+            m_Chunk->slots.push_back(slot);
+        }
+        return slot;
+    }
+
+    void BytecodeCompiler::Fail(NodeId node, uint8_t target, std::string_view message)
+    {
+        m_Chunk->messages.push_back(message);
+        Emit(OpCode::FAIL, node, target, static_cast<uint16_t>(m_Chunk->messages.size() - 1UL));
+    }
+} // namespace Aesthetic
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "bytecode.hpp"
+#include "resolver.hpp"
+#include "parser/ast.hpp"
+
+namespace Aesthetic
+{
+    // Compiles parts of an Ast to register bytecode for the VirtualMachine.
+    // Registers are allocated like a stack: an expression computes into the
+    // register it is given and only uses the ones above it. Bindings are
+    // addressed by the slots of the Resolution. Updates of a binding by a
+    // constant and copies between bindings get fused instructions of their
+    // own.
+    class BytecodeCompiler
+    {
+    public:
+        static constexpr uint32_t s_MaxRegisters = 256U;
+    private:
+        const Ast& m_Ast;
+        const Resolution& m_Resolution;
+        SymbolId m_Print;
+        Chunk* m_Chunk;
+        uint32_t m_Next;
+        // Generation of the chunk being compiled, and of the last chunk that
+        // noted each slot as touched, by SlotId
+        uint32_t m_Generation;
+        std::vector<uint32_t> m_Touched;
+    public:
+        BytecodeCompiler(const Ast& ast, const Resolution& resolution);
+
+        // Returns the value of `expression`
+        Chunk CompileExpression(NodeId expression);
+        // Writes the value of the `:=` statement to its target
+        Chunk CompileRule(NodeId statement);
+        // Runs the statements of a BLOCK or PROGRAM, or a single statement
+        Chunk CompileBlock(NodeId block);
+    private:
+        void Begin(Chunk& chunk);
+        void Statement(NodeId statement);
+        void Write(NodeId target, NodeId value, NodeId statement);
+        void Expression(NodeId expression, uint8_t target);
+        void Print(NodeId callee, std::span<const NodeId> arguments, NodeId piped, uint8_t target);
+
+        // Value of literals and negated number literals
+        std::optional<Value> Literal(NodeId expression) const;
+        bool IsName(NodeId expression) const { return m_Ast.Kind(expression) == NodeKind::NAME; }
+
+        std::optional<uint8_t> Allocate();
+        void Free(uint32_t registers) { m_Next -= registers; }
+        size_t Emit(OpCode op, NodeId node, uint8_t a = 0U, uint16_t b = 0U, uint32_t c = 0U);
+        void Patch(size_t jump) { m_Chunk->code[jump].c = static_cast<uint32_t>(m_Chunk->code.size()); }
+        uint32_t Constant(const Value& value);
+        // Slot of a NAME node, noted as touched by the chunk
+        SlotId Slot(NodeId name);
+        void Fail(NodeId node, uint8_t target, std::string_view message);
+    };
+} // namespace Aesthetic
@@ -0,0 +1,163 @@
+#include <algorithm>
+
+#include "dependency_graph.hpp"
+
+namespace Aesthetic
+{
+    DependencyGraph::DependencyGraph(size_t nodes)
+        : m_Queued(0UL), m_Tick(1U)
+    {
+        Resize(nodes);
+        m_Buckets.resize(1UL);
+    }
+
+    void DependencyGraph::Resize(size_t nodes)
+    {
+        if (nodes <= Size())
+            return;
+
+        // New nodes have no edges yet, they share the end of the edge array
+        m_EdgeStart.resize(nodes + 1UL, static_cast<uint32_t>(m_Edges.size()));
+        m_Heights.resize(nodes, 0U);
+        m_ScheduledIn.resize(nodes, 0U);
+    }
+
+    GraphNode DependencyGraph::AddNode()
+    {
+        Resize(Size() + 1UL);
+        return static_cast<GraphNode>(Size() - 1UL);
+    }
+
+    void DependencyGraph::AddEdge(GraphNode from, GraphNode to)
+    {
+        Resize(std::max(from, to) + 1UL);
+        m_Pending.emplace_back(from, to);
+    }
+
+    std::vector<std::pair<GraphNode, GraphNode>> DependencyGraph::Build()
+    {
+        const size_t nodes = Size();
+        std::vector<std::pair<GraphNode, GraphNode>> dropped;
+
+        // Counting sort of old and new edges by source, keeping their order
+        std::vector<uint32_t> start(nodes + 1UL, 0U);
+        for (GraphNode node = 0U; node < nodes; node++)
+            start[node + 1UL] = m_EdgeStart[node + 1UL] - m_EdgeStart[node];
+        for (const auto& [from, to] : m_Pending)
+            start[from + 1UL]++;
+        for (size_t node = 0UL; node < nodes; node++)
+            start[node + 1UL] += start[node];
+
+        std::vector<GraphNode> edges(start[nodes]);
+        std::vector<uint32_t> cursor(start.begin(), start.end() - 1);
+        for (GraphNode node = 0U; node < nodes; node++)
+            for (uint32_t i = m_EdgeStart[node]; i < m_EdgeStart[node + 1UL]; i++)
+                edges[cursor[node]++] = m_Edges[i];
+        for (const auto& [from, to] : m_Pending)
+            edges[cursor[from]++] = to;
+
+        m_Pending.clear();
+        m_EdgeStart.swap(start);
+        m_Edges.swap(edges);
+
+        // Heights by Kahn's algorithm, whatever is left over lies on a cycle
+        std::vector<uint32_t> incoming(nodes, 0U);
+        for (const GraphNode to : m_Edges)
+            incoming[to]++;
+
+        std::vector<GraphNode> ready;
+        for (GraphNode node = 0U; node < nodes; node++)
+        {
+            m_Heights[node] = 0U;
+            if (!incoming[node])
+                ready.push_back(node);
+        }
+
+        size_t done = 0UL;
+        while (done < nodes)
+        {
+            while (!ready.empty())
+            {
+                const GraphNode node = ready.back();
+                ready.pop_back();
+                done++;
+
+                for (const GraphNode to : Dependents(node))
+                {
+                    if (to == s_NoNode)
+                        continue;
+                    m_Heights[to] = std::max(m_Heights[to], m_Heights[node] + 1U);
+                    if (!--incoming[to])
+                        ready.push_back(to);
+                }
+            }
+
+            if (done == nodes)
+                break;
+
+            // Break a cycle: drop every edge into the first stuck node that
+            // comes from another stuck one, then carry on from there
+            GraphNode stuck = 0U;
+            while (!incoming[stuck])
+                stuck++;
+
+            for (GraphNode from = 0U; from < nodes; from++)
+            {
+                if (!incoming[from] && from != stuck)
+                    continue;
+
+                for (uint32_t i = m_EdgeStart[from]; i < m_EdgeStart[from + 1UL]; i++)
+                {
+                    if (m_Edges[i] != stuck)
+                        continue;
+                    dropped.emplace_back(from, stuck);
+                    m_Edges[i] = s_NoNode;
+                    incoming[stuck]--;
+                }
+            }
+            ready.push_back(stuck);
+        }
+
+        if (!dropped.empty())
+        {
+            // Compact the dropped edges away
+            size_t kept = 0UL;
+            for (GraphNode node = 0U; node < nodes; node++)
+            {
+                const uint32_t first = m_EdgeStart[node];
+                m_EdgeStart[node] = static_cast<uint32_t>(kept);
+                for (uint32_t i = first; i < m_EdgeStart[node + 1UL]; i++)
+                    if (m_Edges[i] != s_NoNode)
+                        m_Edges[kept++] = m_Edges[i];
+            }
+            m_EdgeStart[nodes] = static_cast<uint32_t>(kept);
+            m_Edges.resize(kept);
+        }
+
+        const uint32_t highest = nodes ? *std::max_element(m_Heights.begin(), m_Heights.end()) : 0U;
+        m_Buckets.resize(std::max<size_t>(m_Buckets.size(), highest + 1UL));
+
+        return dropped;
+    }
+
+    std::span<const GraphNode> DependencyGraph::Dependents(GraphNode node) const
+    {
+        return std::span<const GraphNode>(m_Edges.data() + m_EdgeStart[node], m_EdgeStart[node + 1UL] - m_EdgeStart[node]);
+    }
+
+    void DependencyGraph::Schedule(GraphNode node)
+    {
+        if (m_ScheduledIn[node] == m_Tick)
+            return;
+
+        m_ScheduledIn[node] = m_Tick;
+        m_Buckets[m_Heights[node]].push_back(node);
+        m_Queued++;
+    }
+
+    void DependencyGraph::ScheduleDependents(GraphNode node)
+    {
+        for (const GraphNode dependent : Dependents(node))
+            Schedule(dependent);
+    }
+} // namespace Aesthetic
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Aesthetic
+{
+    using GraphNode = uint32_t;
+
+    // Dependency graph of a reactive program and the engine propagating
+    // changes through it. Every node has a height above all of its
+    // dependencies. A change schedules the node's dependents into a queue
+    // bucketed by height, and the buckets are drained lowest first. So every
+    // node is recomputed at most once per tick, after everything it depends
+    // on, and never sees half-updated inputs.
+    //
+    // Downstream edges are stored in compact CSR arrays. Edges added later
+    // are collected and merged in by Build(), which also recomputes the
+    // heights. Nodes of bindings use the interned SymbolId of their name, so
+    // other nodes are added above the symbols.
+    class DependencyGraph
+    {
+    public:
+        static constexpr GraphNode s_NoNode = UINT32_MAX;
+    private:
+        // Where the dependents of a node start in m_Edges, one past the last node too
+        std::vector<uint32_t> m_EdgeStart;
+        std::vector<GraphNode> m_Edges;
+        std::vector<std::pair<GraphNode, GraphNode>> m_Pending;
+        std::vector<uint32_t> m_Heights;
+
+        // Tick a node was last scheduled in, each one is queued at most once
+        std::vector<uint32_t> m_ScheduledIn;
+        std::vector<std::vector<GraphNode>> m_Buckets;
+        // Which nodes of the bucket being drained changed, for PropagateHeights()
+        std::vector<uint8_t> m_Changed;
+        size_t m_Queued;
+        uint32_t m_Tick;
+    public:
+        DependencyGraph(size_t nodes = 0UL);
+
+        size_t Size() const { return m_Heights.size(); }
+        void Resize(size_t nodes);
+        GraphNode AddNode();
+
+        // `to` depends on `from`, it takes effect with the next Build()
+        void AddEdge(GraphNode from, GraphNode to);
+        bool Dirty() const { return !m_Pending.empty(); }
+        // Merges the new edges and recomputes all heights. Edges that would
+        // close a cycle are dropped and returned as (from, to) pairs.
+        std::vector<std::pair<GraphNode, GraphNode>> Build();
+
+        uint32_t Height(GraphNode node) const { return m_Heights[node]; }
+        // Nodes depending on `node` as of the last Build(), in the order they were added
+        std::span<const GraphNode> Dependents(GraphNode node) const;
+
+        // Recomputes `node` in the coming tick
+        void Schedule(GraphNode node);
+        void ScheduleDependents(GraphNode node);
+        bool Pending() const { return m_Queued; }
+        uint32_t CurrentTick() const { return m_Tick; }
+
+        // Runs one tick: calls `recompute(node)` for every scheduled node in
+        // height order, nodes of the same height in the order they were
+        // scheduled. When it returns true the node changed and its
+        // dependents are scheduled too. Returns the number of recomputed
+        // nodes. Must not be called with edges pending a Build().
+        template<typename Recompute>
+        size_t Propagate(Recompute&& recompute)
+        {
+            size_t recomputed = 0UL;
+
+            for (size_t height = 0UL; m_Queued && height < m_Buckets.size(); height++)
+            {
+                // Dependents are strictly higher, so the bucket cannot grow
+                // while it is drained
+                std::vector<GraphNode>& bucket = m_Buckets[height];
+                for (size_t i = 0UL; i < bucket.size(); i++)
+                {
+                    const GraphNode node = bucket[i];
+                    m_Queued--;
+                    recomputed++;
+
+                    if (recompute(node))
+                        ScheduleDependents(node);
+                }
+                bucket.clear();
+            }
+
+            m_Tick++;
+            return recomputed;
+        }
+
+        // Like Propagate(), but hands over all scheduled nodes of a height at
+        // once, so they can be recomputed in parallel. They cannot depend on
+        // each other. `recompute(nodes, changed)` sets `changed[i]` when
+        // nodes[i] changed, and the dependents are scheduled in node order
+        // afterwards, just as Propagate() would have.
+        template<typename RecomputeHeight>
+        size_t PropagateHeights(RecomputeHeight&& recompute)
+        {
+            size_t recomputed = 0UL;
+
+            for (size_t height = 0UL; m_Queued && height < m_Buckets.size(); height++)
+            {
+                std::vector<GraphNode>& bucket = m_Buckets[height];
+                if (bucket.empty())
+                    continue;
+
+                m_Queued -= bucket.size();
+                recomputed += bucket.size();
+                m_Changed.assign(bucket.size(), 0U);
+                recompute(std::span<const GraphNode>(bucket), std::span<uint8_t>(m_Changed));
+
+                for (size_t i = 0UL; i < bucket.size(); i++)
+                    if (m_Changed[i])
+                        ScheduleDependents(bucket[i]);
+                bucket.clear();
+            }
+
+            m_Tick++;
+            return recomputed;
+        }
+    };
+} // namespace Aesthetic
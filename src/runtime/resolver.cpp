@@ -0,0 +1,276 @@
+#include "resolver.hpp"
+
+namespace Aesthetic
+{
+    SlotId Resolution::Global(SymbolId symbol) const
+    {
+        const auto it = globals.find(symbol);
+        return it != globals.end() ? it->second : s_NoSlot;
+    }
+
+    Resolver::Resolver()
+        : m_Ast(nullptr), m_Run(0UL)
+    {
+    }
+
+    Resolution Resolver::Resolve(const Ast& ast)
+    {
+        m_Ast = &ast;
+        m_Resolution = Resolution{};
+        m_Resolution.slots.assign(ast.Size(), Resolution::s_NoSlot);
+        m_Deleted.clear();
+        m_DeletedAt.clear();
+        m_Run = 0UL;
+        m_Errors.clear();
+
+        // Every symbol of the program is interned by now
+        const size_t symbols = Interner::Global().Size();
+        if (m_Visible.size() < symbols)
+        {
+            m_Visible.resize(symbols, Resolution::s_NoSlot);
+            m_Globals.resize(symbols, Resolution::s_NoSlot);
+        }
+
+        if (ast.Root() != Ast::s_NoNode)
+            Visit(ast.Root());
+
+        // Blocks restored m_Visible as they closed
+        for (const auto& [symbol, slot] : m_Resolution.globals)
+            m_Globals[symbol] = Resolution::s_NoSlot;
+        return std::move(m_Resolution);
+    }
+
+    void Resolver::Scope(NodeId block)
+    {
+        if (m_Ast->Kind(block) != NodeKind::BLOCK)
+            return Visit(block);
+
+        // Declarations first, a block sees its bindings before they are defined
+        const size_t shadowed = m_Shadowed.size();
+        const SlotId first = static_cast<SlotId>(m_Resolution.Size());
+        for (const NodeId statement : m_Ast->Children(block))
+            Declare(statement, first);
+        for (const NodeId statement : m_Ast->Children(block))
+            Visit(statement);
+
+        while (m_Shadowed.size() > shadowed)
+        {
+            m_Visible[m_Shadowed.back().symbol] = m_Shadowed.back().slot;
+            m_Shadowed.pop_back();
+        }
+    }
+
+    void Resolver::Declare(NodeId node, SlotId first)
+    {
+        if (node == Ast::s_NoNode)
+            return;
+
+        switch (m_Ast->Kind(node))
+        {
+        case NodeKind::BINDING:
+        {
+            const NodeId target = m_Ast->Lhs(node);
+            if (m_Ast->Operation(node) == OperationType::DEFINE_BINDING && m_Ast->Kind(target) == NodeKind::NAME)
+            {
+                // Slots from `first` on are of this block, defining one again rebinds it
+                const SymbolId symbol = m_Ast->Symbol(target);
+                if (m_Visible[symbol] == Resolution::s_NoSlot || m_Visible[symbol] < first)
+                {
+                    m_Shadowed.push_back(Shadowed{ symbol, m_Visible[symbol] });
+                    m_Visible[symbol] = Add(symbol);
+                }
+            }
+            Declare(m_Ast->Rhs(node), first);
+            return;
+        }
+        case NodeKind::WHEN:
+        case NodeKind::WHENEVER:
+        case NodeKind::ON:
+        case NodeKind::IF:
+        case NodeKind::UNARY:
+        case NodeKind::EXIST:
+        case NodeKind::MEMBER:
+            Declare(m_Ast->Lhs(node), first);
+            return;
+        case NodeKind::PIPE:
+        case NodeKind::BINARY:
+            Declare(m_Ast->Lhs(node), first);
+            Declare(m_Ast->Rhs(node), first);
+            return;
+        case NodeKind::CALL:
+        case NodeKind::LIST:
+        case NodeKind::TUPLE:
+            for (const NodeId child : m_Ast->Children(node))
+                Declare(child, first);
+            return;
+        default:
+            return;
+        }
+    }
+
+    void Resolver::Visit(NodeId node)
+    {
+        if (node == Ast::s_NoNode)
+            return;
+
+        switch (m_Ast->Kind(node))
+        {
+        case NodeKind::PROGRAM:
+        case NodeKind::LIST:
+        case NodeKind::TUPLE:
+            for (const NodeId child : m_Ast->Children(node))
+                Visit(child);
+            return;
+        case NodeKind::BLOCK:
+            return Scope(node);
+        case NodeKind::IF:
+        {
+            // The block may not run, what it deletes counts only inside of it
+            Visit(m_Ast->Lhs(node));
+            const size_t deleted = m_Deleted.size();
+            Scope(m_Ast->Rhs(node));
+            Restore(deleted);
+            return;
+        }
+        case NodeKind::WHEN:
+        case NodeKind::WHENEVER:
+        case NodeKind::ON:
+            Later(m_Ast->Lhs(node), false);
+            Later(m_Ast->Rhs(node), true);
+            return;
+        case NodeKind::BINDING:
+        {
+            const OperationType operation = m_Ast->Operation(node);
+            if (operation == OperationType::DEFINE_BINDING || operation == OperationType::BOOSTY_BINDING)
+                Later(m_Ast->Rhs(node), false);
+            else
+                Visit(m_Ast->Rhs(node));
+
+            const NodeId target = m_Ast->Lhs(node);
+            if (m_Ast->Kind(target) == NodeKind::NAME)
+                Name(target, false);
+            else
+                Visit(target);
+            return;
+        }
+        case NodeKind::UNARY:
+        {
+            const OperationType operation = m_Ast->Operation(node);
+            const NodeId operand = m_Ast->Lhs(node);
+            if ((operation == OperationType::DELETE || operation == OperationType::RECURSION_DELETE)
+                && m_Ast->Kind(operand) == NodeKind::NAME)
+            {
+                Delete(Name(operand, false));
+                return;
+            }
+            return Visit(operand);
+        }
+        case NodeKind::EXIST:
+        {
+            const NodeId operand = m_Ast->Lhs(node);
+            if (m_Ast->Kind(operand) == NodeKind::NAME)
+                Name(operand, false);
+            else
+                Visit(operand);
+            return;
+        }
+        case NodeKind::CALL:
+        {
+            // Functions are not bindings, only the arguments are read
+            const std::span<const NodeId> children = m_Ast->Children(node);
+            if (m_Ast->Kind(children.front()) != NodeKind::NAME)
+                Visit(children.front());
+            for (const NodeId argument : children.subspan(1UL))
+                Visit(argument);
+            return;
+        }
+        case NodeKind::PIPE:
+        {
+            // The arguments the callee already has come before the piped value
+            const NodeId rhs = m_Ast->Rhs(node);
+            if (m_Ast->Kind(rhs) != NodeKind::NAME)
+                Visit(rhs);
+            Visit(m_Ast->Lhs(node));
+            return;
+        }
+        case NodeKind::BINARY:
+            Visit(m_Ast->Lhs(node));
+            Visit(m_Ast->Rhs(node));
+            return;
+        case NodeKind::MEMBER:
+            return Visit(m_Ast->Lhs(node));
+        case NodeKind::NAME:
+            Name(node, true);
+            return;
+        default:
+            return;
+        }
+    }
+
+    void Resolver::Later(NodeId node, bool scope)
+    {
+        const size_t run = m_Run;
+        const size_t deleted = m_Deleted.size();
+        m_Run = deleted;
+
+        if (scope)
+            Scope(node);
+        else
+            Visit(node);
+
+        Restore(deleted);
+        m_Run = run;
+    }
+
+    SlotId Resolver::Name(NodeId name, bool read)
+    {
+        const SymbolId symbol = m_Ast->Symbol(name);
+        const SlotId slot = m_Visible[symbol] != Resolution::s_NoSlot ? m_Visible[symbol] : Global(symbol);
+        m_Resolution.slots[name] = slot;
+
+        // Writes and definitions only land once the tick is over, nothing
+        // brings the binding back before this read
+        if (read && Deleted(slot))
+            m_Errors.push_back(ResolveError{ m_Ast->Token(name), "binding is used after it was deleted" });
+        return slot;
+    }
+
+    SlotId Resolver::Global(SymbolId symbol)
+    {
+        SlotId& slot = m_Globals[symbol];
+        if (slot == Resolution::s_NoSlot)
+        {
+            slot = Add(symbol);
+            m_Resolution.globals.emplace(symbol, slot);
+        }
+        return slot;
+    }
+
+    SlotId Resolver::Add(SymbolId symbol)
+    {
+        m_Resolution.symbols.push_back(symbol);
+        m_DeletedAt.push_back(0UL);
+        return static_cast<SlotId>(m_Resolution.symbols.size() - 1UL);
+    }
+
+    void Resolver::Delete(SlotId slot)
+    {
+        m_Deleted.push_back(Deletion{ slot, m_DeletedAt[slot] });
+        m_DeletedAt[slot] = m_Deleted.size();
+    }
+
+    void Resolver::Restore(size_t deleted)
+    {
+        while (m_Deleted.size() > deleted)
+        {
+            m_DeletedAt[m_Deleted.back().slot] = m_Deleted.back().previous;
+            m_Deleted.pop_back();
+        }
+    }
+
+    bool Resolver::Deleted(SlotId slot) const
+    {
+        // The last deletion of the slot is the one that counts
+        return m_DeletedAt[slot] > m_Run;
+    }
+} // namespace Aesthetic
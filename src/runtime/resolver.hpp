@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "parser/ast.hpp"
+#include "util/interner.hpp"
+
+namespace Aesthetic
+{
+    // Index of a binding in the VmState, and of its node in the DependencyGraph
+    using SlotId = uint32_t;
+
+    struct ResolveError
+    {
+        // Token the error was found at
+        uint32_t token;
+        std::string_view message;
+    };
+
+    // The slots a Resolver gave the names of an Ast
+    struct Resolution
+    {
+        static constexpr SlotId s_NoSlot = UINT32_MAX;
+
+        // Slot of every NAME node that stands for a binding, by NodeId.
+        // Callees are functions and have none.
+        std::vector<SlotId> slots;
+        // Symbol every slot was made for, by SlotId
+        std::vector<SymbolId> symbols;
+        // Slots of the global bindings, only looked up from outside
+        std::unordered_map<SymbolId, SlotId> globals;
+
+        size_t Size() const { return symbols.size(); }
+        SlotId Slot(NodeId name) const { return slots[name]; }
+        SlotId Global(SymbolId symbol) const;
+    };
+
+    // Binds every name of an Ast to a slot before anything runs, so compiled
+    // code only ever indexes the binding table. A `::=` declares its name
+    // for the whole block it is in, uses before it included, and shadows
+    // the blocks around it. Names no block declares, and everything at the
+    // top level, are global.
+    //
+    // Scopes are walked with one table for the whole program: the innermost
+    // slot of every symbol in scope, indexed by SymbolId, and a stack of the
+    // slots each open block shadows, restored as the block closes. The
+    // tables are empty again after every run, so one resolver can go
+    // through many programs without clearing them.
+    //
+    // Reading a binding that the code running at that point has certainly
+    // deleted is an error. Deletions in an `if` only count inside of it,
+    // and handlers start afresh as they run in later ticks.
+    class Resolver
+    {
+    private:
+        struct Shadowed
+        {
+            SymbolId symbol;
+            SlotId slot;
+        };
+
+        struct Deletion
+        {
+            SlotId slot;
+            // m_DeletedAt of the slot before it
+            size_t previous;
+        };
+
+        const Ast* m_Ast;
+        Resolution m_Resolution;
+        // Innermost slot of every symbol declared by an open block, and the
+        // global slot of every symbol, by SymbolId
+        std::vector<SlotId> m_Visible;
+        std::vector<SlotId> m_Globals;
+        std::vector<Shadowed> m_Shadowed;
+        // Slots deleted by the code running, from m_Run on
+        std::vector<Deletion> m_Deleted;
+        size_t m_Run;
+        // One past the last index of every slot in m_Deleted, 0 if it has
+        // none, by SlotId
+        std::vector<size_t> m_DeletedAt;
+        std::vector<ResolveError> m_Errors;
+    public:
+        Resolver();
+
+        Resolution Resolve(const Ast& ast);
+        // Of the last Resolve()
+        const std::vector<ResolveError>& Errors() const { return m_Errors; }
+    private:
+        // Runs the statements of a BLOCK in a scope of its own
+        void Scope(NodeId block);
+        // Declares the `::=` of `node` in the innermost scope, nested blocks aside
+        void Declare(NodeId node, SlotId first);
+        void Visit(NodeId node);
+        // Handler conditions and bodies, values of `::=` and `:=` run later
+        void Later(NodeId node, bool scope);
+
+        // Resolves a NAME node, `read` if its value is used
+        SlotId Name(NodeId name, bool read);
+        SlotId Global(SymbolId symbol);
+        SlotId Add(SymbolId symbol);
+        void Delete(SlotId slot);
+        // Forgets the deletions from index `deleted` on
+        void Restore(size_t deleted);
+        bool Deleted(SlotId slot) const;
+    };
+} // namespace Aesthetic
@@ -0,0 +1,582 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "runtime.hpp"
+#include "util/interner.hpp"
+
+namespace Aesthetic
+{
+    Runtime::Runtime(const Ast& ast, const Resolution& resolution, std::ostream& out, std::pmr::memory_resource* resource, size_t threads)
+        : m_Ast(ast), m_Resolution(resolution), m_Out(out), m_Resource(resource), m_Compiler(ast, resolution),
+          m_ChunkOf(ast.Size(), nullptr), m_Start(Interner::Global().Intern("start")), m_Ticks(0UL)
+    {
+        // Every binding of the program has its slot by now, so the bindings
+        // take the low node indices and everything else goes on top
+        m_State.bindings.resize(resolution.Size());
+        m_Graph.Resize(m_State.bindings.size());
+
+        if (threads != 1UL)
+        {
+            m_Pool = std::make_unique<WorkStealingPool>(threads);
+            for (size_t i = 0UL; i < m_Pool->Size(); i++)
+                m_Workers.push_back(std::make_unique<Worker>(*this));
+            m_ReadIn.resize(m_State.bindings.size(), 0U);
+            m_WrittenIn.resize(m_State.bindings.size(), 0U);
+        }
+    }
+
+    void Runtime::Start()
+    {
+        const NodeId root = m_Ast.Root();
+        if (root != Ast::s_NoNode)
+            m_Machine.Execute(*Compiled(root, ChunkKind::BLOCK), m_State, *this);
+
+        Emit(m_Start);
+    }
+
+    void Runtime::Emit(SymbolId event)
+    {
+        m_Emitted.Push(event);
+    }
+
+    bool Runtime::Tick()
+    {
+        Commit();
+        if (!m_Graph.Pending())
+            return false;
+
+        if (m_Pool)
+            m_Graph.PropagateHeights([this](std::span<const GraphNode> nodes, std::span<uint8_t> changed) { RecomputeHeight(nodes, changed); });
+        else
+            m_Graph.Propagate([this](GraphNode node) { return Recompute(node, m_Machine, *this); });
+        m_Ticks++;
+        return true;
+    }
+
+    size_t Runtime::Run(size_t maxTicks)
+    {
+        Start();
+
+        const size_t first = m_Ticks;
+        while (m_Ticks - first < maxTicks && Tick())
+            ;
+        return m_Ticks - first;
+    }
+
+    Value Runtime::Get(SymbolId symbol) const
+    {
+        return Exists(symbol) ? m_State.bindings[m_Resolution.Global(symbol)].value : Value::Nil();
+    }
+
+    bool Runtime::Exists(SymbolId symbol) const
+    {
+        const SlotId slot = m_Resolution.Global(symbol);
+        return slot != Resolution::s_NoSlot && m_State.bindings[slot].exists;
+    }
+
+    GraphNode Runtime::AddReaction(ReactionKind kind, NodeId node, uint32_t target)
+    {
+        const uint32_t stamp = kind == ReactionKind::RULE ? m_State.bindings[target].generation : 0U;
+        Chunk* code = nullptr;
+        Chunk* body = nullptr;
+
+        if (kind == ReactionKind::RULE)
+        {
+            code = Compiled(node, ChunkKind::RULE);
+        }
+        else if (kind != ReactionKind::EVENT)
+        {
+            code = Compiled(m_Ast.Lhs(node), ChunkKind::EXPRESSION);
+            body = Compiled(m_Ast.Rhs(node), ChunkKind::BLOCK);
+        }
+
+        // Events hold just in the tick they fire in, every one of them counts
+        const bool level = kind == ReactionKind::WHENEVER
+            || (kind == ReactionKind::WHEN && m_Ast.Kind(m_Ast.Lhs(node)) == NodeKind::EVENT);
+
+        m_Reactions.push_back(Reaction{ kind, level, false, node, target, stamp, code, body });
+        return m_Graph.AddNode();
+    }
+
+    GraphNode Runtime::Event(SymbolId event)
+    {
+        const auto [it, added] = m_Events.try_emplace(event, DependencyGraph::s_NoNode);
+        if (added)
+            it->second = AddReaction(ReactionKind::EVENT, Ast::s_NoNode, event);
+        return it->second;
+    }
+
+    void Runtime::Depend(NodeId expression, GraphNode node)
+    {
+        if (expression == Ast::s_NoNode)
+            return;
+
+        switch (m_Ast.Kind(expression))
+        {
+        case NodeKind::NAME:
+            m_Graph.AddEdge(m_Resolution.Slot(expression), node);
+            return;
+        case NodeKind::EVENT:
+            m_Graph.AddEdge(Event(m_Ast.Symbol(expression)), node);
+            return;
+        case NodeKind::CALL:
+        {
+            // Functions are not bindings, only the arguments are read
+            const std::span<const NodeId> children = m_Ast.Children(expression);
+            if (m_Ast.Kind(children.front()) != NodeKind::NAME)
+                Depend(children.front(), node);
+            for (const NodeId argument : children.subspan(1UL))
+                Depend(argument, node);
+            return;
+        }
+        case NodeKind::PIPE:
+            Depend(m_Ast.Lhs(expression), node);
+            if (m_Ast.Kind(m_Ast.Rhs(expression)) != NodeKind::NAME)
+                Depend(m_Ast.Rhs(expression), node);
+            return;
+        case NodeKind::LIST:
+        case NodeKind::TUPLE:
+            for (const NodeId element : m_Ast.Children(expression))
+                Depend(element, node);
+            return;
+        case NodeKind::BINARY:
+        case NodeKind::UNARY:
+        case NodeKind::EXIST:
+        case NodeKind::MEMBER:
+            Depend(m_Ast.Lhs(expression), node);
+            if (m_Ast.Kind(expression) == NodeKind::BINARY)
+                Depend(m_Ast.Rhs(expression), node);
+            return;
+        default:
+            return;
+        }
+    }
+
+    Chunk* Runtime::Compiled(NodeId node, ChunkKind kind)
+    {
+        Chunk*& chunk = m_ChunkOf[node];
+        if (chunk)
+            return chunk;
+
+        switch (kind)
+        {
+        case ChunkKind::EXPRESSION: m_Chunks.push_back(m_Compiler.CompileExpression(node)); break;
+        case ChunkKind::RULE:       m_Chunks.push_back(m_Compiler.CompileRule(node)); break;
+        case ChunkKind::BLOCK:      m_Chunks.push_back(m_Compiler.CompileBlock(node)); break;
+        }
+
+        chunk = &m_Chunks.back();
+        return chunk;
+    }
+
+    void Runtime::Commit()
+    {
+        std::vector<Binding>& bindings = m_State.bindings;
+        std::vector<Effect>& effects = m_Machine.Effects();
+
+        // What was written or defined before a deletion later in the tick
+        // is gone with the binding, whatever order the nodes ran in
+        std::erase_if(effects, [&bindings](const Effect& effect) {
+            return effect.generation != bindings[effect.slot].generation;
+        });
+
+        // Cycles are reported at the definitions that closed them
+        for (const Effect& effect : effects)
+            if (effect.statement != Ast::s_NoNode)
+                bindings[effect.slot].definition = effect.statement;
+
+        if (m_Graph.Dirty())
+        {
+            for (const auto& [from, to] : m_Graph.Build())
+            {
+                const NodeId statement = IsBinding(to) ? bindings[to].definition : ReactionOf(to).node;
+                Fail(statement, "binding depends on itself");
+            }
+        }
+
+        const uint32_t tick = m_Graph.CurrentTick();
+
+        for (const Effect& effect : effects)
+        {
+            Binding& binding = bindings[effect.slot];
+
+            if (effect.statement != Ast::s_NoNode)
+            {
+                // A definition, it is evaluated in its own node. Compiled
+                // here, as nothing may be compiled while workers run.
+                binding.definition = effect.statement;
+                Compiled(m_Ast.Rhs(effect.statement), ChunkKind::EXPRESSION);
+                m_Graph.Schedule(effect.slot);
+                continue;
+            }
+
+            binding.definition = Ast::s_NoNode;
+            if (binding.exists && binding.value == effect.value)
+                continue;
+
+            binding.value = effect.value;
+            binding.exists = true;
+            binding.changedIn = tick;
+            m_Graph.Schedule(effect.slot);
+        }
+        effects.clear();
+
+        for (const GraphNode node : m_Deferred)
+            m_Graph.Schedule(node);
+        m_Deferred.clear();
+
+        while (const std::optional<SymbolId> event = m_Emitted.Pop())
+        {
+            const GraphNode node = Event(event.value());
+            ReactionOf(node).stamp = tick;
+            m_Graph.Schedule(node);
+        }
+    }
+
+    bool Runtime::Recompute(GraphNode node, VirtualMachine& machine, VmHost& host)
+    {
+        if (IsBinding(node))
+        {
+            Binding& binding = m_State.bindings[node];
+            if (binding.definition == Ast::s_NoNode)
+                return binding.exists && binding.changedIn == m_Graph.CurrentTick();
+
+            const Value value = machine.Execute(*Compiled(m_Ast.Rhs(binding.definition), ChunkKind::EXPRESSION), m_State, host);
+            if (binding.exists && binding.value == value)
+                return false;
+
+            binding.value = value;
+            binding.exists = true;
+            return true;
+        }
+
+        Reaction& reaction = ReactionOf(node);
+        switch (reaction.kind)
+        {
+        case ReactionKind::EVENT:
+            return true;
+        case ReactionKind::RULE:
+            // A deleted binding takes its rules with it
+            if (m_State.bindings[reaction.target].generation == reaction.stamp)
+                machine.Execute(*reaction.code, m_State, host);
+            return false;
+        case ReactionKind::ON:
+        {
+            const NodeId subject = m_Ast.Lhs(reaction.node);
+            if (m_Ast.Kind(subject) == NodeKind::NAME && !m_State.bindings[m_Resolution.Slot(subject)].exists)
+                return false;
+            machine.Execute(*reaction.body, m_State, host);
+            return false;
+        }
+        case ReactionKind::WHEN:
+        case ReactionKind::WHENEVER:
+        {
+            const bool holds = machine.Execute(*reaction.code, m_State, host).Truthy();
+            const bool fire = holds && (reaction.level || !reaction.held);
+            reaction.held = holds;
+            if (fire)
+                machine.Execute(*reaction.body, m_State, host);
+            return false;
+        }
+        }
+        return false;
+    }
+
+    void Runtime::RecomputeHeight(std::span<const GraphNode> nodes, std::span<uint8_t> changed)
+    {
+        if (nodes.size() < s_ParallelHeight)
+        {
+            for (size_t i = 0UL; i < nodes.size(); i++)
+                changed[i] = Recompute(nodes[i], m_Machine, *this);
+            return;
+        }
+
+        const uint32_t waves = Plan(nodes);
+        const std::function<void(size_t, size_t)> run = [this](size_t index, size_t worker)
+        {
+            Task& task = m_Tasks[m_Order[index]];
+            Worker& host = *m_Workers[worker];
+
+            task.worker = static_cast<uint32_t>(worker);
+            task.effects = static_cast<uint32_t>(host.machine.Effects().size());
+            task.errors = static_cast<uint32_t>(host.errors.size());
+            task.printed = host.printedSize;
+
+            task.changed = Recompute(task.node, host.machine, host);
+
+            task.effectsEnd = static_cast<uint32_t>(host.machine.Effects().size());
+            task.errorsEnd = static_cast<uint32_t>(host.errors.size());
+            task.printedEnd = host.printedSize;
+        };
+
+        // The waves run one after the other, m_Order holds the tasks of each
+        // one in node order
+        size_t first = 0UL;
+        for (uint32_t wave = 0U; wave < waves; wave++)
+        {
+            size_t last = first;
+            while (last < m_Order.size() && m_Tasks[m_Order[last]].wave == wave)
+                last++;
+
+            const size_t offset = first;
+            m_Pool->ParallelFor(last - first, [&run, offset](size_t index, size_t worker) { run(offset + index, worker); });
+            first = last;
+        }
+
+        // Merged in node order, as if they had run one by one
+        std::vector<std::string> printed(m_Workers.size());
+        for (size_t i = 0UL; i < m_Workers.size(); i++)
+            if (m_Workers[i]->printedSize)
+                printed[i] = m_Workers[i]->printed.str();
+
+        std::vector<Effect>& effects = m_Machine.Effects();
+        for (size_t i = 0UL; i < m_Tasks.size(); i++)
+        {
+            const Task& task = m_Tasks[i];
+            Worker& worker = *m_Workers[task.worker];
+
+            changed[i] = task.changed;
+            effects.insert(effects.end(), worker.machine.Effects().begin() + task.effects,
+                           worker.machine.Effects().begin() + task.effectsEnd);
+            m_Errors.insert(m_Errors.end(), worker.errors.begin() + task.errors, worker.errors.begin() + task.errorsEnd);
+            if (task.printedEnd > task.printed)
+                m_Out.write(printed[task.worker].data() + task.printed, static_cast<std::streamsize>(task.printedEnd - task.printed));
+        }
+
+        for (const std::unique_ptr<Worker>& worker : m_Workers)
+        {
+            worker->machine.Effects().clear();
+            worker->errors.clear();
+            worker->printed.str(std::string());
+            worker->printedSize = 0UL;
+        }
+    }
+
+    bool Runtime::Access(GraphNode node)
+    {
+        m_Reads.clear();
+        m_Writes.clear();
+
+        if (IsBinding(node))
+        {
+            const Binding& binding = m_State.bindings[node];
+            // A definition writes its binding right away
+            if (binding.definition != Ast::s_NoNode)
+            {
+                AccessChunk(m_ChunkOf[m_Ast.Rhs(binding.definition)]);
+                m_Writes.push_back(node);
+            }
+            else
+            {
+                m_Reads.push_back(node);
+            }
+            return false;
+        }
+
+        const Reaction& reaction = ReactionOf(node);
+        if (reaction.kind == ReactionKind::ON)
+        {
+            const NodeId subject = m_Ast.Lhs(reaction.node);
+            if (m_Ast.Kind(subject) == NodeKind::NAME)
+                m_Reads.push_back(m_Resolution.Slot(subject));
+        }
+
+        AccessChunk(reaction.code);
+        AccessChunk(reaction.body);
+        return (reaction.code && reaction.code->exclusive) || (reaction.body && reaction.body->exclusive);
+    }
+
+    void Runtime::AccessChunk(const Chunk* chunk)
+    {
+        if (!chunk)
+            return;
+
+        m_Reads.insert(m_Reads.end(), chunk->slots.begin(), chunk->slots.end());
+        m_Writes.insert(m_Writes.end(), chunk->deletes.begin(), chunk->deletes.end());
+    }
+
+    uint32_t Runtime::Plan(std::span<const GraphNode> nodes)
+    {
+        m_Tasks.clear();
+        uint32_t waves = 0U;
+        // Nothing goes before the last node that ran alone
+        uint32_t barrier = 0U;
+
+        const auto touch = [this](SlotId slot)
+        {
+            if (!m_ReadIn[slot] && !m_WrittenIn[slot])
+                m_Touched.push_back(slot);
+        };
+
+        for (const GraphNode node : nodes)
+        {
+            const bool exclusive = Access(node);
+
+            uint32_t wave = exclusive ? waves : barrier;
+            for (const SlotId slot : m_Reads)
+                wave = std::max(wave, m_WrittenIn[slot]);
+            for (const SlotId slot : m_Writes)
+                wave = std::max({ wave, m_WrittenIn[slot], m_ReadIn[slot] });
+
+            for (const SlotId slot : m_Reads)
+            {
+                touch(slot);
+                m_ReadIn[slot] = std::max(m_ReadIn[slot], wave + 1U);
+            }
+            for (const SlotId slot : m_Writes)
+            {
+                touch(slot);
+                m_WrittenIn[slot] = wave + 1U;
+            }
+
+            if (exclusive)
+                barrier = wave + 1U;
+            waves = std::max(waves, wave + 1U);
+            m_Tasks.push_back(Task{ node, wave, 0U, false, 0U, 0U, 0U, 0U, 0UL, 0UL });
+        }
+
+        for (const SlotId slot : m_Touched)
+            m_ReadIn[slot] = m_WrittenIn[slot] = 0U;
+        m_Touched.clear();
+
+        // Counting sort by wave keeps node order within each one
+        std::vector<uint32_t> starts(waves + 1U, 0U);
+        for (const Task& task : m_Tasks)
+            starts[task.wave + 1U]++;
+        for (uint32_t wave = 0U; wave < waves; wave++)
+            starts[wave + 1U] += starts[wave];
+
+        m_Order.resize(m_Tasks.size());
+        for (uint32_t i = 0U; i < m_Tasks.size(); i++)
+            m_Order[starts[m_Tasks[i].wave]++] = i;
+        return waves;
+    }
+
+    void Runtime::Bind(NodeId statement, std::vector<Effect>& effects)
+    {
+        const SlotId slot = m_Resolution.Slot(m_Ast.Lhs(statement));
+        const NodeId value = m_Ast.Rhs(statement);
+
+        if (m_Ast.Operation(statement) == OperationType::DEFINE_BINDING)
+        {
+            Depend(value, slot);
+            effects.push_back(Effect{ statement, slot, Value::Nil(), m_State.bindings[slot].generation });
+            return;
+        }
+
+        // The rule writes for the first time in the next tick
+        const GraphNode node = AddReaction(ReactionKind::RULE, statement, slot);
+        Depend(value, node);
+        m_Deferred.push_back(node);
+    }
+
+    bool Runtime::EventFired(SymbolId event)
+    {
+        const auto it = m_Events.find(event);
+        return it != m_Events.end() && ReactionOf(it->second).stamp == m_Graph.CurrentTick();
+    }
+
+    void Runtime::Declare(NodeId statement, std::vector<Effect>& effects)
+    {
+        switch (m_Ast.Kind(statement))
+        {
+        case NodeKind::BINDING:
+            Bind(statement, effects);
+            return;
+        case NodeKind::WHEN:
+        case NodeKind::WHENEVER:
+        case NodeKind::ON:
+        {
+            const NodeKind kind = m_Ast.Kind(statement);
+            const GraphNode node = AddReaction(kind == NodeKind::WHEN ? ReactionKind::WHEN
+                : kind == NodeKind::WHENEVER ? ReactionKind::WHENEVER : ReactionKind::ON, statement, 0U);
+            Depend(m_Ast.Lhs(statement), node);
+            // Conditions are checked right away, `on` waits for a change
+            if (kind != NodeKind::ON)
+                m_Deferred.push_back(node);
+            return;
+        }
+        default:
+            return;
+        }
+    }
+
+    void Runtime::Delete(SlotId slot, bool recursive)
+    {
+        Binding& binding = m_State.bindings[slot];
+        if (!binding.exists)
+            return;
+
+        binding.exists = false;
+        binding.generation++;
+        binding.value = Value::Nil();
+        binding.definition = Ast::s_NoNode;
+
+        if (!recursive)
+            return;
+
+        // `~!` also takes every binding derived from it
+        for (const GraphNode dependent : m_Graph.Dependents(slot))
+            if (IsBinding(dependent) && m_State.bindings[dependent].definition != Ast::s_NoNode)
+                Delete(dependent, true);
+    }
+
+    void Runtime::Print(std::span<const Value> values)
+    {
+        for (size_t i = 0UL; i < values.size(); i++)
+            m_Out << (i ? " " : "") << values[i];
+        m_Out << '\n';
+    }
+
+    std::string_view Runtime::Concatenate(std::string_view lhs, std::string_view rhs)
+    {
+        char* text = static_cast<char*>(m_Resource->allocate(lhs.size() + rhs.size(), 1UL));
+        std::memcpy(text, lhs.data(), lhs.size());
+        std::memcpy(text + lhs.size(), rhs.data(), rhs.size());
+        return std::string_view(text, lhs.size() + rhs.size());
+    }
+
+    void Runtime::Fail(NodeId node, std::string_view message)
+    {
+        m_Errors.push_back(RuntimeError{ m_Ast.Token(node), message });
+    }
+
+    bool Runtime::Worker::EventFired(SymbolId event)
+    {
+        return runtime.EventFired(event);
+    }
+
+    void Runtime::Worker::Declare(NodeId statement, std::vector<Effect>& effects)
+    {
+        runtime.Declare(statement, effects);
+    }
+
+    void Runtime::Worker::Delete(SlotId slot, bool recursive)
+    {
+        runtime.Delete(slot, recursive);
+    }
+
+    void Runtime::Worker::Print(std::span<const Value> values)
+    {
+        for (size_t i = 0UL; i < values.size(); i++)
+            printed << (i ? " " : "") << values[i];
+        printed << '\n';
+        printedSize = static_cast<size_t>(printed.tellp());
+    }
+
+    std::string_view Runtime::Worker::Concatenate(std::string_view lhs, std::string_view rhs)
+    {
+        char* text = static_cast<char*>(arena.Allocate(lhs.size() + rhs.size(), 1UL));
+        std::memcpy(text, lhs.data(), lhs.size());
+        std::memcpy(text + lhs.size(), rhs.data(), rhs.size());
+        return std::string_view(text, lhs.size() + rhs.size());
+    }
+
+    void Runtime::Worker::Fail(NodeId node, std::string_view message)
+    {
+        errors.push_back(RuntimeError{ runtime.m_Ast.Token(node), message });
+    }
+} // namespace Aesthetic
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "compiler.hpp"
+#include "dependency_graph.hpp"
+#include "resolver.hpp"
+#include "value.hpp"
+#include "vm.hpp"
+#include "memory/arena.hpp"
+#include "parser/ast.hpp"
+#include "util/mpsc_queue.hpp"
+#include "util/work_stealing_pool.hpp"
+
+namespace Aesthetic
+{
+    struct RuntimeError
+    {
+        // Token the error was found at
+        uint32_t token;
+        std::string_view message;
+    };
+
+    // Runs a parsed program reactively on top of a DependencyGraph. Every
+    // binding is the node of its slot in the Resolution. `::=` makes it a derived node
+    // recomputed whenever its inputs change, `:=` adds a rule writing it
+    // whenever the inputs of the value change, and handlers are nodes
+    // depending on their condition. Their code is compiled to bytecode the
+    // first time it runs.
+    //
+    // A tick propagates all changes of the previous one. Writes, definitions
+    // and new handlers take effect once the tick is over, so every node sees
+    // one consistent state and feedback like `x := x + 1` moves one step per
+    // tick. Only deletions are immediate: handlers of the same tick that have
+    // not run yet no longer see the binding.
+    //
+    // With more than one thread, the nodes of a height are recomputed on a
+    // WorkStealingPool. They never depend on each other, so only immediate
+    // deletions and definitions can conflict: a node is put in a later wave
+    // than every earlier node of the height it conflicts with, and one that
+    // declares anything runs alone. Writes, output and errors of the workers
+    // are merged in node order afterwards, so a program behaves the same on
+    // any number of threads.
+    class Runtime : private VmHost
+    {
+    public:
+        // Heights with fewer scheduled nodes are not worth waking the workers for
+        static constexpr size_t s_ParallelHeight = 16UL;
+    private:
+        enum class ReactionKind : uint8_t
+        {
+            EVENT    = 0U,
+            RULE     = 1U,
+            WHEN     = 2U,
+            WHENEVER = 3U,
+            ON       = 4U,
+        };
+
+        enum class ChunkKind : uint8_t
+        {
+            EXPRESSION = 0U,
+            RULE       = 1U,
+            BLOCK      = 2U,
+        };
+
+        // Node above the bindings: an event source, a `:=` rule or a handler
+        struct Reaction
+        {
+            ReactionKind kind;
+            // Whether the handler fires every time the condition holds, not
+            // just as it starts to
+            bool level;
+            // Whether the condition of `when` held last time
+            bool held;
+            // The statement, its rhs is the value of rules, its lhs the condition of handlers
+            NodeId node;
+            // Slot written by rules, symbol named by events
+            uint32_t target;
+            // Tick an event fired in, generation of the binding a rule writes
+            uint32_t stamp;
+            // The rule, or the condition and the block of a handler
+            Chunk* code;
+            Chunk* body;
+        };
+
+        // Host of the nodes recomputed on a worker thread. What they print
+        // and the errors they make are held back until the height is done.
+        struct Worker final : VmHost
+        {
+            Runtime& runtime;
+            VirtualMachine machine;
+            // Strings concatenated on this worker, they live as long as the runtime
+            Arena arena;
+            std::ostringstream printed;
+            // Bytes in `printed`, kept here as asking the stream is slow
+            size_t printedSize = 0UL;
+            std::vector<RuntimeError> errors;
+
+            explicit Worker(Runtime& runtime) : runtime(runtime) {}
+
+            bool EventFired(SymbolId event) override;
+            void Declare(NodeId statement, std::vector<Effect>& effects) override;
+            void Delete(SlotId slot, bool recursive) override;
+            void Print(std::span<const Value> values) override;
+            std::string_view Concatenate(std::string_view lhs, std::string_view rhs) override;
+            void Fail(NodeId node, std::string_view message) override;
+        };
+
+        // A node of the height being recomputed in parallel, and the part of
+        // its worker's effects, output and errors it left
+        struct Task
+        {
+            GraphNode node;
+            uint32_t wave;
+            uint32_t worker;
+            bool changed;
+            uint32_t effects;
+            uint32_t effectsEnd;
+            uint32_t errors;
+            uint32_t errorsEnd;
+            size_t printed;
+            size_t printedEnd;
+        };
+
+        const Ast& m_Ast;
+        const Resolution& m_Resolution;
+        std::ostream& m_Out;
+        std::pmr::memory_resource* m_Resource;
+        DependencyGraph m_Graph;
+        BytecodeCompiler m_Compiler;
+        VirtualMachine m_Machine;
+        VmState m_State;
+        // Compiled code never moves, reactions point into it
+        std::deque<Chunk> m_Chunks;
+        // Chunk of the definitions and handler blocks, by node
+        std::vector<Chunk*> m_ChunkOf;
+        std::vector<Reaction> m_Reactions;
+        std::unordered_map<SymbolId, GraphNode> m_Events;
+        std::vector<GraphNode> m_Deferred;
+        // Events can be emitted from any thread
+        MpscQueue<SymbolId> m_Emitted;
+        std::vector<RuntimeError> m_Errors;
+        SymbolId m_Start;
+        size_t m_Ticks;
+
+        // Nothing of this is used on a single thread
+        std::unique_ptr<WorkStealingPool> m_Pool;
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::vector<Task> m_Tasks;
+        // Tasks sorted by wave
+        std::vector<uint32_t> m_Order;
+        // One past the last wave reading and writing a binding, by SlotId
+        std::vector<uint32_t> m_ReadIn;
+        std::vector<uint32_t> m_WrittenIn;
+        std::vector<SlotId> m_Touched;
+        std::vector<SlotId> m_Reads;
+        std::vector<SlotId> m_Writes;
+    public:
+        // `resolution` has to be of `ast`. Zero threads means one per hardware thread.
+        Runtime(const Ast& ast, const Resolution& resolution, std::ostream& out,
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                size_t threads = 1UL);
+
+        // Runs the top level statements and fires `#start`
+        void Start();
+        // Fires an event in the next tick, from any thread
+        void Emit(SymbolId event);
+        // Propagates everything that changed, false when nothing did
+        bool Tick();
+        // Starts and ticks until the program settles, returns the ticks taken
+        size_t Run(size_t maxTicks = SIZE_MAX);
+
+        size_t Ticks() const { return m_Ticks; }
+        size_t Threads() const { return m_Pool ? m_Pool->Size() : 1UL; }
+        const DependencyGraph& Graph() const { return m_Graph; }
+        // Current value of the global binding of `symbol`, nil if it does not exist
+        Value Get(SymbolId symbol) const;
+        bool Exists(SymbolId symbol) const;
+        const std::vector<RuntimeError>& Errors() const { return m_Errors; }
+    private:
+        bool IsBinding(GraphNode node) const { return node < m_State.bindings.size(); }
+        Reaction& ReactionOf(GraphNode node) { return m_Reactions[node - m_State.bindings.size()]; }
+        GraphNode AddReaction(ReactionKind kind, NodeId node, uint32_t target);
+        GraphNode Event(SymbolId event);
+        // Adds an edge from everything `expression` reads to `node`
+        void Depend(NodeId expression, GraphNode node);
+
+        // Compiles `node` the first time it is needed
+        Chunk* Compiled(NodeId node, ChunkKind kind);
+
+        // Applies the effects of the tick that is over and schedules the next
+        void Commit();
+        bool Recompute(GraphNode node, VirtualMachine& machine, VmHost& host);
+        void RecomputeHeight(std::span<const GraphNode> nodes, std::span<uint8_t> changed);
+        // Bindings `node` reads and deletes while it runs into m_Reads and
+        // m_Writes, true when it has to run alone
+        bool Access(GraphNode node);
+        void AccessChunk(const Chunk* chunk);
+        // Fills m_Tasks and m_Order, returns the number of waves
+        uint32_t Plan(std::span<const GraphNode> nodes);
+        void Bind(NodeId statement, std::vector<Effect>& effects);
+
+        bool EventFired(SymbolId event) override;
+        void Declare(NodeId statement, std::vector<Effect>& effects) override;
+        void Delete(SlotId slot, bool recursive) override;
+        void Print(std::span<const Value> values) override;
+        std::string_view Concatenate(std::string_view lhs, std::string_view rhs) override;
+        void Fail(NodeId node, std::string_view message) override;
+    };
+} // namespace Aesthetic
@@ -0,0 +1,143 @@
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+#include "value.hpp"
+
+namespace Aesthetic
+{
+    bool Value::operator==(const Value& other) const
+    {
+        if (IsNumber() && other.IsNumber())
+        {
+            if (kind == ValueKind::INTEGER && other.kind == ValueKind::INTEGER)
+                return integer == other.integer;
+            return AsNumber() == other.AsNumber();
+        }
+
+        if (kind != other.kind)
+            return false;
+
+        switch (kind)
+        {
+            case ValueKind::BOOLEAN: return boolean == other.boolean;
+            case ValueKind::STRING:  return Text() == other.Text();
+            default:                 return true;
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& out, const Value& value)
+    {
+        switch (value.kind)
+        {
+            case ValueKind::NIL:     return out << "nil";
+            case ValueKind::BOOLEAN: return out << (value.boolean ? "true" : "false");
+            case ValueKind::INTEGER: return out << value.integer;
+            case ValueKind::STRING:  return out << value.Text();
+            case ValueKind::FLOATING_POINT:
+            {
+                char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+                const auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value.number);
+                return out.write(buffer, end - buffer);
+#else
+                const int length = std::snprintf(buffer, sizeof(buffer), "%.17g", value.number);
+                return out.write(buffer, length);
+#endif
+            }
+        }
+        return out;
+    }
+
+    static std::optional<Value> Compare(OperationType operation, int order)
+    {
+        switch (operation)
+        {
+            case OperationType::LESS:          return Value::Boolean(order < 0);
+            case OperationType::LESS_EQUAL:    return Value::Boolean(order <= 0);
+            case OperationType::GREATER:       return Value::Boolean(order > 0);
+            case OperationType::GREATER_EQUAL: return Value::Boolean(order >= 0);
+            default:                           return std::nullopt;
+        }
+    }
+
+    static std::optional<Value> IntegerArithmetic(OperationType operation, int64_t lhs, int64_t rhs)
+    {
+        // Wraps around like the unsigned literals it comes from
+        const uint64_t a = static_cast<uint64_t>(lhs);
+        const uint64_t b = static_cast<uint64_t>(rhs);
+
+        switch (operation)
+        {
+            case OperationType::ADDITION:       return Value::Integer(static_cast<int64_t>(a + b));
+            case OperationType::SUBSTRACTION:   return Value::Integer(static_cast<int64_t>(a - b));
+            case OperationType::MULTIPLICATION: return Value::Integer(static_cast<int64_t>(a * b));
+            case OperationType::FLOAT_DIVISION:
+                return Value::FloatingPoint(static_cast<double>(lhs) / static_cast<double>(rhs));
+            case OperationType::INTEGER_DIVISION:
+                if (!rhs || (lhs == INT64_MIN && rhs == -1))
+                    return std::nullopt;
+                return Value::Integer(lhs / rhs - ((lhs % rhs) && ((lhs < 0) != (rhs < 0))));
+            default:
+                return Compare(operation, (lhs > rhs) - (lhs < rhs));
+        }
+    }
+
+    static std::optional<Value> FloatingPointArithmetic(OperationType operation, double lhs, double rhs)
+    {
+        switch (operation)
+        {
+            case OperationType::ADDITION:         return Value::FloatingPoint(lhs + rhs);
+            case OperationType::SUBSTRACTION:     return Value::FloatingPoint(lhs - rhs);
+            case OperationType::MULTIPLICATION:   return Value::FloatingPoint(lhs * rhs);
+            case OperationType::FLOAT_DIVISION:   return Value::FloatingPoint(lhs / rhs);
+            case OperationType::INTEGER_DIVISION: return Value::FloatingPoint(std::floor(lhs / rhs));
+            default:
+                // NaN is unordered, none of the comparisons hold
+                if ((std::isnan(lhs) || std::isnan(rhs)) && Compare(operation, 0))
+                    return Value::Boolean(false);
+                return Compare(operation, (lhs > rhs) - (lhs < rhs));
+        }
+    }
+
+    std::optional<Value> ApplyBinary(OperationType operation, const Value& lhs, const Value& rhs)
+    {
+        if (operation == OperationType::EQUAL)
+            return Value::Boolean(lhs == rhs);
+        if (operation == OperationType::NOT_EQUAL)
+            return Value::Boolean(!(lhs == rhs));
+
+        // Nothing is ordered against nil, and arithmetic on it stays nil
+        if (lhs.kind == ValueKind::NIL || rhs.kind == ValueKind::NIL)
+            return Compare(operation, 0) ? Value::Boolean(false) : Value::Nil();
+
+        if (lhs.kind == ValueKind::INTEGER && rhs.kind == ValueKind::INTEGER)
+            return IntegerArithmetic(operation, lhs.integer, rhs.integer);
+        if (lhs.IsNumber() && rhs.IsNumber())
+            return FloatingPointArithmetic(operation, lhs.AsNumber(), rhs.AsNumber());
+        if (lhs.kind == ValueKind::STRING && rhs.kind == ValueKind::STRING)
+            return Compare(operation, lhs.Text().compare(rhs.Text()));
+
+        return std::nullopt;
+    }
+
+    std::optional<Value> ApplyUnary(OperationType operation, const Value& operand)
+    {
+        if (operand.kind == ValueKind::NIL)
+            return Value::Nil();
+        if (!operand.IsNumber())
+            return std::nullopt;
+
+        switch (operation)
+        {
+            case OperationType::ADDITION:
+                return operand;
+            case OperationType::SUBSTRACTION:
+                if (operand.kind == ValueKind::INTEGER)
+                    return Value::Integer(static_cast<int64_t>(0ULL - static_cast<uint64_t>(operand.integer)));
+                return Value::FloatingPoint(-operand.number);
+            default:
+                return std::nullopt;
+        }
+    }
+} // namespace Aesthetic
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+#include "lexer/token.hpp"
+
+namespace Aesthetic
+{
+    enum class ValueKind : uint8_t
+    {
+        // What a deleted or never defined binding reads as
+        NIL            = 0U,
+        BOOLEAN        = 1U,
+        INTEGER        = 2U,
+        FLOATING_POINT = 3U,
+        STRING         = 4U,
+    };
+
+    // Value of a binding or an expression in 16 bytes. Strings are not
+    // owned, they point into the source, into values the token stream
+    // decoded or into storage of the runtime.
+    struct Value
+    {
+        ValueKind kind = ValueKind::NIL;
+        // Bytes of a string
+        uint32_t length = 0U;
+        union
+        {
+            bool boolean;
+            int64_t integer;
+            double number = 0.0;
+            const char* text;
+        };
+
+        static Value Nil() { return Value{}; }
+        static Value Boolean(bool boolean) { Value value; value.kind = ValueKind::BOOLEAN; value.boolean = boolean; return value; }
+        static Value Integer(int64_t integer) { Value value; value.kind = ValueKind::INTEGER; value.integer = integer; return value; }
+        static Value FloatingPoint(double number) { Value value; value.kind = ValueKind::FLOATING_POINT; value.number = number; return value; }
+        static Value String(std::string_view string)
+        {
+            Value value;
+            value.kind = ValueKind::STRING;
+            value.length = static_cast<uint32_t>(string.size());
+            value.text = string.data();
+            return value;
+        }
+
+        std::string_view Text() const { return std::string_view(text, length); }
+        bool IsNumber() const { return kind == ValueKind::INTEGER || kind == ValueKind::FLOATING_POINT; }
+        double AsNumber() const { return kind == ValueKind::INTEGER ? static_cast<double>(integer) : number; }
+        // Whether a condition holding the value is met
+        bool Truthy() const
+        {
+            switch (kind)
+            {
+                case ValueKind::NIL:            return false;
+                case ValueKind::BOOLEAN:        return boolean;
+                case ValueKind::INTEGER:        return integer != 0;
+                case ValueKind::FLOATING_POINT: return number != 0.0;
+                case ValueKind::STRING:         return length != 0U;
+            }
+            return false;
+        }
+
+        bool operator==(const Value& other) const;
+        friend std::ostream& operator<<(std::ostream& out, const Value& value);
+    };
+
+    // Arithmetic and comparisons, nothing when the operation is not defined
+    // for the operands. Nil makes arithmetic nil and orderings false. Adding
+    // strings is left to the caller, it needs storage.
+    std::optional<Value> ApplyBinary(OperationType operation, const Value& lhs, const Value& rhs);
+    // Prefix `-` and `+`
+    std::optional<Value> ApplyUnary(OperationType operation, const Value& operand);
+} // namespace Aesthetic
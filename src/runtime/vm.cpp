@@ -0,0 +1,247 @@
+#include "vm.hpp"
+
+#if defined(__GNUC__)
+    #define AE_THREADED_DISPATCH 1
+#else
+    #define AE_THREADED_DISPATCH 0
+#endif
+
+namespace Aesthetic
+{
+    // Integer operands, the common case, without leaving the instruction.
+    // False when the result needs the general path.
+    template<OperationType Operation>
+    static inline bool IntegerBinary(int64_t lhs, int64_t rhs, Value& out)
+    {
+        const uint64_t a = static_cast<uint64_t>(lhs);
+        const uint64_t b = static_cast<uint64_t>(rhs);
+
+        if constexpr (Operation == OperationType::ADDITION)
+            out = Value::Integer(static_cast<int64_t>(a + b));
+        else if constexpr (Operation == OperationType::SUBSTRACTION)
+            out = Value::Integer(static_cast<int64_t>(a - b));
+        else if constexpr (Operation == OperationType::MULTIPLICATION)
+            out = Value::Integer(static_cast<int64_t>(a * b));
+        else if constexpr (Operation == OperationType::FLOAT_DIVISION)
+            out = Value::FloatingPoint(static_cast<double>(lhs) / static_cast<double>(rhs));
+        else if constexpr (Operation == OperationType::INTEGER_DIVISION)
+            return false;
+        else if constexpr (Operation == OperationType::LESS)
+            out = Value::Boolean(lhs < rhs);
+        else if constexpr (Operation == OperationType::LESS_EQUAL)
+            out = Value::Boolean(lhs <= rhs);
+        else if constexpr (Operation == OperationType::GREATER)
+            out = Value::Boolean(lhs > rhs);
+        else if constexpr (Operation == OperationType::GREATER_EQUAL)
+            out = Value::Boolean(lhs >= rhs);
+        else if constexpr (Operation == OperationType::EQUAL)
+            out = Value::Boolean(lhs == rhs);
+        else if constexpr (Operation == OperationType::NOT_EQUAL)
+            out = Value::Boolean(lhs != rhs);
+        else
+            return false;
+
+        return true;
+    }
+
+    static void GeneralBinary(OperationType operation, Value& out, const Value& lhs, const Value& rhs, VmHost& host, NodeId node)
+    {
+        if (operation == OperationType::ADDITION && lhs.kind == ValueKind::STRING && rhs.kind == ValueKind::STRING)
+        {
+            out = Value::String(host.Concatenate(lhs.Text(), rhs.Text()));
+            return;
+        }
+
+        if (const std::optional<Value> result = ApplyBinary(operation, lhs, rhs))
+        {
+            out = result.value();
+            return;
+        }
+
+        host.Fail(node, "operands do not support the operator");
+        out = Value::Nil();
+    }
+
+    template<OperationType Operation>
+    static inline void Binary(Value& out, const Value& lhs, const Value& rhs, VmHost& host, const NodeId& node)
+    {
+        if (lhs.kind == ValueKind::INTEGER && rhs.kind == ValueKind::INTEGER && IntegerBinary<Operation>(lhs.integer, rhs.integer, out))
+            return;
+        GeneralBinary(Operation, out, lhs, rhs, host, node);
+    }
+
+    Value VirtualMachine::Execute(const Chunk& chunk, VmState& state, VmHost& host)
+    {
+        const size_t base = m_Top;
+        if (m_Registers.size() < base + chunk.registers)
+            m_Registers.resize(base + chunk.registers);
+        m_Top = base + chunk.registers;
+
+        Value* const R = m_Registers.data() + base;
+        const Value* const K = chunk.constants.data();
+        const Instruction* const code = chunk.code.data();
+        const Instruction* ip = code;
+
+        // Slots were resolved at compile time and the table never moves
+        Binding* const B = state.bindings.data();
+        #define AE_NODE chunk.nodes[ip - code]
+
+#if AE_THREADED_DISPATCH
+        static const void* const s_Labels[] = {
+            #define AE_OPCODE(name) &&op_##name,
+            #define AE_BINARY_OPCODE(name, operation) &&op_##name, &&op_##name##_CONSTANT, &&op_##name##_BINDING_CONSTANT,
+            AE_OPCODES(AE_OPCODE)
+            AE_BINARY_OPCODES(AE_BINARY_OPCODE)
+            #undef AE_BINARY_OPCODE
+            #undef AE_OPCODE
+        };
+        #define VM_CASE(name) op_##name:
+        #define VM_DISPATCH() goto *s_Labels[static_cast<uint8_t>(ip->op)]
+
+        VM_DISPATCH();
+        {
+#else
+        #define VM_CASE(name) case OpCode::name:
+        #define VM_DISPATCH() continue
+
+        for (;;)
+        {
+            switch (ip->op)
+            {
+#endif
+        #define VM_NEXT() ip++; VM_DISPATCH()
+
+            VM_CASE(LOAD_NIL)
+            {
+                R[ip->a] = Value::Nil();
+                VM_NEXT();
+            }
+            VM_CASE(LOAD_CONSTANT)
+            {
+                R[ip->a] = K[ip->c];
+                VM_NEXT();
+            }
+            VM_CASE(LOAD_BINDING)
+            {
+                R[ip->a] = B[ip->c].value;
+                VM_NEXT();
+            }
+            VM_CASE(LOAD_EVENT)
+            {
+                R[ip->a] = Value::Boolean(host.EventFired(ip->c));
+                VM_NEXT();
+            }
+            VM_CASE(EXISTS)
+            {
+                R[ip->a] = Value::Boolean(B[ip->c].exists);
+                VM_NEXT();
+            }
+            VM_CASE(MOVE)
+            {
+                R[ip->a] = R[ip->b];
+                VM_NEXT();
+            }
+            VM_CASE(NEGATE)
+            VM_CASE(PLUS)
+            {
+                const OperationType operation = ip->op == OpCode::NEGATE ? OperationType::SUBSTRACTION : OperationType::ADDITION;
+                if (const std::optional<Value> result = ApplyUnary(operation, R[ip->b]))
+                {
+                    R[ip->a] = result.value();
+                }
+                else
+                {
+                    host.Fail(AE_NODE, "operand does not support the operator");
+                    R[ip->a] = Value::Nil();
+                }
+                VM_NEXT();
+            }
+            VM_CASE(JUMP)
+            {
+                ip = code + ip->c;
+                VM_DISPATCH();
+            }
+            VM_CASE(JUMP_IF_FALSE)
+            {
+                ip = R[ip->a].Truthy() ? ip + 1 : code + ip->c;
+                VM_DISPATCH();
+            }
+            VM_CASE(WRITE)
+            {
+                m_Effects.push_back(Effect{ Ast::s_NoNode, ip->c, R[ip->a], B[ip->c].generation });
+                VM_NEXT();
+            }
+            VM_CASE(STEP_BINDING)
+            {
+                Effect effect{ Ast::s_NoNode, ip->c, Value(), B[ip->c].generation };
+                Binary<OperationType::ADDITION>(effect.value, B[ip->c].value, K[ip->b], host, AE_NODE);
+                m_Effects.push_back(effect);
+                VM_NEXT();
+            }
+            VM_CASE(COPY_BINDING)
+            {
+                m_Effects.push_back(Effect{ Ast::s_NoNode, ip->c, B[ip->b].value, B[ip->c].generation });
+                VM_NEXT();
+            }
+            VM_CASE(DELETE)
+            {
+                host.Delete(ip->c, ip->a);
+                VM_NEXT();
+            }
+            VM_CASE(DECLARE)
+            {
+                host.Declare(ip->c, m_Effects);
+                VM_NEXT();
+            }
+            VM_CASE(PRINT)
+            {
+                host.Print(std::span<const Value>(R + ip->a, ip->b));
+                VM_NEXT();
+            }
+            VM_CASE(FAIL)
+            {
+                host.Fail(AE_NODE, chunk.messages[ip->b]);
+                R[ip->a] = Value::Nil();
+                VM_NEXT();
+            }
+            VM_CASE(RETURN)
+            {
+                m_Top = base;
+                return R[ip->a];
+            }
+
+            #define AE_BINARY_OPCODE(name, operation)                                                       \
+                VM_CASE(name)                                                                               \
+                {                                                                                           \
+                    Binary<OperationType::operation>(R[ip->a], R[ip->b], R[ip->c], host, AE_NODE);          \
+                    VM_NEXT();                                                                              \
+                }                                                                                           \
+                VM_CASE(name##_CONSTANT)                                                                    \
+                {                                                                                           \
+                    Binary<OperationType::operation>(R[ip->a], R[ip->b], K[ip->c], host, AE_NODE);          \
+                    VM_NEXT();                                                                              \
+                }                                                                                           \
+                VM_CASE(name##_BINDING_CONSTANT)                                                            \
+                {                                                                                           \
+                    Binary<OperationType::operation>(R[ip->a], B[ip->b].value, K[ip->c], host, AE_NODE); \
+                    VM_NEXT();                                                                              \
+                }
+            AE_BINARY_OPCODES(AE_BINARY_OPCODE)
+            #undef AE_BINARY_OPCODE
+
+#if AE_THREADED_DISPATCH
+        }
+#else
+            case OpCode::COUNT:
+                m_Top = base;
+                return Value::Nil();
+            }
+        }
+#endif
+
+        #undef VM_NEXT
+        #undef VM_DISPATCH
+        #undef VM_CASE
+        #undef AE_NODE
+    }
+} // namespace Aesthetic
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "bytecode.hpp"
+#include "value.hpp"
+
+namespace Aesthetic
+{
+    struct Binding
+    {
+        // Nil whenever the binding does not exist
+        Value value;
+        // The `::=` statement defining it, if it is derived
+        NodeId definition = Ast::s_NoNode;
+        uint32_t changedIn = 0U;
+        // Bumped by every deletion, rules only write the generation they were made for
+        uint32_t generation = 0U;
+        bool exists = false;
+    };
+
+    // Something that happens once the running tick is over: a write, or a
+    // definition if `statement` is set
+    struct Effect
+    {
+        NodeId statement;
+        SlotId slot;
+        Value value;
+        // Of the binding when it was made, a deletion later in the tick drops it
+        uint32_t generation;
+    };
+
+    // What compiled code reads directly
+    struct VmState
+    {
+        // Indexed by SlotId, sized once before anything runs
+        std::vector<Binding> bindings;
+    };
+
+    // Everything compiled code leaves to the runtime, none of it is on the
+    // hot path
+    class VmHost
+    {
+    public:
+        virtual ~VmHost() = default;
+
+        virtual bool EventFired(SymbolId event) = 0;
+        // `effects` are the ones of the code declaring it
+        virtual void Declare(NodeId statement, std::vector<Effect>& effects) = 0;
+        virtual void Delete(SlotId slot, bool recursive) = 0;
+        virtual void Print(std::span<const Value> values) = 0;
+        virtual std::string_view Concatenate(std::string_view lhs, std::string_view rhs) = 0;
+        virtual void Fail(NodeId node, std::string_view message) = 0;
+    };
+
+    // Runs Chunks with threaded dispatch where the compiler supports
+    // computed gotos, and a plain switch elsewhere. Registers of the chunks
+    // that run are windows into one stack. Writes are collected as effects
+    // for the runtime to apply, so machines on several threads can share
+    // one VmState as long as nothing deletes what another one reads.
+    class VirtualMachine
+    {
+    private:
+        std::vector<Value> m_Registers;
+        size_t m_Top;
+        std::vector<Effect> m_Effects;
+    public:
+        VirtualMachine() : m_Top(0UL) {}
+
+        Value Execute(const Chunk& chunk, VmState& state, VmHost& host);
+        // In the order the code ran
+        std::vector<Effect>& Effects() { return m_Effects; }
+    };
+} // namespace Aesthetic
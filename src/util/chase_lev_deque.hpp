@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace Aesthetic
+{
+    // Chase-Lev work-stealing deque, with the memory orderings of Lê et al.,
+    // "Correct and Efficient Work-Stealing for Weak Memory Models". The owner
+    // pushes and pops at the bottom like a stack, other threads steal the
+    // oldest items from the top. The ring grows when it is full. Rings it
+    // outgrew are kept until the deque is destroyed, as a thief may still
+    // be reading one.
+    template<typename T>
+    class ChaseLevDeque
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "items are copied racily and must be trivially copyable");
+    private:
+        struct Ring
+        {
+            size_t mask;
+            std::unique_ptr<std::atomic<T>[]> items;
+
+            explicit Ring(size_t capacity) : mask(capacity - 1UL), items(new std::atomic<T>[capacity]) {}
+
+            size_t Capacity() const { return mask + 1UL; }
+            T Load(int64_t index) const { return items[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed); }
+            void Store(int64_t index, T item) { items[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed); }
+        };
+
+        // Thieves and the owner each hammer their own end
+        alignas(64) std::atomic<int64_t> m_Top;
+        alignas(64) std::atomic<int64_t> m_Bottom;
+        std::atomic<Ring*> m_Ring;
+        // Owns every ring, only touched by the owner
+        std::vector<std::unique_ptr<Ring>> m_Rings;
+    public:
+        // `capacity` is rounded up to a power of two
+        explicit ChaseLevDeque(size_t capacity = 256UL)
+            : m_Top(0), m_Bottom(0)
+        {
+            size_t rounded = 1UL;
+            while (rounded < capacity)
+                rounded <<= 1U;
+
+            m_Rings.push_back(std::make_unique<Ring>(rounded));
+            m_Ring.store(m_Rings.back().get(), std::memory_order_relaxed);
+        }
+
+        ChaseLevDeque(const ChaseLevDeque&) = delete;
+        ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+        // Owner only
+        void Push(T item)
+        {
+            const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            const int64_t top = m_Top.load(std::memory_order_acquire);
+            Ring* ring = m_Ring.load(std::memory_order_relaxed);
+
+            if (bottom - top > static_cast<int64_t>(ring->mask))
+                ring = Grow(ring, top, bottom);
+
+            // A release store where the paper has a release fence, the same
+            // guarantee for thieves and one that thread sanitizers understand
+            ring->Store(bottom, item);
+            m_Bottom.store(bottom + 1, std::memory_order_release);
+        }
+
+        // Owner only, the newest item
+        std::optional<T> Pop()
+        {
+            const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            Ring* ring = m_Ring.load(std::memory_order_relaxed);
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            const T item = ring->Load(bottom);
+            if (top != bottom)
+                return item;
+
+            // The last item, a thief may be taking it at the same time
+            const bool won = m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            if (!won)
+                return std::nullopt;
+            return item;
+        }
+
+        // Any thread, the oldest item. Nothing when the deque is empty or
+        // another thread took the item first.
+        std::optional<T> Steal()
+        {
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return std::nullopt;
+
+            // Consume ordering in the paper, which every compiler promotes to acquire
+            const T item = m_Ring.load(std::memory_order_acquire)->Load(top);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return std::nullopt;
+            return item;
+        }
+    private:
+        Ring* Grow(Ring* ring, int64_t top, int64_t bottom)
+        {
+            m_Rings.push_back(std::make_unique<Ring>(ring->Capacity() * 2UL));
+            Ring* grown = m_Rings.back().get();
+            for (int64_t i = top; i < bottom; i++)
+                grown->Store(i, ring->Load(i));
+
+            m_Ring.store(grown, std::memory_order_release);
+            return grown;
+        }
+    };
+} // namespace Aesthetic
@@ -0,0 +1,164 @@
+#include <cstring>
+
+#include "interner.hpp"
+
+namespace Aesthetic
+{
+    static size_t SegmentOf(SymbolId id, size_t firstSegment)
+    {
+        return 63UL - __builtin_clzll(id / firstSegment + 1UL);
+    }
+
+    static size_t SegmentStart(size_t segment, size_t firstSegment)
+    {
+        return firstSegment * ((1UL << segment) - 1UL);
+    }
+
+    Interner::Interner()
+        : m_Next(0U)
+    {
+        for (Shard& shard : m_Shards)
+            shard.slots.assign(s_InitialSlots, Slot{ 0U, s_NoSymbol });
+        for (std::atomic<Entry*>& segment : m_Segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+    }
+
+    Interner::~Interner()
+    {
+        for (size_t i = 0UL; i < s_Segments; i++)
+            delete[] m_Segments[i].load(std::memory_order_relaxed);
+    }
+
+    Interner& Interner::Global()
+    {
+        static Interner interner;
+        return interner;
+    }
+
+    uint64_t Interner::Hash(std::string_view name)
+    {
+        // Word at a time multiply-xorshift, identifiers are mostly shorter
+        // than two words so the tail load matters as much as the loop
+        uint64_t hash = 0x9E3779B97F4A7C15ULL ^ name.size();
+        const char* data = name.data();
+        size_t left = name.size();
+
+        for (; left >= 8UL; left -= 8UL, data += 8UL)
+        {
+            uint64_t word;
+            std::memcpy(&word, data, 8UL);
+            hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+            hash ^= hash >> 31U;
+        }
+
+        if (left)
+        {
+            uint64_t word = 0ULL;
+            std::memcpy(&word, data, left);
+            hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+        }
+
+        hash ^= hash >> 27U;
+        hash *= 0x94D049BB133111EBULL;
+        return hash ^ (hash >> 31U);
+    }
+
+    SymbolId Interner::Intern(std::string_view name, uint64_t hash)
+    {
+        Shard& shard = ShardOf(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Slot* slot = &Probe(shard, name, static_cast<uint32_t>(hash));
+        if (slot->id != s_NoSymbol)
+            return slot->id;
+
+        // Keep the load at most one half so probe chains stay short
+        if ((shard.used + 1UL) * 2UL > shard.slots.size())
+        {
+            Grow(shard);
+            slot = &Probe(shard, name, static_cast<uint32_t>(hash));
+        }
+
+        char* copy = static_cast<char*>(shard.names.Allocate(name.size() ? name.size() : 1UL, 1UL));
+        std::memcpy(copy, name.data(), name.size());
+
+        const SymbolId id = m_Next.fetch_add(1U, std::memory_order_relaxed);
+        Publish(id, Entry{ copy, static_cast<uint32_t>(name.size()) });
+
+        *slot = Slot{ static_cast<uint32_t>(hash), id };
+        shard.used++;
+        return id;
+    }
+
+    std::optional<SymbolId> Interner::Find(std::string_view name)
+    {
+        const uint64_t hash = Hash(name);
+        Shard& shard = ShardOf(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        const Slot& slot = Probe(shard, name, static_cast<uint32_t>(hash));
+        if (slot.id == s_NoSymbol)
+            return std::nullopt;
+        return slot.id;
+    }
+
+    std::string_view Interner::Name(SymbolId id) const
+    {
+        const Entry& entry = EntryOf(id);
+        return std::string_view(entry.name, entry.length);
+    }
+
+    Interner::Slot& Interner::Probe(Shard& shard, std::string_view name, uint32_t hash) const
+    {
+        const size_t mask = shard.slots.size() - 1UL;
+
+        for (size_t i = hash & mask;; i = (i + 1UL) & mask)
+        {
+            Slot& slot = shard.slots[i];
+            if (slot.id == s_NoSymbol)
+                return slot;
+            if (slot.hash == hash && Name(slot.id) == name)
+                return slot;
+        }
+    }
+
+    void Interner::Grow(Shard& shard)
+    {
+        std::vector<Slot> slots(shard.slots.size() * 2UL, Slot{ 0U, s_NoSymbol });
+        const size_t mask = slots.size() - 1UL;
+
+        for (const Slot& slot : shard.slots)
+        {
+            if (slot.id == s_NoSymbol)
+                continue;
+
+            size_t i = slot.hash & mask;
+            while (slots[i].id != s_NoSymbol)
+                i = (i + 1UL) & mask;
+            slots[i] = slot;
+        }
+
+        shard.slots.swap(slots);
+    }
+
+    Interner::Entry& Interner::EntryOf(SymbolId id) const
+    {
+        const size_t segment = SegmentOf(id, s_FirstSegment);
+        Entry* entries = m_Segments[segment].load(std::memory_order_acquire);
+        return entries[id - SegmentStart(segment, s_FirstSegment)];
+    }
+
+    void Interner::Publish(SymbolId id, const Entry& entry)
+    {
+        const size_t segment = SegmentOf(id, s_FirstSegment);
+
+        if (!m_Segments[segment].load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_SegmentMutex);
+            if (!m_Segments[segment].load(std::memory_order_relaxed))
+                m_Segments[segment].store(new Entry[s_FirstSegment << segment], std::memory_order_release);
+        }
+
+        EntryOf(id) = entry;
+    }
+} // namespace Aesthetic
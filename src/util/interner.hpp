@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "memory/arena.hpp"
+
+namespace Aesthetic
+{
+    using SymbolId = uint32_t;
+
+    // Maps identifier names to dense 32-bit IDs, handed out from zero as new
+    // names come in, so later passes can compare and index by integer. With
+    // several lexer threads the order of the IDs is not deterministic. Names
+    // are copied into arenas owned by the interner.
+    //
+    // The table is split into shards by hash, each an open-addressing table
+    // of precomputed hashes behind its own mutex. Names of known IDs are read
+    // without locking. All members may be called from several threads.
+    class Interner
+    {
+    public:
+        static constexpr SymbolId s_NoSymbol = UINT32_MAX;
+    private:
+        static constexpr size_t s_ShardBits = 4UL;
+        static constexpr size_t s_Shards = 1UL << s_ShardBits;
+        static constexpr size_t s_InitialSlots = 64UL;
+        // Segment k of the name table holds s_FirstSegment << k entries
+        static constexpr size_t s_FirstSegment = 1024UL;
+        static constexpr size_t s_Segments = 23UL;
+
+        struct Slot
+        {
+            uint32_t hash;
+            SymbolId id;
+        };
+
+        struct Entry
+        {
+            const char* name;
+            uint32_t length;
+        };
+
+        struct Shard
+        {
+            std::mutex mutex;
+            Arena names;
+            std::vector<Slot> slots;
+            size_t used = 0UL;
+        };
+
+        std::array<Shard, s_Shards> m_Shards;
+        // Segments never move once allocated, that is what makes Name() lock free
+        std::array<std::atomic<Entry*>, s_Segments> m_Segments;
+        std::mutex m_SegmentMutex;
+        std::atomic<SymbolId> m_Next;
+    public:
+        Interner();
+        ~Interner();
+
+        Interner(const Interner&) = delete;
+        Interner& operator=(const Interner&) = delete;
+
+        // Instance the lexer interns symbols into
+        static Interner& Global();
+
+        static uint64_t Hash(std::string_view name);
+
+        SymbolId Intern(std::string_view name) { return Intern(name, Hash(name)); }
+        // `hash` has to be Hash(name)
+        SymbolId Intern(std::string_view name, uint64_t hash);
+        // ID of an already interned name, without adding it
+        std::optional<SymbolId> Find(std::string_view name);
+        // Name of an ID returned by this interner
+        std::string_view Name(SymbolId id) const;
+        // Number of IDs handed out so far
+        size_t Size() const { return m_Next.load(std::memory_order_relaxed); }
+    private:
+        Shard& ShardOf(uint64_t hash) { return m_Shards[hash >> (64UL - s_ShardBits)]; }
+        // Slot holding `name` or the empty slot it would go to
+        Slot& Probe(Shard& shard, std::string_view name, uint32_t hash) const;
+        void Grow(Shard& shard);
+        Entry& EntryOf(SymbolId id) const;
+        void Publish(SymbolId id, const Entry& entry);
+    };
+} // namespace Aesthetic
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace Aesthetic
+{
+    // Unbounded lock-free queue with many producers and a single consumer,
+    // after Dmitry Vyukov's intrusive MPSC node queue. Push() is one atomic
+    // exchange and never waits. A Pop() running while a push is half done
+    // may not see that item, nor the ones after it, until the push completes.
+    template<typename T>
+    class MpscQueue
+    {
+        static_assert(std::is_default_constructible_v<T>, "the stub node holds a default item");
+    private:
+        struct Node
+        {
+            std::atomic<Node*> next{ nullptr };
+            T item{};
+        };
+
+        // Producers swap themselves in at the head, the consumer follows the tail
+        alignas(64) std::atomic<Node*> m_Head;
+        alignas(64) Node* m_Tail;
+        Node m_Stub;
+    public:
+        MpscQueue() : m_Head(&m_Stub), m_Tail(&m_Stub) {}
+
+        ~MpscQueue()
+        {
+            while (Pop())
+                ;
+            if (m_Tail != &m_Stub)
+                delete m_Tail;
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread
+        void Push(T item)
+        {
+            Node* node = new Node;
+            node->item = std::move(item);
+
+            Node* previous = m_Head.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        // Consumer only
+        std::optional<T> Pop()
+        {
+            Node* tail = m_Tail;
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (!next)
+                return std::nullopt;
+
+            // `next` becomes the new stub, its item is moved out
+            m_Tail = next;
+            if (tail != &m_Stub)
+                delete tail;
+            return std::move(next->item);
+        }
+    };
+} // namespace Aesthetic
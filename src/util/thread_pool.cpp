@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <utility>
+
+#include "thread_pool.hpp"
+
+namespace Aesthetic
+{
+    ThreadPool::ThreadPool(size_t threads)
+        : m_Stopping(false)
+    {
+        if (!threads)
+            threads = std::max(1U, std::thread::hardware_concurrency());
+
+        m_Workers.reserve(threads);
+        for (size_t i = 0; i < threads; i++)
+            m_Workers.emplace_back(&ThreadPool::Work, this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_Wake.notify_all();
+
+        for (std::thread& worker: m_Workers)
+            worker.join();
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Tasks.push_back(std::move(task));
+        }
+        m_Wake.notify_one();
+    }
+
+    void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body)
+    {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t left = count;
+
+        for (size_t i = 0; i < count; i++)
+            Submit([&, i]() {
+                body(i);
+
+                std::lock_guard lock(mutex);
+                if (!--left)
+                    done.notify_one();
+            });
+
+        std::unique_lock lock(mutex);
+        done.wait(lock, [&left]() { return !left; });
+    }
+
+    void ThreadPool::Work()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Wake.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+
+                if (m_Tasks.empty())
+                    return;
+
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            task();
+        }
+    }
+} // namespace Aesthetic
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Aesthetic
+{
+    // Fixed set of worker threads pulling tasks from a shared queue
+    class ThreadPool
+    {
+    private:
+        std::vector<std::thread> m_Workers;
+        std::deque<std::function<void()>> m_Tasks;
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        bool m_Stopping;
+    public:
+        // Zero threads means one per hardware thread
+        explicit ThreadPool(size_t threads = 0UL);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t Size() const { return m_Workers.size(); }
+
+        void Submit(std::function<void()> task);
+        // Runs `body(i)` for every i in [0, count) and waits for all of them.
+        // Must not be called from inside a task of the same pool.
+        void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+    private:
+        void Work();
+    };
+} // namespace Aesthetic
@@ -0,0 +1,138 @@
+#include <algorithm>
+
+#include "work_stealing_pool.hpp"
+
+namespace Aesthetic
+{
+    WorkStealingPool::WorkStealingPool(size_t threads)
+        : m_Body(nullptr), m_Grain(1U), m_Remaining(0UL), m_Job(0U), m_Stopping(false)
+    {
+        if (!threads)
+            threads = std::max(1U, std::thread::hardware_concurrency());
+
+        for (size_t i = 0UL; i < threads; i++)
+        {
+            m_Workers.push_back(std::make_unique<Worker>());
+            m_Workers.back()->random = 0x9E3779B97F4A7C15ULL * (i + 1UL);
+        }
+
+        m_Threads.reserve(threads - 1UL);
+        for (size_t i = 1UL; i < threads; i++)
+            m_Threads.emplace_back(&WorkStealingPool::Work, this, i);
+    }
+
+    WorkStealingPool::~WorkStealingPool()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_Wake.notify_all();
+
+        for (std::thread& thread : m_Threads)
+            thread.join();
+    }
+
+    void WorkStealingPool::ParallelFor(size_t count, const std::function<void(size_t, size_t)>& body)
+    {
+        if (!count)
+            return;
+
+        if (m_Workers.size() == 1UL || count == 1UL)
+        {
+            for (size_t task = 0UL; task < count; task++)
+                body(task, 0UL);
+            return;
+        }
+
+        // Enough pieces for every worker to steal a few times over
+        const size_t grain = std::max(1UL, count / (m_Workers.size() * s_PiecesPerWorker));
+        m_Grain.store(static_cast<uint32_t>(grain), std::memory_order_relaxed);
+        m_Body.store(&body, std::memory_order_relaxed);
+        m_Remaining.store(count, std::memory_order_relaxed);
+        m_Workers.front()->ranges.Push(Range{ 0U, static_cast<uint32_t>(count) });
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Job++;
+        }
+        m_Wake.notify_all();
+
+        Help(0UL);
+    }
+
+    void WorkStealingPool::Work(size_t worker)
+    {
+        uint64_t seen = 0U;
+        while (true)
+        {
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Wake.wait(lock, [this, seen]() { return m_Stopping || m_Job != seen; });
+
+                if (m_Stopping)
+                    return;
+                seen = m_Job;
+            }
+            Help(worker);
+        }
+    }
+
+    void WorkStealingPool::Help(size_t worker)
+    {
+        Range range;
+        while (m_Remaining.load(std::memory_order_acquire))
+        {
+            if (!Take(worker, range))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Keep the lower half and offer the rest, until the range is
+            // small enough to run in one go
+            const uint32_t grain = m_Grain.load(std::memory_order_relaxed);
+            while (range.end - range.begin > grain)
+            {
+                const uint32_t middle = range.begin + (range.end - range.begin) / 2U;
+                m_Workers[worker]->ranges.Push(Range{ middle, range.end });
+                range.end = middle;
+            }
+
+            const std::function<void(size_t, size_t)>& body = *m_Body.load(std::memory_order_relaxed);
+            for (uint32_t task = range.begin; task < range.end; task++)
+                body(task, worker);
+            m_Remaining.fetch_sub(range.end - range.begin, std::memory_order_acq_rel);
+        }
+    }
+
+    bool WorkStealingPool::Take(size_t worker, Range& range)
+    {
+        Worker& self = *m_Workers[worker];
+        if (const std::optional<Range> own = self.ranges.Pop())
+        {
+            range = own.value();
+            return true;
+        }
+
+        // xorshift picks where to start, so thieves spread over the victims
+        self.random ^= self.random << 13U;
+        self.random ^= self.random >> 7U;
+        self.random ^= self.random << 17U;
+
+        const size_t start = self.random % m_Workers.size();
+        for (size_t i = 0UL; i < m_Workers.size(); i++)
+        {
+            const size_t victim = (start + i) % m_Workers.size();
+            if (victim == worker)
+                continue;
+
+            if (const std::optional<Range> stolen = m_Workers[victim]->ranges.Steal())
+            {
+                range = stolen.value();
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace Aesthetic
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chase_lev_deque.hpp"
+
+namespace Aesthetic
+{
+    // Fork-join pool for many small tasks. Every worker owns a Chase-Lev
+    // deque of index ranges. A range is split in halves as it is taken, the
+    // owner keeps working on the lower half and leaves the upper one for
+    // thieves, so idle workers steal large pieces and the owner works
+    // through its own in order. Splitting stops at a grain of a few pieces
+    // per worker, the tasks of a piece run back to back. The thread calling
+    // ParallelFor() is worker 0 and takes part in the work.
+    class WorkStealingPool
+    {
+    public:
+        static constexpr size_t s_PiecesPerWorker = 8UL;
+    private:
+        struct Range
+        {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        struct alignas(64) Worker
+        {
+            ChaseLevDeque<Range> ranges;
+            uint64_t random;
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::vector<std::thread> m_Threads;
+        std::atomic<const std::function<void(size_t, size_t)>*> m_Body;
+        // Ranges up to this many tasks are not split any further
+        std::atomic<uint32_t> m_Grain;
+        // Tasks of the running job that have not finished yet
+        std::atomic<size_t> m_Remaining;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        // Bumped by every job, sleeping workers wait for it to change
+        uint64_t m_Job;
+        bool m_Stopping;
+    public:
+        // Counts the calling thread, zero means one per hardware thread
+        explicit WorkStealingPool(size_t threads = 0UL);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        size_t Size() const { return m_Workers.size(); }
+
+        // Runs `body(task, worker)` for every task in [0, count) and waits
+        // for all of them. `worker` is below Size(), and no two tasks run on
+        // the same worker at once. Must not be called from inside a task.
+        void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& body);
+    private:
+        void Work(size_t worker);
+        // Runs tasks until the job is over
+        void Help(size_t worker);
+        bool Take(size_t worker, Range& range);
+    };
+} // namespace Aesthetic
@@ -0,0 +1,178 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test.hpp"
+#include "corpus.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/incremental_lexer.hpp"
+#include "lexer/lexer.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    // Text an edit may insert: tokens, halves of tokens and what joins or
+    // splits them
+    constexpr std::string_view s_Fragments[] = {
+        "x", "when", "whenever", "on", " ", "!", "~", "\n", "\t", "1", "0x", ".5", "1.", "::=", ":", "=", "~>", "//", "/",
+        "\"", "'", "\"str\"", "\\", "{", "}", "(", ")", "#", "\xC3\xA9", "\xF0\x9F\x98\x80", "\xE2\x82",
+        // Lead and continuation bytes alone, completing or breaking up the
+        // sequence a name runs into
+        "\xC3", "\xA9", "\xF0\x9F", "\x98\x80", "\x82\xAC", "abc",
+        "x ::= y + 1\n", "when #start {\n", "}\n",
+    };
+
+    struct Lexed
+    {
+        TokenKind kind;
+        uint8_t subtype;
+        bool valid;
+        uint32_t offset;
+        uint32_t length;
+        uint64_t payload;
+
+        bool operator==(const Lexed&) const = default;
+    };
+
+    std::vector<Lexed> Collect(const TokenStream& tokens)
+    {
+        std::vector<Lexed> result;
+        for (size_t i = 0UL; i < tokens.Size(); i++)
+            result.push_back(Lexed{ tokens.Kind(i), tokens.Subtype(i), tokens.Valid(i), tokens.Offset(i), tokens.Length(i), tokens.Payload(i) });
+        return result;
+    }
+
+    TextEdit RandomEdit(std::mt19937_64& random, std::string_view text, size_t& cursor, std::string& inserted)
+    {
+        const size_t size = text.size();
+        // Mostly next to the last edit, as typing is, sometimes anywhere
+        if (random() % 8UL == 0UL)
+            cursor = random() % (size + 1UL);
+        else
+            cursor = std::min(size, cursor + random() % 9UL - std::min<size_t>(cursor, 4UL));
+
+        // Overwriting single bytes with lead bytes, and the bytes after
+        // lead bytes with continuation bytes, completes or breaks up UTF-8
+        // sequences right behind names
+        inserted.clear();
+        if (random() % 4UL == 0UL && cursor < size)
+        {
+            const size_t lead = text.find_first_of("\xC3\xE2\xF0", cursor);
+            if (random() % 2UL)
+                inserted += "\xC3\xE2\xF0"[random() % 3UL];
+            else if (lead != std::string_view::npos && lead + 1UL < size && lead - cursor < 64UL)
+            {
+                cursor = lead + 1UL;
+                inserted += static_cast<char>(0x80U + random() % 0x40U);
+            }
+            else
+                inserted += static_cast<char>(0x80U + random() % 0x40U);
+            return TextEdit{ cursor, 1UL, inserted };
+        }
+        for (size_t parts = random() % 3UL; parts; parts--)
+            inserted += s_Fragments[random() % std::size(s_Fragments)];
+
+        const size_t removed = random() % 3UL == 0UL ? 0UL : std::min<size_t>(size - cursor, random() % 12UL);
+        return TextEdit{ cursor, removed, inserted };
+    }
+} // namespace
+
+AE_TEST(IncrementalLexerMatchesFullRelex)
+{
+    std::mt19937_64 random(23U);
+    for (const CorpusProfile profile : { CorpusProfile::MIXED, CorpusProfile::LITERALS, CorpusProfile::NESTED, CorpusProfile::SCRIPTS })
+    {
+        std::string text = GenerateCorpus(4UL << 10U, profile, random());
+        IncrementalLexer lexer(text);
+        size_t cursor = 0UL;
+        std::string inserted;
+
+        for (size_t round = 0UL; round < 1500UL; round++)
+        {
+            const TextEdit edit = RandomEdit(random, text, cursor, inserted);
+            text.replace(edit.offset, edit.removed, edit.inserted);
+            lexer.Apply(edit);
+
+            // Reading the tokens only every few edits lets the gaps drift
+            if (round % 5UL)
+                continue;
+
+            if (!AE_CHECK(lexer.Text() == text))
+                return;
+
+            const SourceBuffer source = SourceBuffer::Borrow(text, "<test>");
+            const std::vector<Lexed> after = Collect(lexer.Tokens());
+            const TokenStream full = Lexer(source).Lex();
+            if (!AE_CHECK(after == Collect(full)))
+                return;
+
+            // Positions come from the edited text too
+            const TokenStream& tokens = lexer.Tokens();
+            const size_t probe = random() % tokens.Size();
+            if (!AE_CHECK(tokens.Pos(probe).line == full.Pos(probe).line && tokens.Pos(probe).col == full.Pos(probe).col))
+                return;
+        }
+    }
+}
+
+AE_TEST(IncrementalLexerReportsTheChangedTokens)
+{
+    std::mt19937_64 random(29U);
+    std::string text = GenerateCorpus(4UL << 10U, CorpusProfile::MIXED, 1U);
+    IncrementalLexer lexer(text);
+    std::vector<Lexed> before = Collect(lexer.Tokens());
+    size_t cursor = 0UL;
+    std::string inserted;
+
+    for (size_t round = 0UL; round < 1000UL; round++)
+    {
+        const TextEdit edit = RandomEdit(random, text, cursor, inserted);
+        text.replace(edit.offset, edit.removed, edit.inserted);
+        const TokenChange change = lexer.Apply(edit);
+        const std::vector<Lexed> after = Collect(lexer.Tokens());
+
+        // In front of the change nothing moved, behind it tokens only moved
+        const int64_t delta = static_cast<int64_t>(edit.inserted.size()) - static_cast<int64_t>(edit.removed);
+        if (!AE_CHECK(after.size() - change.inserted == before.size() - change.removed))
+            return;
+        for (size_t i = 0UL; i < change.first; i++)
+            if (!AE_CHECK(after[i] == before[i]))
+                return;
+        for (size_t i = change.first + change.removed; i < before.size(); i++)
+        {
+            Lexed moved = before[i];
+            moved.offset = static_cast<uint32_t>(moved.offset + delta);
+            if (!AE_CHECK(after[i - change.removed + change.inserted] == moved))
+                return;
+        }
+        before = after;
+    }
+}
+
+AE_TEST(IncrementalLexerEditsAtEveryOffset)
+{
+    // Short texts whose tokens reach past their ends, every fragment
+    // inserted and every short range removed at every offset
+    for (const std::string_view text : { "a :: b : c\n", "x = / 1. 2 ~ !", "when\"s\" 0x 1e", "\xC3\xA9t\xC3\xA9 on\xE2\x82 #a", "abc\xC3X", "whenever\xC3X", "x\xF0\x9F\x98X y" })
+    {
+        for (size_t offset = 0UL; offset <= text.size(); offset++)
+        {
+            for (size_t removed = 0UL; removed <= std::min<size_t>(3UL, text.size() - offset); removed++)
+            {
+                for (const std::string_view inserted : s_Fragments)
+                {
+                    IncrementalLexer lexer{ std::string(text) };
+                    lexer.Apply(TextEdit{ offset, removed, inserted });
+
+                    std::string edited(text);
+                    edited.replace(offset, removed, inserted);
+                    const SourceBuffer source = SourceBuffer::Borrow(edited, "<test>");
+                    if (!AE_CHECK(Collect(lexer.Tokens()) == Collect(Lexer(source).Lex())))
+                        return;
+                }
+            }
+        }
+    }
+}
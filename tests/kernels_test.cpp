@@ -0,0 +1,148 @@
+#include <array>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test.hpp"
+#include "lexer/kernels.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    struct NamedKernel
+    {
+        std::string_view name;
+        ScanKernels::Kernel kernel;
+    };
+
+    std::vector<NamedKernel> Kernels(const ScanKernels& kernels)
+    {
+        return {
+            { "blanks", kernels.blanks },
+            { "symbolic", kernels.symbolic },
+            { "hex digits", kernels.digits[static_cast<size_t>(NumberLiteralType::HEX)] },
+            { "oct digits", kernels.digits[static_cast<size_t>(NumberLiteralType::OCT)] },
+            { "bin digits", kernels.digits[static_cast<size_t>(NumberLiteralType::BIN)] },
+            { "dec digits", kernels.digits[static_cast<size_t>(NumberLiteralType::DEC)] },
+            { "string body", kernels.stringBody },
+            { "ascii", kernels.ascii },
+            { "code points", kernels.codePoints },
+        };
+    }
+
+    // Random bytes, mostly of the ones `inside` accepts so spans run long
+    // enough to cross whole vectors
+    std::string Fill(std::mt19937_64& random, size_t size, ScanKernels::Kernel inside)
+    {
+        std::string members;
+        for (size_t byte = 0UL; byte < 256UL; byte++)
+        {
+            const char sym = static_cast<char>(byte);
+            if (inside(std::string_view(&sym, 1UL)))
+                members += sym;
+        }
+
+        std::string text(size, '\0');
+        for (char& sym : text)
+            sym = members.empty() || random() % 64UL == 0UL ? static_cast<char>(random()) : members[random() % members.size()];
+        return text;
+    }
+
+    // Every alignment of a 64-byte line and every length up to four AVX2
+    // vectors and a tail
+    constexpr size_t s_Alignments = 64UL;
+    constexpr size_t s_MaxLength = 4UL * 32UL + 31UL;
+} // namespace
+
+AE_TEST(KernelsMatchScalarAtEveryAlignment)
+{
+    const ScanKernels& scalar = ScanKernels::Get(KernelSet::SCALAR);
+    const std::vector<NamedKernel> expected = Kernels(scalar);
+    std::mt19937_64 random(11U);
+
+    alignas(64) static std::array<char, s_Alignments + s_MaxLength> buffer;
+
+    for (const KernelSet set : { KernelSet::SSE2, KernelSet::AVX2 })
+    {
+        if (!ScanKernels::Supported(set))
+            continue;
+
+        const std::vector<NamedKernel> kernels = Kernels(ScanKernels::Get(set));
+        for (size_t k = 0UL; k < kernels.size(); k++)
+        {
+            for (size_t round = 0UL; round < 16UL; round++)
+            {
+                const std::string text = Fill(random, buffer.size(), expected[k].kernel);
+                std::copy(text.begin(), text.end(), buffer.begin());
+
+                for (size_t alignment = 0UL; alignment < s_Alignments; alignment++)
+                    for (size_t length = 0UL; length <= s_MaxLength; length++)
+                    {
+                        const std::string_view view(buffer.data() + alignment, length);
+                        if (!AE_CHECK(kernels[k].kernel(view) == expected[k].kernel(view)))
+                            return;
+                    }
+            }
+        }
+    }
+}
+
+AE_TEST(LineStartsMatchScalarAtEveryAlignment)
+{
+    const ScanKernels& scalar = ScanKernels::Get(KernelSet::SCALAR);
+    std::mt19937_64 random(13U);
+
+    alignas(64) static std::array<char, s_Alignments + s_MaxLength> buffer;
+    std::pmr::vector<uint32_t> expected;
+    std::pmr::vector<uint32_t> found;
+
+    for (const KernelSet set : { KernelSet::SSE2, KernelSet::AVX2 })
+    {
+        if (!ScanKernels::Supported(set))
+            continue;
+
+        const ScanKernels& kernels = ScanKernels::Get(set);
+        for (size_t round = 0UL; round < 16UL; round++)
+        {
+            // Newlines from none to every other byte
+            for (char& sym : buffer)
+                sym = random() % (1UL + round * 4UL) == 0UL ? '\n' : static_cast<char>(random());
+
+            for (size_t alignment = 0UL; alignment < s_Alignments; alignment++)
+                for (size_t length = 0UL; length <= s_MaxLength; length++)
+                {
+                    const std::string_view view(buffer.data() + alignment, length);
+                    expected.clear();
+                    found.clear();
+                    scalar.lineStarts(view, 7U, expected);
+                    kernels.lineStarts(view, 7U, found);
+                    if (!AE_CHECK(found == expected))
+                        return;
+                }
+        }
+    }
+}
+
+AE_TEST(KernelsMatchScalarOnLongBuffers)
+{
+    const std::vector<NamedKernel> expected = Kernels(ScanKernels::Get(KernelSet::SCALAR));
+    std::mt19937_64 random(17U);
+
+    for (const KernelSet set : { KernelSet::SSE2, KernelSet::AVX2 })
+    {
+        if (!ScanKernels::Supported(set))
+            continue;
+
+        const std::vector<NamedKernel> kernels = Kernels(ScanKernels::Get(set));
+        for (size_t k = 0UL; k < kernels.size(); k++)
+            for (size_t round = 0UL; round < 64UL; round++)
+            {
+                const std::string text = Fill(random, 1UL + random() % 8192UL, expected[k].kernel);
+                if (!AE_CHECK(kernels[k].kernel(text) == expected[k].kernel(text)))
+                    return;
+            }
+    }
+}
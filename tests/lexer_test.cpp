@@ -0,0 +1,119 @@
+#include <sstream>
+#include <string>
+
+#include "test.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/dfa_scanner.hpp"
+#include "lexer/incremental_lexer.hpp"
+#include "lexer/lexer.hpp"
+#include "lexer/parallel_lexer.hpp"
+#include "lexer/scanner.hpp"
+#include "lexer/stream_lexer.hpp"
+#include "util/interner.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    // `names` bindings of names no other test uses, and as many strings
+    // that span lines and hold more such names, which are no symbols
+    std::string NamesProgram(std::string_view prefix, size_t names)
+    {
+        std::string program;
+        for (size_t i = 0UL; i < names; i++)
+        {
+            const std::string name = std::string(prefix) + std::to_string(i);
+            program += name + " ::= " + name + " + 1\n";
+            program += "s ::= \"\n" + std::string(prefix) + "in_string" + std::to_string(i) + "\n\"\n";
+        }
+        return program;
+    }
+} // namespace
+
+AE_TEST(ScanningInternsNothing)
+{
+    const std::string program = NamesProgram("scanned_", 200UL);
+    const size_t before = Interner::Global().Size();
+
+    for (size_t offset = 0UL; offset <= program.size(); offset++)
+        ScanLexeme(std::string_view(program).substr(offset));
+
+    AE_CHECK(Interner::Global().Size() == before);
+}
+
+AE_TEST(LexersInternOnlyCommittedSymbols)
+{
+    Interner& interner = Interner::Global();
+
+    // Every lexer on a program of its own, the names of the bindings and `s`
+    const auto lexes = [&interner](std::string_view prefix, auto&& lex)
+    {
+        const std::string program = NamesProgram(prefix, 300UL);
+        const size_t before = interner.Size();
+        lex(program);
+        return AE_CHECK(interner.Size() - before <= 301UL)
+            && AE_CHECK(!interner.Find(std::string(prefix) + "in_string0"));
+    };
+
+    lexes("serial_", [](const std::string& program)
+    {
+        Lexer(SourceBuffer::Borrow(program, "<test>")).Lex();
+    });
+
+    lexes("stream_", [](const std::string& program)
+    {
+        std::istringstream input(program);
+        StreamLexer lexer(input, 1UL);
+        while (lexer.Next());
+    });
+
+    // Chunks start inside the strings and lex their contents speculatively
+    lexes("parallel_", [](const std::string& program)
+    {
+        ThreadPool pool(4UL);
+        const SourceBuffer source = SourceBuffer::Borrow(program, "<test>");
+        const TokenStream tokens = ParallelLexer(source, pool, std::pmr::get_default_resource(), 16UL).Lex();
+        for (size_t i = 0UL; i < tokens.Size(); i++)
+            if (tokens.Kind(i) == TokenKind::SYMBOL && !AE_CHECK(Interner::Global().Name(tokens[i].Symbol()) == tokens.Text(i)))
+                return;
+    });
+
+    // Edits relex the tokens around them, strings included
+    lexes("incremental_", [](const std::string& program)
+    {
+        IncrementalLexer lexer(program);
+        const size_t quote = program.find('"');
+        lexer.Apply(TextEdit{ quote, 0UL, " " });
+        lexer.Apply(TextEdit{ quote, 1UL, "" });
+    });
+}
+
+AE_TEST(DfaScanningInternsNothing)
+{
+    // Names running into a byte from 0x80 on are handed to ScanLexeme()
+    const std::string program = NamesProgram("dfa_scanned_", 200UL) + NamesProgram("dfa_scanned_\xC3\xA9", 200UL);
+    const size_t before = Interner::Global().Size();
+
+    for (size_t offset = 0UL; offset <= program.size(); offset++)
+        ScanLexemeDfa(std::string_view(program).substr(offset));
+
+    AE_CHECK(Interner::Global().Size() == before);
+}
+
+AE_TEST(DfaLexerInternsLikeTheLexer)
+{
+    const std::string program = NamesProgram("dfa_lexed_", 300UL) + NamesProgram("dfa_lexed_\xC3\xA9", 300UL);
+    const SourceBuffer source = SourceBuffer::Borrow(program, "<test>");
+    const size_t before = Interner::Global().Size();
+
+    const TokenStream walked = DfaLexer(source, std::pmr::get_default_resource()).Lex();
+    if (!AE_CHECK(Interner::Global().Size() - before <= 601UL))
+        return;
+
+    const TokenStream lexed = Lexer(source).Lex();
+    if (!AE_CHECK(Interner::Global().Size() - before <= 601UL) || !AE_CHECK(walked.Size() == lexed.Size()))
+        return;
+    for (size_t i = 0UL; i < lexed.Size(); i++)
+        if (!AE_CHECK(walked.Kind(i) == lexed.Kind(i) && walked.Payload(i) == lexed.Payload(i)))
+            return;
+}
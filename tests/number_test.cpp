@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+#include "test.hpp"
+#include "lexer/dfa_scanner.hpp"
+#include "lexer/scanner.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    struct Literal
+    {
+        std::string_view text;
+        TokenKind kind;
+        bool valid;
+        uint32_t length;
+        uint64_t payload;
+    };
+
+    uint64_t Bits(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // Both scanners decode `literal` at the front of its text as expected
+    void CheckLiterals(std::initializer_list<Literal> literals)
+    {
+        for (const Literal& literal : literals)
+        {
+            for (const Lexeme lexeme : { ScanLexeme(literal.text), ScanLexemeDfa(literal.text) })
+            {
+                const bool same = lexeme.kind == literal.kind && lexeme.valid == literal.valid
+                    && lexeme.length == literal.length && lexeme.payload == literal.payload;
+                if (!same)
+                    std::fprintf(stderr, "`%.*s`: kind %u, valid %d, length %u, payload %llu\n",
+                        static_cast<int>(literal.text.size()), literal.text.data(), static_cast<unsigned>(lexeme.kind),
+                        lexeme.valid, lexeme.length, static_cast<unsigned long long>(lexeme.payload));
+                if (!AE_CHECK(same))
+                    return;
+            }
+        }
+    }
+} // namespace
+
+AE_TEST(IntegersOverflowPastUint64)
+{
+    CheckLiterals({
+        { "18446744073709551615", TokenKind::INTEGER, true, 20U, UINT64_MAX },
+        { "18446744073709551616", TokenKind::INTEGER, false, 20U, 0U },
+        { "0xFFFFFFFFFFFFFFFF", TokenKind::INTEGER, true, 18U, UINT64_MAX },
+        { "0x10000000000000000", TokenKind::INTEGER, false, 19U, 0U },
+        { "0x00000000000000000001", TokenKind::INTEGER, true, 22U, 1U },
+        { "0o1777777777777777777777", TokenKind::INTEGER, true, 24U, UINT64_MAX },
+        { "0o2000000000000000000000", TokenKind::INTEGER, false, 24U, 0U },
+        { "0b1111111111111111111111111111111111111111111111111111111111111111", TokenKind::INTEGER, true, 66U, UINT64_MAX },
+        { "0b10000000000000000000000000000000000000000000000000000000000000000", TokenKind::INTEGER, false, 67U, 0U },
+    });
+
+    AE_CHECK(NumberToken::DecodeInteger("ffffffffffffffff", NumberLiteralType::HEX) == UINT64_MAX);
+    AE_CHECK(!NumberToken::DecodeInteger("1ffffffffffffffff", NumberLiteralType::HEX));
+    AE_CHECK(!NumberToken::DecodeInteger("99999999999999999999", NumberLiteralType::DEC));
+}
+
+AE_TEST(PowerOfTwoFloatsAreExact)
+{
+    CheckLiterals({
+        { "0x1.8", TokenKind::FLOATING_POINT, true, 5U, Bits(1.5) },
+        { "0xA.c", TokenKind::FLOATING_POINT, true, 5U, Bits(10.75) },
+        { "0x.8", TokenKind::FLOATING_POINT, true, 4U, Bits(0.5) },
+        { "0x1.", TokenKind::FLOATING_POINT, true, 4U, Bits(1.0) },
+        { "0xff.0001", TokenKind::FLOATING_POINT, true, 9U, Bits(255.0 + 1.0 / 65536.0) },
+        { "0o0.4", TokenKind::FLOATING_POINT, true, 5U, Bits(0.5) },
+        { "0b0.01", TokenKind::FLOATING_POINT, true, 6U, Bits(0.25) },
+        // Digits past 64 bits only raise the exponent
+        { "0x10000000000000000.0", TokenKind::FLOATING_POINT, true, 21U, Bits(18446744073709551616.0) },
+        { "0x1.00000000000000001", TokenKind::FLOATING_POINT, true, 21U, Bits(1.0) },
+    });
+
+    AE_CHECK(NumberToken::DecodeFloatingPoint("1.8", 1UL, NumberLiteralType::HEX) == 1.5);
+    AE_CHECK(!NumberToken::DecodeFloatingPoint(std::string(300UL, 'f') + ".0", 300UL, NumberLiteralType::HEX));
+}
+
+AE_TEST(OctalLiteralsStopBeforeEight)
+{
+    AE_CHECK(!NumberToken::IsDigit('8', NumberLiteralType::OCT));
+    AE_CHECK(!NumberToken::IsDigit('9', NumberLiteralType::OCT));
+    AE_CHECK(NumberToken::IsDigit('7', NumberLiteralType::OCT));
+
+    CheckLiterals({
+        { "0o8", TokenKind::INTEGER, false, 3U, 0U },
+        { "0o78", TokenKind::INTEGER, true, 3U, 7U },
+        { "0o17.48", TokenKind::FLOATING_POINT, true, 6U, Bits(15.5) },
+        { "0b12", TokenKind::INTEGER, true, 3U, 1U },
+    });
+}
+
+AE_TEST(PrefixesWithoutDigitsAreInvalid)
+{
+    // The prefix takes one more byte, whatever it is
+    CheckLiterals({
+        { "0x", TokenKind::INTEGER, false, 2U, 0U },
+        { "0o", TokenKind::INTEGER, false, 2U, 0U },
+        { "0b", TokenKind::INTEGER, false, 2U, 0U },
+        { "0xg", TokenKind::INTEGER, false, 3U, 0U },
+        { "0b2", TokenKind::INTEGER, false, 3U, 0U },
+        { "0x;", TokenKind::INTEGER, false, 3U, 0U },
+        { "0x.", TokenKind::FLOATING_POINT, false, 3U, 0U },
+        { "0b.;", TokenKind::FLOATING_POINT, false, 3U, 0U },
+    });
+
+    AE_CHECK(!NumberToken::DecodeFloatingPoint(".", 0UL, NumberLiteralType::HEX));
+}
@@ -0,0 +1,79 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/lexer.hpp"
+#include "parser/parser.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    struct Parsed
+    {
+        size_t statements;
+        std::vector<std::string_view> errors;
+    };
+
+    Parsed Parse(const std::string& program)
+    {
+        const TokenStream tokens = Lexer(SourceBuffer::Borrow(program, "<test>")).Lex();
+        Parser parser(tokens);
+        const Ast ast = parser.Parse();
+
+        Parsed parsed{ ast.Children(ast.Root()).size(), {} };
+        for (const ParseError& error : parser.Errors())
+            parsed.errors.push_back(error.message);
+        return parsed;
+    }
+
+    std::string Repeat(std::string_view text, size_t count)
+    {
+        std::string repeated;
+        repeated.reserve(text.size() * count);
+        for (size_t i = 0UL; i < count; i++)
+            repeated += text;
+        return repeated;
+    }
+} // namespace
+
+AE_TEST(StrayScopeCloseIsAnError)
+{
+    const Parsed after = Parse("x ::= 1\n}\ny ::= 2\n");
+    AE_CHECK(after.statements == 2UL);
+    AE_CHECK(after.errors == std::vector<std::string_view>{ "unexpected '}'" });
+
+    // The '{' is no expression, the statement skips up to the '}'
+    const Parsed block = Parse("{}");
+    AE_CHECK(block.errors == std::vector<std::string_view>({ "expected an expression", "unexpected '}'" }));
+
+    AE_CHECK(Parse("}}}").errors.size() == 3UL);
+    AE_CHECK(Parse("if x { y }\n}").errors == std::vector<std::string_view>{ "unexpected '}'" });
+}
+
+AE_TEST(DeepNestingIsAnError)
+{
+    constexpr size_t depth = 100000UL;
+    const std::vector<std::string_view> tooDeep{ "expression nested too deeply" };
+
+    AE_CHECK(Parse(Repeat("(", depth) + "1" + Repeat(")", depth)).errors == tooDeep);
+    AE_CHECK(Parse(Repeat("[", depth) + Repeat("]", depth)).errors == tooDeep);
+    AE_CHECK(Parse(Repeat("-", depth) + "1").errors == tooDeep);
+    AE_CHECK(Parse(Repeat("exist ", depth) + "x").errors == tooDeep);
+    AE_CHECK(Parse("x ::= " + Repeat("1 + (", depth) + "1" + Repeat(")", depth)).errors == tooDeep);
+    // The handler is skipped up to the end of its block, whether its
+    // condition or its block ran out of depth
+    const Parsed blocks = Parse(Repeat("if x {\n", depth) + Repeat("}\n", depth) + "y ::= 1\n");
+    AE_CHECK(blocks.statements == 2UL && blocks.errors.size() == 1UL);
+
+    // The statement after it parses again
+    const Parsed next = Parse(Repeat("(", depth) + "\ny ::= 1\n");
+    AE_CHECK(next.statements == 2UL && next.errors == tooDeep);
+
+    // Up to the limit, nesting is fine
+    const size_t fits = Parser::s_MaxDepth - 1UL;
+    AE_CHECK(Parse(Repeat("(", fits) + "1" + Repeat(")", fits)).errors.empty());
+    AE_CHECK(Parse(Repeat("if x {\n", fits / 2UL) + Repeat("}\n", fits / 2UL)).errors.empty());
+}
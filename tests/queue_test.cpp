@@ -0,0 +1,115 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+#include "util/chase_lev_deque.hpp"
+#include "util/mpsc_queue.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    // Every value below `count` was taken exactly once
+    bool TakenOnce(const std::vector<std::vector<uint32_t>>& taken, size_t count)
+    {
+        std::vector<uint32_t> times(count, 0U);
+        for (const std::vector<uint32_t>& items : taken)
+            for (const uint32_t item : items)
+            {
+                if (item >= count)
+                    return false;
+                times[item]++;
+            }
+
+        for (const uint32_t time : times)
+            if (time != 1U)
+                return false;
+        return true;
+    }
+} // namespace
+
+AE_TEST(DequeItemsAreTakenOnce)
+{
+    constexpr size_t s_Thieves = 3UL;
+    constexpr uint32_t s_Items = 20000U;
+
+    // A fresh deque every round, so the ring grows while thieves steal
+    for (size_t round = 0UL; round < 8UL; round++)
+    {
+        ChaseLevDeque<uint32_t> deque(2UL);
+        std::atomic<bool> done{ false };
+        std::vector<std::vector<uint32_t>> taken(s_Thieves + 1UL);
+
+        std::vector<std::thread> thieves;
+        for (size_t thief = 0UL; thief < s_Thieves; thief++)
+            thieves.emplace_back([&deque, &done, &stolen = taken[thief]]
+            {
+                while (!done.load(std::memory_order_acquire))
+                    if (const std::optional<uint32_t> item = deque.Steal())
+                        stolen.push_back(*item);
+            });
+
+        // Bursts of pushes, each followed by a few pops, down to empty at the end
+        std::vector<uint32_t>& popped = taken.back();
+        uint32_t pushed = 0U;
+        while (pushed < s_Items)
+        {
+            const uint32_t burst = 1U + (pushed * 7919U + static_cast<uint32_t>(round)) % 257U;
+            for (uint32_t i = 0U; i < burst && pushed < s_Items; i++)
+                deque.Push(pushed++);
+            for (uint32_t i = 0U; i < burst / 3U; i++)
+                if (const std::optional<uint32_t> item = deque.Pop())
+                    popped.push_back(*item);
+        }
+        while (const std::optional<uint32_t> item = deque.Pop())
+            popped.push_back(*item);
+
+        done.store(true, std::memory_order_release);
+        for (std::thread& thief : thieves)
+            thief.join();
+
+        if (!AE_CHECK(!deque.Steal() && !deque.Pop()) || !AE_CHECK(TakenOnce(taken, s_Items)))
+            return;
+    }
+}
+
+AE_TEST(MpscQueueLosesNothing)
+{
+    constexpr uint32_t s_Producers = 4U;
+    constexpr uint32_t s_Items = 20000U;
+
+    MpscQueue<uint32_t> queue;
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0U; producer < s_Producers; producer++)
+        producers.emplace_back([&queue, producer]
+        {
+            for (uint32_t i = 0U; i < s_Items; i++)
+                queue.Push(producer * s_Items + i);
+        });
+
+    // Items of one producer arrive in the order it pushed them
+    std::vector<std::vector<uint32_t>> received(1UL);
+    std::vector<uint32_t> next(s_Producers, 0U);
+    bool ordered = true;
+    while (received[0].size() < s_Producers * s_Items)
+    {
+        const std::optional<uint32_t> item = queue.Pop();
+        if (!item)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        received[0].push_back(*item);
+        const uint32_t producer = *item / s_Items;
+        ordered &= producer < s_Producers && *item % s_Items == next[producer]++;
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+    AE_CHECK(!queue.Pop());
+    AE_CHECK(ordered);
+    AE_CHECK(TakenOnce(received, s_Producers * s_Items));
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/lexer.hpp"
+#include "parser/parser.hpp"
+#include "runtime/resolver.hpp"
+#include "runtime/runtime.hpp"
+#include "util/interner.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    struct Ran
+    {
+        std::string output;
+        size_t errors;
+        // Names of the global bindings that exist once the program settled
+        std::vector<std::string> existing;
+    };
+
+    // Resolve errors of `program`, which has to parse
+    size_t ResolveErrors(const std::string& program)
+    {
+        const TokenStream tokens = Lexer(SourceBuffer::Borrow(program, "<test>")).Lex();
+        Parser parser(tokens);
+        const Ast ast = parser.Parse();
+        Resolver resolver;
+        resolver.Resolve(ast);
+        return parser.Errors().empty() ? resolver.Errors().size() : SIZE_MAX;
+    }
+
+    Ran Run(const std::string& program, size_t threads = 1UL)
+    {
+        const TokenStream tokens = Lexer(SourceBuffer::Borrow(program, "<test>")).Lex();
+        Parser parser(tokens);
+        const Ast ast = parser.Parse();
+        Resolver resolver;
+        const Resolution resolution = resolver.Resolve(ast);
+        if (!parser.Errors().empty() || !resolver.Errors().empty())
+            return Ran{ "", parser.Errors().size() + resolver.Errors().size(), {} };
+
+        std::ostringstream out;
+        Runtime runtime(ast, resolution, out, std::pmr::get_default_resource(), threads);
+        runtime.Run();
+
+        Ran ran{ out.str(), runtime.Errors().size(), {} };
+        for (const auto& [symbol, slot] : resolution.globals)
+            if (runtime.Exists(symbol))
+                ran.existing.emplace_back(Interner::Global().Name(symbol));
+        std::sort(ran.existing.begin(), ran.existing.end());
+        return ran;
+    }
+} // namespace
+
+AE_TEST(PrintSpreadsTuples)
+{
+    const Ran ran = Run("print(1, 1 + 1, \"x\")\nprint()\n(1, 2) ~> print 0\nwhen #start { print 1 (2, 3) }\n");
+    AE_CHECK(ran.errors == 0UL);
+    AE_CHECK(ran.output == "1 2 x\n\n0 1 2\n1 2 3\n");
+}
+
+AE_TEST(ReadsAfterDeletesAreErrors)
+{
+    AE_CHECK(ResolveErrors("when #start { a ::= 1; b ::= 2; ~!a; print b; print a }") == 1UL);
+    AE_CHECK(ResolveErrors("when #start { ~!a; ~!b; ~!a; print a b }") == 2UL);
+    // Deletions in an `if` only count inside of it, handlers run later
+    AE_CHECK(ResolveErrors("when #start { if x { ~!a; print a }; print a }") == 1UL);
+    AE_CHECK(ResolveErrors("when #start { ~!a; on b { print a }; if x { ~!b }; print b }") == 0UL);
+    AE_CHECK(ResolveErrors("when #start { ~!a; on b { ~!a; print a } }") == 1UL);
+    AE_CHECK(ResolveErrors("when #start { if x { ~!a }; ~!b; if y { print a b } }") == 1UL);
+}
+
+AE_TEST(DeletionsDropWritesOfTheSameTick)
+{
+    // The rule wrote x := 5 + 1 in the tick the handler deleted x, in every
+    // order. Only whether `on x` sees 5 before the deletion depends on it.
+    const std::string rule = "    x ::= 0\n    x := x + 1\n";
+    const std::string loop = "    when x >= 5 { ~!x }\n";
+    const std::string print = "    on x { print x }\n";
+
+    const Ran readme = Run("when #start {\n" + loop + print + rule + "}\n");
+    AE_CHECK(readme.errors == 0UL && readme.output == "0\n1\n2\n3\n4\n" && readme.existing.empty());
+
+    const Ran declared = Run("when #start {\n" + rule + print + loop + "}\n");
+    AE_CHECK(declared.errors == 0UL && declared.output == "0\n1\n2\n3\n4\n5\n" && declared.existing.empty());
+
+    const Ran printed = Run("when #start {\n" + print + rule + loop + "}\n");
+    AE_CHECK(printed.errors == 0UL && printed.output == "0\n1\n2\n3\n4\n5\n" && printed.existing.empty());
+}
+
+AE_TEST(WideHeightsRunTheSameOnAnyThreads)
+{
+    // Every tick recomputes more than s_ParallelHeight nodes at once, one of
+    // which deletes and so goes in a wave of its own
+    std::string program = "when #start {\n    n ::= 0\n    n := n + 1\n    when n >= 4 { ~!n }\n";
+    for (size_t i = 0UL; i < Runtime::s_ParallelHeight + 8UL; i++)
+    {
+        const std::string name = "d" + std::to_string(i);
+        program += "    " + name + " ::= n * " + std::to_string(i) + "\n";
+        program += "    on " + name + " { print \"" + name + "\" " + name + " }\n";
+        program += "    on n { print \"n" + std::to_string(i) + "\" n }\n";
+    }
+    program += "    on n { if n > 2 { ~!d3 } }\n}\n";
+
+    const Ran serial = Run(program);
+    if (!AE_CHECK(serial.errors == 0UL && serial.output.starts_with("n0 0\nn1 0\n")))
+        return;
+    for (const size_t threads : { 2UL, 4UL })
+    {
+        const Ran parallel = Run(program, threads);
+        AE_CHECK(parallel.errors == serial.errors);
+        AE_CHECK(parallel.output == serial.output);
+        AE_CHECK(parallel.existing == serial.existing);
+    }
+}
@@ -0,0 +1,131 @@
+#include <array>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "test.hpp"
+#include "corpus.hpp"
+#include "lexer/dfa_scanner.hpp"
+#include "lexer/scanner.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    template<typename T>
+    std::optional<Lexeme> Try(const std::string_view& text)
+    {
+        return T::Scan(text);
+    }
+
+    // What the lexer did before it dispatched on the leading byte: every
+    // scanner in priority order until one accepts
+    Lexeme ScanInOrder(const std::string_view& text)
+    {
+        if (auto lexeme = Try<EOFToken>(text)) { return lexeme.value(); }
+        if (auto lexeme = Try<StringToken>(text)) { return lexeme.value(); }
+        if (auto lexeme = Try<NumberToken>(text)) { return lexeme.value(); }
+        if (auto lexeme = Try<OperatorToken>(text)) { return lexeme.value(); }
+        if (auto lexeme = Try<KeywordToken>(text)) { return lexeme.value(); }
+        if (auto lexeme = Try<PunctuationToken>(text)) { return lexeme.value(); }
+        if (auto lexeme = Try<SymbolToken>(text)) { return lexeme.value(); }
+
+        return Lexeme{ TokenKind::INVALID, 0U, false, 0U };
+    }
+
+    bool Same(const Lexeme& lhs, const Lexeme& rhs)
+    {
+        return lhs.kind == rhs.kind && lhs.subtype == rhs.subtype && lhs.valid == rhs.valid
+            && lhs.length == rhs.length && lhs.payload == rhs.payload;
+    }
+
+    // Both at every offset, so the tokens after an invalid one count too
+    bool ScansAlike(std::string_view text)
+    {
+        for (size_t offset = 0UL; offset <= text.size(); offset++)
+            if (!AE_CHECK(Same(ScanLexeme(text.substr(offset)), ScanInOrder(text.substr(offset)))))
+                return false;
+        return true;
+    }
+
+    // Pieces of programs at the edges of the token rules, a smaller version
+    // of what bench/lexer_fuzz.cpp mutates corpora with
+    constexpr std::array<std::string_view, 52UL> s_Fragments = {
+        "0", "7", "42", "0x1F", "0o17", "0b101", "1.5", "1e5", "2.5e-3", "0x.", "0x", "0o8", "0b2", "00x", ".5", "1.",
+        "18446744073709551615", "18446744073709551616", "0x1p4",
+        "\"", "'", "\\", "\\n", "\\t", "\\\"", "\\'", "\\u{", "\\u{41}", "\\u{1F600}", "\\u{D800}", "\\u{110000}",
+        "\\u{}", "\\q", "\"a\\tb\"", "'\\u{e9}'",
+        "+", "-", "*", "/", "//", "///", "::=", ":=", "~>", "~!", "!!", "!", "<=", "==", "(", "{", "}",
+    };
+
+    // Fragments, names, blanks and arbitrary bytes, `size` pieces of them
+    std::string RandomProgram(std::mt19937_64& random, size_t size)
+    {
+        std::string program;
+        for (size_t i = 0UL; i < size; i++)
+        {
+            switch (random() % 8UL)
+            {
+            case 0:
+                program += static_cast<char>(random());
+                break;
+            case 1:
+                program += random() % 2UL ? " " : "\n";
+                break;
+            case 2:
+                program += random() % 2UL ? "name" : "\xC3\xA9";
+                break;
+            default:
+                program += s_Fragments[random() % s_Fragments.size()];
+                break;
+            }
+        }
+        return program;
+    }
+} // namespace
+
+AE_TEST(ScannerMatchesInOrderOnCorpora)
+{
+    for (const CorpusProfile profile : { CorpusProfile::MIXED, CorpusProfile::LITERALS, CorpusProfile::NESTED, CorpusProfile::SCRIPTS })
+        for (uint64_t seed = 0U; seed < 4U; seed++)
+            if (!ScansAlike(GenerateCorpus(16UL << 10U, profile, seed)))
+                return;
+}
+
+AE_TEST(ScannerMatchesInOrderOnEveryLeadByte)
+{
+    // Every byte in front of text that could finish any token
+    for (size_t byte = 0UL; byte < 256UL; byte++)
+        for (const std::string_view rest : { "", "x", "1", "=", ".5", "\"a\"", "\xA9", "\x9F\x98\x80" })
+            if (!ScansAlike(std::string(1UL, static_cast<char>(byte)) + std::string(rest)))
+                return;
+}
+
+AE_TEST(ScannerMatchesInOrderOnRandomBytes)
+{
+    std::mt19937_64 random(7U);
+    std::string text(1UL << 16U, '\0');
+    for (char& sym : text)
+        sym = static_cast<char>(random());
+    ScansAlike(text);
+}
+
+AE_TEST(DfaMatchesScannerOnRandomPrograms)
+{
+    std::mt19937_64 random(11U);
+    for (size_t input = 0UL; input < 2000UL; input++)
+    {
+        const std::string program = RandomProgram(random, 1UL + random() % 48UL);
+        for (size_t offset = 0UL; offset <= program.size(); offset++)
+        {
+            const std::string_view rest = std::string_view(program).substr(offset);
+            if (Same(ScanLexeme(rest), ScanLexemeDfa(rest)))
+                continue;
+            std::fprintf(stderr, "input %zu differs at offset %zu\n", input, offset);
+            AE_CHECK(false);
+            return;
+        }
+    }
+}
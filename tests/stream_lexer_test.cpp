@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cerrno>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "test.hpp"
+#include "corpus.hpp"
+#include "io/source_buffer.hpp"
+#include "lexer/lexer.hpp"
+#include "lexer/stream_lexer.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    // The stream lexer has to hand out exactly the tokens of the in-place one
+    bool LexesAlike(StreamLexer& lexer, std::string_view program)
+    {
+        const SourceBuffer source = SourceBuffer::Borrow(program, "<test>");
+        const TokenStream tokens = Lexer(source).Lex();
+
+        size_t index = 0UL;
+        for (const StreamToken& token : lexer)
+        {
+            if (!AE_CHECK(index < tokens.Size()))
+                return false;
+            const Position pos = tokens.Pos(index);
+            const bool same = token.kind == tokens.Kind(index) && token.subtype == tokens.Subtype(index)
+                && token.valid == tokens.Valid(index) && token.offset == tokens.Offset(index)
+                && token.payload == tokens.Payload(index) && token.text == tokens.Text(index)
+                && token.pos.line == pos.line && token.pos.col == pos.col;
+            if (!AE_CHECK(same))
+                return false;
+            index++;
+        }
+        return AE_CHECK(index == tokens.Size()) && AE_CHECK(!lexer.Error());
+    }
+
+    // Breaks the input off with an exception after `size` bytes, which the
+    // stream turns into badbit
+    class FailingBuffer : public std::streambuf
+    {
+    private:
+        std::string m_Text;
+        bool m_Served = false;
+    public:
+        FailingBuffer(std::string text) : m_Text(std::move(text)) {}
+    protected:
+        int_type underflow() override
+        {
+            if (m_Served)
+                throw std::ios_base::failure("device went away");
+            m_Served = true;
+            setg(m_Text.data(), m_Text.data(), m_Text.data() + m_Text.size());
+            return traits_type::to_int_type(m_Text.front());
+        }
+    };
+
+    // Serves reads of any size straight from a string and counts them
+    class CountingBuffer : public std::streambuf
+    {
+    private:
+        std::string m_Text;
+        size_t m_Position = 0UL;
+    public:
+        size_t reads = 0UL;
+
+        CountingBuffer(std::string text) : m_Text(std::move(text)) {}
+    protected:
+        std::streamsize xsgetn(char* destination, std::streamsize size) override
+        {
+            reads++;
+            const size_t count = std::min(static_cast<size_t>(size), m_Text.size() - m_Position);
+            std::copy_n(m_Text.data() + m_Position, count, destination);
+            m_Position += count;
+            return static_cast<std::streamsize>(count);
+        }
+    };
+} // namespace
+
+AE_TEST(StreamLexerPipeInSmallChunks)
+{
+    std::mt19937_64 random(5U);
+    for (const CorpusProfile profile : { CorpusProfile::MIXED, CorpusProfile::LITERALS, CorpusProfile::SCRIPTS })
+    {
+        const std::string program = GenerateCorpus(32UL << 10U, profile, random());
+
+        int ends[2];
+        if (!AE_CHECK(pipe(ends) == 0))
+            return;
+
+        // Writes of 1 to 7 bytes, so reads return fragments of tokens
+        std::thread writer([&program, &ends, seed = random()]()
+        {
+            std::mt19937_64 random(seed);
+            for (size_t offset = 0UL; offset < program.size();)
+            {
+                const size_t size = std::min<size_t>(1UL + random() % 7UL, program.size() - offset);
+                const ssize_t written = write(ends[1], program.data() + offset, size);
+                if (written <= 0)
+                    break;
+                offset += static_cast<size_t>(written);
+            }
+            close(ends[1]);
+        });
+
+        StreamLexer lexer(ends[0], 1UL);
+        LexesAlike(lexer, program);
+        writer.join();
+        close(ends[0]);
+    }
+}
+
+AE_TEST(StreamLexerIstreamInSmallChunks)
+{
+    const std::string program = GenerateCorpus(32UL << 10U, CorpusProfile::NESTED, 3U);
+    for (const size_t chunk : { 1UL, 5UL, 64UL, StreamLexer::s_DefaultChunkSize })
+    {
+        std::istringstream input(program);
+        StreamLexer lexer(input, chunk);
+        LexesAlike(lexer, program);
+    }
+}
+
+AE_TEST(StreamLexerReportsReadErrors)
+{
+    // A directory opens, reading it does not
+    const int descriptor = open("/", O_RDONLY);
+    if (!AE_CHECK(descriptor >= 0))
+        return;
+
+    StreamLexer lexer(descriptor);
+    const std::optional<StreamToken> token = lexer.Next();
+    AE_CHECK(token && !token->valid && token->kind == TokenKind::INVALID);
+    AE_CHECK(lexer.Error() == EISDIR);
+    AE_CHECK(!lexer.Next());
+    close(descriptor);
+}
+
+AE_TEST(StreamLexerReportsStreamErrors)
+{
+    FailingBuffer buffer("x ::= 1\n");
+    std::istream input(&buffer);
+    StreamLexer lexer(input, 64UL);
+
+    std::optional<StreamToken> last;
+    while (const std::optional<StreamToken> token = lexer.Next())
+        last = token;
+    AE_CHECK(last && !last->valid && last->kind == TokenKind::INVALID);
+    AE_CHECK(lexer.Error() == EIO);
+}
+
+AE_TEST(StreamLexerGrowsTheWindowForLongTokens)
+{
+    // Each token is hundreds of chunks long
+    const std::string name(40000UL, 'n');
+    const std::string program = "x ::= \"" + std::string(50000UL, 's') + "\" + " + name
+        + "\n" + std::string(30000UL, '7') + " '" + std::string(20000UL, '\\') + "'";
+
+    for (const size_t chunk : { 1UL, 64UL, 4096UL })
+    {
+        CountingBuffer buffer(program);
+        std::istream input(&buffer);
+        StreamLexer lexer(input, chunk);
+        if (!LexesAlike(lexer, program))
+            return;
+
+        // Growing by a chunk at a time would take a read per chunk
+        AE_CHECK(buffer.reads < 200UL);
+    }
+}
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+#include "test.hpp"
+#include "lexer/dfa_scanner.hpp"
+#include "lexer/scanner.hpp"
+#include "lexer/token_stream.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    constexpr uint8_t s_Plain = static_cast<uint8_t>(StringLiteralType::PLAIN);
+    constexpr uint8_t s_Escaped = static_cast<uint8_t>(StringLiteralType::ESCAPED);
+
+    // Both scanners lex the literal at the front of `text` as expected
+    bool CheckString(std::string_view text, bool valid, uint8_t subtype, uint32_t length)
+    {
+        for (const Lexeme lexeme : { ScanLexeme(text), ScanLexemeDfa(text) })
+        {
+            const bool same = lexeme.kind == TokenKind::STRING && lexeme.valid == valid
+                && lexeme.subtype == subtype && lexeme.length == length;
+            if (!same)
+                std::fprintf(stderr, "`%.*s`: kind %u, subtype %u, valid %d, length %u\n",
+                    static_cast<int>(text.size()), text.data(), static_cast<unsigned>(lexeme.kind),
+                    lexeme.subtype, lexeme.valid, lexeme.length);
+            if (!AE_CHECK(same))
+                return false;
+        }
+        return true;
+    }
+
+    // Tokens of the string literals that start at `offsets` of `source`
+    TokenStream Strings(std::string_view source, std::initializer_list<uint32_t> offsets)
+    {
+        TokenStream stream(source);
+        for (const uint32_t offset : offsets)
+            stream.Push(ScanLexeme(source.substr(offset)), offset);
+        return stream;
+    }
+
+    std::string Value(std::string_view literal)
+    {
+        const TokenStream stream = Strings(literal, { 0U });
+        return std::string(stream.StringValue(0UL));
+    }
+} // namespace
+
+AE_TEST(EscapesDecode)
+{
+    const struct
+    {
+        std::string_view literal;
+        std::string_view value;
+    } cases[] = {
+        { R"("\n")", "\n" },
+        { R"("\t")", "\t" },
+        { R"("\r")", "\r" },
+        { R"("\0")", std::string_view("\0", 1UL) },
+        { R"("\\")", "\\" },
+        { R"("\'")", "'" },
+        { R"("\"")", "\"" },
+        { R"('\"\'')", "\"'" },
+        { R"("\u{41}")", "A" },
+        { R"("\u{1F600}")", "\xF0\x9F\x98\x80" },
+        { R"("\u{000041}")", "A" },
+        { R"("\u{e9}")", "\xC3\xA9" },
+        { R"("a\tb\u{41}c\\")", "a\tbAc\\" },
+    };
+
+    for (const auto& c : cases)
+    {
+        if (!CheckString(c.literal, true, s_Escaped, static_cast<uint32_t>(c.literal.size())))
+            return;
+        if (!AE_CHECK(Value(c.literal) == c.value))
+            return;
+    }
+}
+
+AE_TEST(BadEscapesAreInvalid)
+{
+    // A bad escape ends the literal right behind its backslash
+    for (const std::string_view literal : {
+        R"("\q")", R"("\u{}")", R"("\u{D800}")", R"("\u{DFFF}")", R"("\u{110000}")",
+        R"("\u{1234567}")", R"("\u41")", R"("\u{41")", R"("\u{41)", R"("\)" })
+    {
+        if (!AE_CHECK(StringToken::EscapeLength(literal.substr(1UL)) == 0UL))
+            return;
+        if (!CheckString(literal, false, s_Escaped, 2U))
+            return;
+    }
+
+    // Good escapes are not cut short by what follows them
+    AE_CHECK(StringToken::EscapeLength(R"(\u{10FFFF}x)") == 10UL);
+    AE_CHECK(StringToken::EscapeLength(R"(\u{D7FF})") == 8UL);
+    AE_CHECK(StringToken::EscapeLength(R"(\nx)") == 2UL);
+}
+
+AE_TEST(OnlyEscapedStringsAreEscaped)
+{
+    CheckString(R"("plain")", true, s_Plain, 7U);
+    CheckString(R"('plain')", true, s_Plain, 7U);
+    CheckString(R"("")", true, s_Plain, 2U);
+    CheckString(R"("unterminated)", false, s_Plain, 13U);
+    CheckString(R"("a\nb")", true, s_Escaped, 6U);
+    CheckString(R"("unterminated\n)", false, s_Escaped, 15U);
+
+    // Plain literals are views of the source, not decoded copies
+    const std::string_view literal = R"("plain")";
+    const TokenStream stream = Strings(literal, { 0U });
+    AE_CHECK(stream.StringValue(0UL).data() == literal.data() + 1);
+    AE_CHECK(stream.StringValue(0UL) == "plain");
+}
+
+AE_TEST(DecodedStringsAreCachedUntilTheTokensChange)
+{
+    const std::string_view source = R"("\n" "\t")";
+    TokenStream stream = Strings(source, { 0U, 5U });
+
+    // Decoding more strings does not move the ones decoded before
+    const std::string_view first = stream.StringValue(0UL);
+    AE_CHECK(first == "\n");
+    AE_CHECK(stream.StringValue(1UL) == "\t");
+    AE_CHECK(stream.StringValue(0UL).data() == first.data());
+
+    // Another token at index 1 after a resize
+    stream.Resize(1UL);
+    stream.Push(ScanLexeme(source), 0U);
+    AE_CHECK(stream.StringValue(0UL) == "\n");
+    AE_CHECK(stream.StringValue(1UL) == "\n");
+
+    // The tokens in the other order
+    const TokenStream swapped = Strings(source, { 5U, 0U });
+    stream.Assign(swapped.Arrays());
+    AE_CHECK(stream.StringValue(0UL) == "\t");
+    AE_CHECK(stream.StringValue(1UL) == "\n");
+
+    // Same offsets in another text
+    const std::string_view other = R"("\r" "\\")";
+    stream.Rebind(other);
+    AE_CHECK(stream.StringValue(0UL) == "\\");
+    AE_CHECK(stream.StringValue(1UL) == "\r");
+}
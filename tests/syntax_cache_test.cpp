@@ -0,0 +1,189 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+#include "test.hpp"
+#include "io/source_buffer.hpp"
+#include "io/syntax_cache.hpp"
+#include "lexer/lexer.hpp"
+#include "parser/parser.hpp"
+#include "util/interner.hpp"
+
+using namespace Aesthetic;
+
+namespace
+{
+    constexpr uint64_t s_Build = 0xAE5CAC4EULL;
+
+    const std::string s_Program =
+        "cached_a ::= 1 + 2 * 0x10\n"
+        "cached_b := \"plain\" \n"
+        "cached_c ::= 'esc\\taped \\u{1F600}'\n"
+        "when cached_a > 2 {\n"
+        "    print(cached_a, cached_b, (1, 2.5))\n"
+        "}\n"
+        "cached_a ~> cached_d\n";
+
+    std::string CachePath(std::string_view name)
+    {
+        return (std::filesystem::temp_directory_path()
+            / ("aesthetic-test-" + std::to_string(::getpid()) + "-" + std::string(name))).string();
+    }
+
+    std::string ReadFile(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+
+    void WriteFile(const std::string& path, std::string_view contents)
+    {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+    // Caches s_Program at `path`, false if that failed
+    bool WriteCache(const std::string& path)
+    {
+        const TokenStream tokens = Lexer(SourceBuffer::Borrow(s_Program, "<test>")).Lex();
+        Parser parser(tokens);
+        const Ast ast = parser.Parse();
+        return parser.Errors().empty() && SyntaxCache::Write(path, s_Build, s_Program, tokens, ast);
+    }
+
+    // Lets `change` edit the file at `path` and fixes up its checksum, so
+    // only what `change` did can make it a miss
+    void Rewrite(const std::string& path, const std::function<void(std::string&, CacheHeader&)>& change)
+    {
+        std::string file = ReadFile(path);
+        CacheHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        change(file, header);
+        header.checksum = Interner::Hash(std::string_view(file).substr(sizeof(header)));
+        std::memcpy(file.data(), &header, sizeof(header));
+        WriteFile(path, file);
+    }
+
+    // Overwrites element `index` of the array of T in `section` of `file`
+    template<typename T = uint32_t>
+    void Poke(std::string& file, const CacheHeader& header, CacheSection section, size_t index, T value)
+    {
+        const size_t at = header.sections[static_cast<size_t>(section)].offset + index * sizeof(value);
+        std::memcpy(file.data() + at, &value, sizeof(value));
+    }
+
+    bool Misses(const std::string& path, uint64_t build = s_Build, std::string_view source = s_Program)
+    {
+        return !SyntaxCache::Open(path, build, source).has_value();
+    }
+} // namespace
+
+AE_TEST(SyntaxCacheRoundTrips)
+{
+    const std::string path = CachePath("round-trip");
+    const TokenStream tokens = Lexer(SourceBuffer::Borrow(s_Program, "<test>")).Lex();
+    Parser parser(tokens);
+    const Ast ast = parser.Parse();
+    if (!AE_CHECK(parser.Errors().empty()) || !AE_CHECK(SyntaxCache::Write(path, s_Build, s_Program, tokens, ast)))
+        return;
+
+    const std::optional<SyntaxCache> cache = SyntaxCache::Open(path, s_Build, s_Program);
+    std::filesystem::remove(path);
+    if (!AE_CHECK(cache.has_value()))
+        return;
+    AE_CHECK(cache->Tokens() == tokens.Size());
+    AE_CHECK(cache->Nodes() == ast.Size());
+
+    TokenStream loadedTokens(s_Program);
+    Ast loaded(loadedTokens);
+    cache->Load(loadedTokens, loaded);
+
+    if (!AE_CHECK(loadedTokens.Size() == tokens.Size()))
+        return;
+    for (size_t i = 0UL; i < tokens.Size(); i++)
+    {
+        const bool same = loadedTokens.Kind(i) == tokens.Kind(i) && loadedTokens.Subtype(i) == tokens.Subtype(i)
+            && loadedTokens.Valid(i) == tokens.Valid(i) && loadedTokens.Offset(i) == tokens.Offset(i)
+            && loadedTokens.Length(i) == tokens.Length(i) && loadedTokens.Payload(i) == tokens.Payload(i);
+        if (!AE_CHECK(same))
+            return;
+        // Stored as indices into the cache's own table, loaded as IDs again
+        if (tokens.Kind(i) == TokenKind::SYMBOL
+            && !AE_CHECK(Interner::Global().Name(static_cast<SymbolId>(loadedTokens.Payload(i))) == loadedTokens.Text(i)))
+            return;
+        if (tokens.Kind(i) == TokenKind::STRING && !AE_CHECK(loadedTokens.StringValue(i) == tokens.StringValue(i)))
+            return;
+    }
+
+    std::ostringstream expected;
+    std::ostringstream actual;
+    ast.Dump(expected);
+    loaded.Dump(actual);
+    AE_CHECK(loaded.Root() == ast.Root());
+    AE_CHECK(actual.str() == expected.str());
+}
+
+AE_TEST(SyntaxCacheMissesOnStaleOrDamagedFiles)
+{
+    const std::string path = CachePath("damaged");
+    if (!AE_CHECK(WriteCache(path)) || !AE_CHECK(!Misses(path)))
+        return;
+    const std::string intact = ReadFile(path);
+
+    // Whatever Rewrite() does on its own is no reason to miss
+    Rewrite(path, [](std::string&, const CacheHeader&) {});
+    AE_CHECK(!Misses(path));
+
+    AE_CHECK(Misses(path, s_Build + 1ULL));
+    std::string changed = s_Program;
+    changed[0] = 'C';
+    AE_CHECK(Misses(path, s_Build, changed));
+    AE_CHECK(Misses(path, s_Build, s_Program + " "));
+    AE_CHECK(Misses(path, s_Build, std::string_view(s_Program).substr(1UL)));
+
+    for (const size_t at : { sizeof(CacheHeader), (sizeof(CacheHeader) + intact.size()) / 2UL, intact.size() - 1UL })
+    {
+        std::string flipped = intact;
+        flipped[at] ^= 0x10;
+        WriteFile(path, flipped);
+        AE_CHECK(Misses(path));
+    }
+
+    for (const size_t size : { intact.size() - 1UL, intact.size() / 2UL, sizeof(CacheHeader), sizeof(CacheHeader) - 1UL, 0UL })
+    {
+        WriteFile(path, std::string_view(intact).substr(0UL, size));
+        AE_CHECK(Misses(path));
+    }
+
+    // Checksummed but pointing outside their arrays
+    const std::function<void(std::string&, CacheHeader&)> changes[] = {
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::NODE_TOKENS, 0UL, header.tokens); },
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::NODE_LHS, 1UL, 1U); },
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::NODE_RHS, header.nodes - 2UL, header.nodes); },
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::NODE_LHS, header.root, header.children + 1U); },
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::NODE_RHS, header.root, header.children + 1U); },
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::NODE_CHILDREN, 0UL, header.nodes); },
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::NODE_CHILDREN, header.children - 1UL, header.root); },
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::TOKEN_OFFSETS, 0UL, static_cast<uint32_t>(header.sourceSize)); },
+        [](std::string& file, const CacheHeader& header) { Poke<uint64_t>(file, header, CacheSection::TOKEN_PAYLOADS, 0UL, header.symbols); },
+        [](std::string& file, const CacheHeader& header) { Poke(file, header, CacheSection::SYMBOL_STARTS, header.symbols, 0U); },
+        [](std::string&, CacheHeader& header) { header.root = header.nodes; },
+    };
+    for (const auto& change : changes)
+    {
+        WriteFile(path, intact);
+        Rewrite(path, change);
+        if (!AE_CHECK(Misses(path)))
+            break;
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace Aesthetic::Tests
+{
+    struct TestCase
+    {
+        std::string_view name;
+        void (*run)();
+    };
+
+    // Every AE_TEST of the binary, in no particular order
+    std::vector<TestCase>& Registry();
+
+    struct Register
+    {
+        Register(std::string_view name, void (*run)()) { Registry().push_back(TestCase{ name, run }); }
+    };
+
+    // Reports a failed check of the running test, returns `passed`
+    bool Check(bool passed, const char* file, int line, const char* expression);
+} // namespace Aesthetic::Tests
+
+#define AE_TEST(name) \
+    static void name(); \
+    static const ::Aesthetic::Tests::Register s_Register_##name(#name, name); \
+    static void name()
+
+// Failing checks don't stop the test, loops can stop on the first one
+#define AE_CHECK(expression) ::Aesthetic::Tests::Check(static_cast<bool>(expression), __FILE__, __LINE__, #expression)
@@ -0,0 +1,56 @@
+#include <cstdio>
+#include <string_view>
+
+#include "test.hpp"
+
+namespace Aesthetic::Tests
+{
+    namespace
+    {
+        size_t s_Failures = 0UL;
+    } // namespace
+
+    std::vector<TestCase>& Registry()
+    {
+        static std::vector<TestCase> s_Registry;
+        return s_Registry;
+    }
+
+    bool Check(bool passed, const char* file, int line, const char* expression)
+    {
+        if (!passed)
+        {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+            s_Failures++;
+        }
+        return passed;
+    }
+} // namespace Aesthetic::Tests
+
+using namespace Aesthetic::Tests;
+
+// Runs every test, or the ones whose names contain the first argument
+int main(int argc, char** argv)
+{
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+    size_t failed = 0UL;
+    size_t run = 0UL;
+
+    for (const TestCase& test : Registry())
+    {
+        if (test.name.find(filter) == std::string_view::npos)
+            continue;
+
+        const size_t failures = s_Failures;
+        test.run();
+        run++;
+
+        const bool passed = s_Failures == failures;
+        failed += !passed;
+        std::printf("%s %.*s\n", passed ? "ok  " : "FAIL", static_cast<int>(test.name.size()), test.name.data());
+        std::fflush(stdout);
+    }
+
+    std::printf("%zu of %zu tests passed\n", run - failed, run);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""Writes src/lexer/xid_tables.hpp, the XID_Start and XID_Continue ranges
+above ASCII, from the Unicode database of the running Python. Python
+identifiers are defined by the same two properties, so str.isidentifier()
+answers for them.
+
+    python3 tools/generate_xid_tables.py > src/lexer/xid_tables.hpp
+"""
+
+import unicodedata
+
+# An entry is first << 11 | (count - 1), longer ranges take several entries
+COUNT_BITS = 11
+
+
+def ranges(accepts):
+    result = []
+    first = None
+    for code in range(0x80, 0x110000):
+        if accepts(code) and first is None:
+            first = code
+        elif not accepts(code) and first is not None:
+            result.append((first, code - 1))
+            first = None
+    if first is not None:
+        result.append((first, 0x10FFFF))
+    return result
+
+
+def entries(pairs):
+    limit = 1 << COUNT_BITS
+    for first, last in pairs:
+        while first <= last:
+            count = min(last - first + 1, limit)
+            yield first << COUNT_BITS | (count - 1)
+            first += count
+
+
+def table(name, pairs):
+    values = list(entries(pairs))
+    lines = [f"    inline constexpr std::array<uint32_t, {len(values)}UL> {name} = {{"]
+    for i in range(0, len(values), 8):
+        lines.append("        " + " ".join(f"0x{value:08X}U," for value in values[i:i + 8]))
+    lines.append("    };")
+    return "\n".join(lines)
+
+
+def is_start(code):
+    return chr(code).isidentifier()
+
+
+def is_continue(code):
+    return ("a" + chr(code)).isidentifier()
+
+
+print(f"""#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Generated by tools/generate_xid_tables.py from Unicode {unicodedata.unidata_version}, do not edit
+
+namespace Aesthetic
+{{
+    // Sorted code point ranges from 0x80 on, each entry is the first code
+    // point shifted left by {COUNT_BITS} bits with the count less one below it
+    inline constexpr unsigned s_XidCountBits = {COUNT_BITS}U;
+
+{table("s_XidStartRanges", ranges(is_start))}
+
+{table("s_XidContinueRanges", ranges(is_continue))}
+}} // namespace Aesthetic""")